@@ -40,9 +40,25 @@
   * See http://www.freertos.org/a00110.html
   *----------------------------------------------------------*/
  
+ /* Low power build (cmake -DBAIXO_CONSUMO=ON): one core, tickless idle */
+ #ifndef BAIXO_CONSUMO
+ #define BAIXO_CONSUMO                           0
+ #endif
+
  /* Scheduler Related */
  #define configUSE_PREEMPTION                    1
- #define configUSE_TICKLESS_IDLE                 0
+ #define configUSE_TICKLESS_IDLE                 BAIXO_CONSUMO
+ #if configUSE_TICKLESS_IDLE
+ /* The idle task sleeps in WFI while no task is due for at least 2 ticks;
+    the hooks feed the wakeup report (lib/relatorio_consumo) */
+ #define configEXPECTED_IDLE_TIME_BEFORE_SLEEP   2
+ #ifndef __ASSEMBLER__
+ void relatorio_consumo_antes_de_dormir(void);
+ void relatorio_consumo_depois_de_dormir(void);
+ #endif
+ #define configPRE_SLEEP_PROCESSING(x)           relatorio_consumo_antes_de_dormir()
+ #define configPOST_SLEEP_PROCESSING(x)          relatorio_consumo_depois_de_dormir()
+ #endif
  #define configUSE_IDLE_HOOK                     0
  #define configUSE_TICK_HOOK                     0
  #define configTICK_RATE_HZ                      ( ( TickType_t ) 1000 )
@@ -105,8 +121,13 @@
  #if FREE_RTOS_KERNEL_SMP // set by the RP2xxx SMP port of FreeRTOS
  /* SMP port only */
  #ifndef configNUMBER_OF_CORES
+ #if BAIXO_CONSUMO
+ /* Tickless idle is only supported with a single core; core 1 stays parked */
+ #define configNUMBER_OF_CORES                   1
+ #else
  #define configNUMBER_OF_CORES                   2
  #endif
+ #endif
  #define configNUM_CORES                         configNUMBER_OF_CORES
  #define configTICK_CORE                         0
  #define configRUN_MULTIPLE_PRIORITIES           1
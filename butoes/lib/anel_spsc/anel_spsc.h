@@ -0,0 +1,115 @@
+/**
+ * @file anel_spsc.h
+ * @brief Interface do anel sem trava de um produtor e um consumidor (SPSC)
+ *
+ * Passa elementos de tamanho fixo de uma task para outra, mesmo em núcleos
+ * diferentes, sem seção crítica nem chamada ao kernel: o produtor só
+ * escreve o índice de escrita e o consumidor só escreve o de leitura. Cada
+ * índice fica em sua própria linha de cache, para que um lado não invalide
+ * a linha do outro a cada elemento.
+ *
+ * O consumidor é avisado só quando o anel passa de vazio a não vazio; com
+ * elementos já pendentes, o produtor não faz chamada nenhuma. O módulo não
+ * depende do SDK, por isso também compila no host (ver
+ * ferramentas/estresse_anel_spsc.c).
+ */
+
+#ifndef ANEL_SPSC_H
+#define ANEL_SPSC_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @defgroup ANEL_SPSC Anel SPSC
+ * @{
+ */
+
+/**
+ * @def ANEL_SPSC_LINHA_CACHE
+ * @brief Alinhamento, em bytes, de cada índice do anel
+ *
+ * O RP2040 não tem cache de dados e o alinhamento só custa alguns bytes;
+ * no host ele separa os índices dos dois núcleos.
+ */
+#ifndef ANEL_SPSC_LINHA_CACHE
+#define ANEL_SPSC_LINHA_CACHE 64
+#endif
+
+/**
+ * @brief Função chamada pelo produtor quando o anel deixa de estar vazio
+ *
+ * Roda no contexto do produtor (task ou interrupção). Serve para acordar
+ * o consumidor (ex.: xTaskNotifyGive()).
+ */
+typedef void (*AvisoAnelSpsc_t)(void);
+
+/**
+ * @brief Estado de um anel
+ *
+ * Os índices correm livres e só são reduzidos à capacidade no acesso ao
+ * armazenamento; a diferença entre eles é o número de elementos guardados.
+ */
+typedef struct {
+    uint8_t *elementos;           /**< Armazenamento, capacidade * tamanho_elemento bytes */
+    uint32_t tamanho_elemento;    /**< Tamanho de cada elemento, em bytes */
+    uint32_t mascara;             /**< Capacidade - 1 (a capacidade é potência de 2) */
+    AvisoAnelSpsc_t aviso;        /**< Chamado na passagem de vazio a não vazio (pode ser NULL) */
+    _Alignas(ANEL_SPSC_LINHA_CACHE) atomic_uint_least32_t escrita; /**< Próxima posição a escrever (só o produtor escreve) */
+    uint32_t descartados;         /**< Elementos recusados com o anel cheio (só o produtor escreve) */
+    _Alignas(ANEL_SPSC_LINHA_CACHE) atomic_uint_least32_t leitura; /**< Próxima posição a ler (só o consumidor escreve) */
+} AnelSpsc_t;
+
+/**
+ * @brief Inicializa o anel vazio sobre um armazenamento do chamador
+ * @param anel Ponteiro para o anel
+ * @param elementos Armazenamento para capacidade elementos
+ * @param tamanho_elemento Tamanho de cada elemento, em bytes
+ * @param capacidade Número de elementos (potência de 2)
+ * @param aviso Chamado quando o anel deixa de estar vazio (pode ser NULL)
+ * @return false se a capacidade não é potência de 2
+ */
+bool anel_spsc_init(AnelSpsc_t *anel, void *elementos, uint32_t tamanho_elemento, uint32_t capacidade,
+                    AvisoAnelSpsc_t aviso);
+
+/**
+ * @brief Copia um elemento para o anel (só o produtor)
+ *
+ * Nunca bloqueia: com o anel cheio o elemento é recusado e contado em
+ * descartados. Se o anel estava vazio, chama o aviso depois de publicar.
+ *
+ * @param anel Ponteiro para o anel
+ * @param elemento Elemento a copiar
+ * @return true se o elemento entrou no anel
+ */
+bool anel_spsc_inserir(AnelSpsc_t *anel, const void *elemento);
+
+/**
+ * @brief Copia e retira o elemento mais antigo do anel (só o consumidor)
+ *
+ * Depois de receber false, o consumidor pode dormir até o aviso: um
+ * elemento publicado depois do teste sempre gera um aviso. Um aviso pode
+ * chegar com o elemento já consumido; o consumidor acorda, acha o anel
+ * vazio e volta a dormir.
+ *
+ * @param anel Ponteiro para o anel
+ * @param elemento Recebe o elemento
+ * @return true se havia elemento
+ */
+bool anel_spsc_remover(AnelSpsc_t *anel, void *elemento);
+
+/**
+ * @brief Número de elementos guardados
+ *
+ * Exato para o consumidor, que só vê o valor crescer; para os demais é
+ * uma estimativa.
+ *
+ * @param anel Ponteiro para o anel
+ * @return Elementos guardados
+ */
+uint32_t anel_spsc_tamanho(AnelSpsc_t *anel);
+
+/** @} */ // Fim do grupo ANEL_SPSC
+
+#endif // ANEL_SPSC_H
@@ -0,0 +1,96 @@
+/**
+ * @file buffer_amostras.c
+ * @brief Implementação do buffer circular de amostras com timestamp
+ *
+ * O buffer é usado por uma única task (ou pelo laço principal), por isso
+ * não tem proteção contra acesso concorrente.
+ */
+
+#include "buffer_amostras.h"
+
+/**
+ * @brief Esvazia o buffer e zera os contadores.
+ */
+void buffer_amostras_init(BufferAmostras_t *buffer) {
+    buffer->inicio = 0;
+    buffer->quantidade = 0;
+    buffer->descartadas = 0;
+    buffer->coalescidas = 0;
+    buffer->ultima_ao_vivo = false;
+}
+
+/**
+ * @brief Insere uma amostra no fim do buffer.
+ *
+ * Com o buffer cheio, a amostra mais antiga é sobrescrita e contada em
+ * BufferAmostras_t::descartadas, preservando sempre os dados mais recentes.
+ */
+void buffer_amostras_inserir(BufferAmostras_t *buffer, const Amostra_t *amostra) {
+    if (buffer->quantidade == BUFFER_AMOSTRAS_CAPACIDADE) {
+        // Buffer cheio: a amostra mais antiga dá lugar à nova
+        buffer->inicio = (buffer->inicio + 1) % BUFFER_AMOSTRAS_CAPACIDADE;
+        buffer->quantidade--;
+        buffer->descartadas++;
+    }
+
+    uint16_t fim = (buffer->inicio + buffer->quantidade) % BUFFER_AMOSTRAS_CAPACIDADE;
+    buffer->amostras[fim] = *amostra;
+    buffer->quantidade++;
+    buffer->ultima_ao_vivo = true;
+}
+
+/**
+ * @brief Insere uma amostra reposta do log no fim do buffer.
+ */
+void buffer_amostras_inserir_reposta(BufferAmostras_t *buffer, const Amostra_t *amostra) {
+    buffer_amostras_inserir(buffer, amostra);
+    buffer->ultima_ao_vivo = false;
+}
+
+/**
+ * @brief Insere uma amostra, coalescendo-a com a mais recente se o buffer já tem amostras suficientes.
+ */
+bool buffer_amostras_coalescer(BufferAmostras_t *buffer, const Amostra_t *amostra, uint16_t limite) {
+    // Só uma amostra ao vivo pode ser substituída; as repostas do log já esperaram demais
+    if (buffer->quantidade < limite || !buffer->ultima_ao_vivo) {
+        buffer_amostras_inserir(buffer, amostra);
+        return false;
+    }
+    uint16_t ultima = (buffer->inicio + buffer->quantidade - 1) % BUFFER_AMOSTRAS_CAPACIDADE;
+    buffer->amostras[ultima] = *amostra;
+    buffer->coalescidas++;
+    return true;
+}
+
+/**
+ * @brief Consulta a amostra mais antiga sem removê-la.
+ */
+bool buffer_amostras_espiar(const BufferAmostras_t *buffer, Amostra_t *amostra) {
+    if (buffer->quantidade == 0) {
+        return false;
+    }
+    *amostra = buffer->amostras[buffer->inicio];
+    return true;
+}
+
+/**
+ * @brief Remove a amostra mais antiga do buffer.
+ */
+bool buffer_amostras_remover(BufferAmostras_t *buffer, Amostra_t *amostra) {
+    if (buffer->quantidade == 0) {
+        return false;
+    }
+    if (amostra) {
+        *amostra = buffer->amostras[buffer->inicio];
+    }
+    buffer->inicio = (buffer->inicio + 1) % BUFFER_AMOSTRAS_CAPACIDADE;
+    buffer->quantidade--;
+    return true;
+}
+
+/**
+ * @brief Retorna o número de amostras armazenadas.
+ */
+uint16_t buffer_amostras_tamanho(const BufferAmostras_t *buffer) {
+    return buffer->quantidade;
+}
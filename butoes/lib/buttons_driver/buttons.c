@@ -8,6 +8,54 @@
 
 #include "buttons.h"
 #include "hardware/gpio.h"
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/clocks.h"
+#include "amostrador_entradas.pio.h"
+
+/** @brief Ciclos da máquina de estados por amostra (ver amostrador_entradas.pio) */
+#define CICLOS_POR_AMOSTRA 7
+
+/** @brief Palavras de uma mudança na FIFO: estado dos pinos e contador de amostras */
+#define PALAVRAS_POR_MUDANCA 2
+
+/** @brief Palavras do anel do DMA */
+#define PALAVRAS_ANEL (BUTTONS_CAPACIDADE_EVENTOS * PALAVRAS_POR_MUDANCA)
+
+/** @brief Bits do bloco de pinos nas palavras de estado */
+#define MASCARA_PINOS ((1u << BUTTONS_NUM_PINOS) - 1u)
+
+/** @brief Anel escrito pelo DMA; o endereço precisa ser alinhado ao tamanho */
+static uint32_t anel[PALAVRAS_ANEL] __attribute__((aligned(PALAVRAS_ANEL * sizeof(uint32_t))));
+
+/** @brief Palavras já lidas do anel (contagem absoluta, como a do DMA) */
+static uint32_t palavras_lidas = 0;
+
+/** @brief Mudanças sobrescritas antes de lidas */
+static uint32_t eventos_perdidos = 0;
+
+/** @brief PIO, máquina de estados e canal de DMA do amostrador */
+static PIO pio_amostrador;
+static uint sm_amostrador;
+static int canal_dma = -1;
+
+/** @brief Instante do início da amostra 0, em µs desde o boot */
+static uint64_t inicio_us;
+
+/** @brief Amostras acumuladas nas voltas anteriores do contador de 32 bits */
+static uint64_t amostras_voltas = 0;
+static uint32_t ultimo_contador = 0;
+
+/** @brief Estado do bloco já entregue à task e o da última mudança lida (bit = nível) */
+static uint32_t estado_entregue = 0;
+static uint32_t estado_lido = 0;
+
+/** @brief Instante da última mudança lida */
+static uint64_t borda_lida_us;
+
+/** @brief Task acordada a cada mudança */
+static TaskHandle_t task_consumidora = NULL;
 
 /**
  * @brief Inicializa os pinos GPIO para os botões.
@@ -17,38 +65,187 @@
  * os botões são pressionados (conectados ao GND).
  */
 void buttons_init(void) {
-    // Botão A
-    gpio_init(BUTTON_A_PIN);
-    gpio_set_dir(BUTTON_A_PIN, GPIO_IN);
-    gpio_pull_up(BUTTON_A_PIN); // Assume que o botão conecta o pino ao GND quando pressionado
+    for (uint pino = BUTTONS_PINO_BASE; pino < BUTTONS_PINO_BASE + BUTTONS_NUM_PINOS; pino++) {
+        gpio_init(pino);
+        gpio_set_dir(pino, GPIO_IN);
+        gpio_pull_up(pino); // Assume que o botão conecta o pino ao GND quando pressionado
+    }
+}
 
-    // Botão B
-    gpio_init(BUTTON_B_PIN);
-    gpio_set_dir(BUTTON_B_PIN, GPIO_IN);
-    gpio_pull_up(BUTTON_B_PIN); // Assume que o botão conecta o pino ao GND quando pressionado
-    
-    // Para debouncing, você poderia inicializar timers ou interrupções aqui,
-    // mas para manter simples, faremos debouncing por software na task se necessário,
-    // ou apenas leituras periódicas.
+/**
+ * @brief Acorda a task consumidora a cada mudança empurrada pelo PIO.
+ *
+ * O DMA tira as duas palavras da FIFO logo depois dos pushes, bem antes de
+ * a task acordar.
+ */
+static void tratar_irq_pio(void) {
+    if (!pio_interrupt_get(pio_amostrador, sm_amostrador)) {
+        return;
+    }
+    pio_interrupt_clear(pio_amostrador, sm_amostrador);
+
+    BaseType_t acordou_prioritaria = pdFALSE;
+    xTaskNotifyFromISR(task_consumidora, 0, eIncrement, &acordou_prioritaria);
+    portYIELD_FROM_ISR(acordou_prioritaria);
 }
 
 /**
- * @brief Lê o estado atual dos botões.
+ * @brief Palavras que o DMA já escreveu no anel desde o início.
+ */
+static inline uint32_t palavras_escritas(void) {
+    return 0xFFFFFFFFu - dma_channel_hw_addr(canal_dma)->transfer_count;
+}
+
+/**
+ * @brief Lê a próxima mudança completa do anel, se houver.
  *
- * Esta função lê o estado atual dos pinos GPIO conectados aos botões A e B
- * e armazena os resultados na estrutura ButtonStates_t fornecida.
- * Com resistores pull-up, quando o botão é pressionado, o pino vai para estado LOW.
+ * Se o DMA deu a volta no anel por cima de mudanças não lidas, descarta a
+ * metade mais antiga do anel e conta as perdas.
  *
- * @param states Ponteiro para a estrutura ButtonStates_t onde o estado será armazenado
- * @note O estado de um botão será considerado como pressionado (true) quando o pino estiver em LOW
+ * @return true se uma mudança foi lida para estado_lido e borda_lida_us
  */
-void buttons_read(ButtonStates_t *states) {
-    if (states == NULL) {
-        return;
+static bool ler_mudanca(void) {
+    uint32_t escritas = palavras_escritas();
+    if (escritas - palavras_lidas > PALAVRAS_ANEL) {
+        uint32_t retomada = (escritas & ~(PALAVRAS_POR_MUDANCA - 1u)) - PALAVRAS_ANEL / 2;
+        eventos_perdidos += (retomada - palavras_lidas) / PALAVRAS_POR_MUDANCA;
+        palavras_lidas = retomada;
+    }
+    if (escritas - palavras_lidas < PALAVRAS_POR_MUDANCA) {
+        return false;
+    }
+
+    uint32_t estado = anel[palavras_lidas % PALAVRAS_ANEL];
+    uint32_t contador = anel[(palavras_lidas + 1) % PALAVRAS_ANEL];
+    if (palavras_escritas() - palavras_lidas > PALAVRAS_ANEL) {
+        // Sobrescrita durante a cópia: descarta e lê de novo
+        return ler_mudanca();
+    }
+    palavras_lidas += PALAVRAS_POR_MUDANCA;
+
+    // O PIO conta para baixo a partir de ~0; a primeira leitura diferente
+    // foi BUTTONS_DEBOUNCE_AMOSTRAS + 1 amostras antes do contador enviado
+    uint32_t amostras = 0xFFFFFFFFu - contador;
+    if (amostras < ultimo_contador) {
+        amostras_voltas += 1ull << 32;
     }
-    // Com pull-up, o pino vai para LOW (0) quando o botão é pressionado.
-    // gpio_get() retorna true (1) se HIGH, false (0) se LOW.
-    // Portanto, invertemos a lógica para 'pressed' ser true quando o pino está em LOW.
-    states->button_a_pressed = !gpio_get(BUTTON_A_PIN);
-    states->button_b_pressed = !gpio_get(BUTTON_B_PIN);
-}
\ No newline at end of file
+    ultimo_contador = amostras;
+    uint64_t amostra_borda = amostras_voltas + amostras - (BUTTONS_DEBOUNCE_AMOSTRAS + 1);
+
+    estado_lido = estado & MASCARA_PINOS;
+    borda_lida_us = inicio_us + amostra_borda * BUTTONS_PERIODO_AMOSTRA_US;
+    return true;
+}
+
+/**
+ * @brief Carrega o programa com as instruções "in pins" ajustadas ao tamanho do bloco.
+ *
+ * @return Offset do programa, ou -1 se não coube em nenhum PIO livre
+ */
+static int carregar_programa(void) {
+    static uint16_t instrucoes[sizeof(amostrador_entradas_program_instructions) / sizeof(uint16_t)];
+    for (uint i = 0; i < count_of(instrucoes); i++) {
+        instrucoes[i] = amostrador_entradas_program_instructions[i];
+    }
+    instrucoes[amostrador_entradas_offset_leitura] = pio_encode_in(pio_pins, BUTTONS_NUM_PINOS);
+    instrucoes[amostrador_entradas_offset_confirmacao] = pio_encode_in(pio_pins, BUTTONS_NUM_PINOS);
+
+    pio_program_t programa = amostrador_entradas_program;
+    programa.instructions = instrucoes;
+
+    // O driver do CYW43 também usa um PIO; fica com o que tiver espaço
+    PIO candidatos[] = { pio0, pio1 };
+    for (uint i = 0; i < count_of(candidatos); i++) {
+        if (!pio_can_add_program(candidatos[i], &programa)) {
+            continue;
+        }
+        int sm = pio_claim_unused_sm(candidatos[i], false);
+        if (sm < 0) {
+            continue;
+        }
+        pio_amostrador = candidatos[i];
+        sm_amostrador = (uint)sm;
+        return (int)pio_add_program(pio_amostrador, &programa);
+    }
+    return -1;
+}
+
+/**
+ * @brief Carrega o amostrador no PIO, liga o DMA e passa a notificar a task chamadora.
+ */
+bool buttons_iniciar_eventos(void) {
+    task_consumidora = xTaskGetCurrentTaskHandle();
+    int offset = carregar_programa();
+    if (offset < 0) {
+        return false;
+    }
+
+    pio_sm_config config = amostrador_entradas_program_get_default_config((uint)offset);
+    sm_config_set_in_pins(&config, BUTTONS_PINO_BASE);
+    sm_config_set_in_shift(&config, false, false, 32);                     // Leitura nos bits baixos da ISR
+    sm_config_set_out_shift(&config, true, false, BUTTONS_DEBOUNCE_AMOSTRAS); // Limiar = janela de debounce
+    sm_config_set_fifo_join(&config, PIO_FIFO_JOIN_RX);
+    sm_config_set_clkdiv(&config, (float)clock_get_hz(clk_sys) * BUTTONS_PERIODO_AMOSTRA_US /
+                                      (1000000.0f * CICLOS_POR_AMOSTRA));
+    pio_sm_set_consecutive_pindirs(pio_amostrador, sm_amostrador, BUTTONS_PINO_BASE, BUTTONS_NUM_PINOS, false);
+    pio_sm_init(pio_amostrador, sm_amostrador, (uint)offset, &config);
+
+    // X (estado estável) começa em zero e Y (contador) em ~0
+    pio_sm_exec(pio_amostrador, sm_amostrador, pio_encode_set(pio_x, 0));
+    pio_sm_exec(pio_amostrador, sm_amostrador, pio_encode_mov_not(pio_y, pio_null));
+
+    canal_dma = dma_claim_unused_channel(true);
+    dma_channel_config config_dma = dma_channel_get_default_config(canal_dma);
+    channel_config_set_transfer_data_size(&config_dma, DMA_SIZE_32);
+    channel_config_set_read_increment(&config_dma, false);
+    channel_config_set_write_increment(&config_dma, true);
+    channel_config_set_ring(&config_dma, true, __builtin_ctz(sizeof(anel)));
+    channel_config_set_dreq(&config_dma, pio_get_dreq(pio_amostrador, sm_amostrador, false));
+    dma_channel_configure(canal_dma, &config_dma, anel, &pio_amostrador->rxf[sm_amostrador], 0xFFFFFFFFu, true);
+
+    uint irq_pio = pio_amostrador == pio0 ? PIO0_IRQ_0 : PIO1_IRQ_0;
+    pio_set_irq0_source_enabled(pio_amostrador, (enum pio_interrupt_source)(pis_interrupt0 + sm_amostrador), true);
+    irq_add_shared_handler(irq_pio, tratar_irq_pio, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(irq_pio, true);
+
+    inicio_us = time_us_64();
+    pio_sm_set_enabled(pio_amostrador, sm_amostrador, true);
+    return true;
+}
+
+/**
+ * @brief Espera a próxima mudança confirmada de um botão.
+ */
+bool buttons_aguardar_evento(EventoBotao_t *evento, TickType_t espera) {
+    if (canal_dma < 0) {
+        return false;
+    }
+    bool esperou = false;
+    while (true) {
+        uint32_t diferenca = estado_entregue ^ estado_lido;
+        if (diferenca) {
+            uint bit = (uint)__builtin_ctz(diferenca);
+            estado_entregue ^= 1u << bit;
+            evento->pino = (uint8_t)(BUTTONS_PINO_BASE + bit);
+            evento->pressionado = !(estado_lido & (1u << bit)); // Nível baixo = pressionado
+            evento->borda_us = borda_lida_us;
+            return true;
+        }
+        if (ler_mudanca()) {
+            continue;
+        }
+        if (esperou) {
+            return false;
+        }
+        // Uma notificação que chegue depois do teste fica pendente e libera a espera na hora
+        ulTaskNotifyTake(pdTRUE, espera);
+        esperou = true;
+    }
+}
+
+/**
+ * @brief Retorna quantas mudanças do bloco foram sobrescritas no anel antes de lidas.
+ */
+uint32_t buttons_eventos_perdidos(void) {
+    return eventos_perdidos;
+}
@@ -4,12 +4,30 @@
  *
  * Este arquivo define as constantes e funções para controle
  * dos botões conectados ao microcontrolador Raspberry Pi Pico.
+ *
+ * Os botões formam um bloco de pinos consecutivos lido por uma máquina de
+ * estados do PIO (amostrador_entradas.pio) a uma taxa fixa. O debounce é
+ * feito no próprio PIO, que só empurra para a FIFO RX as mudanças
+ * confirmadas, cada uma com o contador de amostras do momento. Um canal de
+ * DMA esvazia a FIFO em um anel na RAM e a IRQ do PIO acorda a task
+ * consumidora com xTaskNotifyFromISR(); a CPU não lê pinos nem trata
+ * repiques, e crescer o bloco não custa mais interrupções.
+ *
+ * O driver entrega um fluxo de eventos por pino, com o instante da borda
+ * reconstruído do contador (resolução de uma amostra). O estado inicial de
+ * todos os pinos é "pressionado" (nível baixo, o valor inicial do PIO): na
+ * partida chega um evento para cada botão solto.
+ *
+ * ferramentas/modelo_amostrador_pio.py interpreta o programa PIO no host e
+ * mostra os eventos gerados para uma trilha de níveis.
  */
 
 #ifndef BUTTONS_H
 #define BUTTONS_H
 
 #include "pico/stdlib.h" // Para bool e tipos uint
+#include "FreeRTOS.h"
+#include "task.h"
 
 /**
  * @defgroup BUTTONS_DRIVER Driver de Botões
@@ -26,6 +44,45 @@
  */
 #define BUTTON_B_PIN 6
 
+/**
+ * @brief Primeiro pino do bloco amostrado pelo PIO
+ */
+#define BUTTONS_PINO_BASE BUTTON_A_PIN
+
+/**
+ * @brief Número de pinos consecutivos do bloco (1 a 31)
+ */
+#define BUTTONS_NUM_PINOS 2
+
+/**
+ * @brief Período de amostragem do bloco, em µs
+ */
+#define BUTTONS_PERIODO_AMOSTRA_US 250
+
+/**
+ * @brief Amostras iguais exigidas para confirmar uma mudança (1 a 32)
+ */
+#define BUTTONS_DEBOUNCE_AMOSTRAS 20
+
+/**
+ * @brief Duração da janela de debounce, em µs
+ */
+#define BUTTONS_DEBOUNCE_US (BUTTONS_DEBOUNCE_AMOSTRAS * BUTTONS_PERIODO_AMOSTRA_US)
+
+/**
+ * @brief Mudanças do bloco que cabem no anel do DMA (potência de 2)
+ */
+#define BUTTONS_CAPACIDADE_EVENTOS 8
+
+/**
+ * @brief Mudança confirmada de um botão
+ */
+typedef struct {
+    uint8_t pino;         /**< Pino do bloco que mudou */
+    bool pressionado;     /**< Novo estado do botão */
+    uint64_t borda_us;    /**< Instante da primeira leitura diferente, em µs desde o boot */
+} EventoBotao_t;
+
 /**
  * @brief Estrutura para armazenar o estado dos botões e temperatura
  *
@@ -33,9 +90,9 @@
  * e o valor atual de temperatura lido pelo sensor.
  */
 typedef struct {
-    bool button_a_pressed;    /**< Estado do botão A: true se pressionado, false caso contrário */
-    bool button_b_pressed;    /**< Estado do botão B: true se pressionado, false caso contrário */
-    float temperature;        /**< Temperatura atual em graus Celsius */
+    bool button_a_pressed;      /**< Estado do botão A: true se pressionado, false caso contrário */
+    bool button_b_pressed;      /**< Estado do botão B: true se pressionado, false caso contrário */
+    int32_t temperature_centi;  /**< Temperatura atual em centésimos de grau Celsius */
 } ButtonStates_t;
 
 /**
@@ -45,10 +102,33 @@ typedef struct {
 void buttons_init(void);
 
 /**
- * @brief Lê o estado atual dos botões.
- * @param states Ponteiro para a estrutura ButtonStates_t onde o estado será armazenado.
+ * @brief Carrega o amostrador no PIO, liga o DMA e passa a notificar a task chamadora.
+ *
+ * Deve ser chamada pela task que vai consumir os eventos, depois de
+ * buttons_init(). A IRQ do PIO fica no núcleo que fez a chamada.
+ *
+ * @return true se o programa coube em um PIO e a amostragem começou
+ */
+bool buttons_iniciar_eventos(void);
+
+/**
+ * @brief Espera a próxima mudança confirmada de um botão.
+ *
+ * Uma mudança do bloco que envolve vários pinos vira um evento por pino,
+ * todos com o mesmo instante. Sem eventos pendentes, bloqueia a task em
+ * ulTaskNotifyTake() até a IRQ do PIO notificar ou o tempo acabar.
+ *
+ * @param evento Recebe o evento
+ * @param espera Tempo máximo de espera, em ticks
+ * @return true se havia ou chegou um evento; false se o tempo acabou
+ */
+bool buttons_aguardar_evento(EventoBotao_t *evento, TickType_t espera);
+
+/**
+ * @brief Retorna quantas mudanças do bloco foram sobrescritas no anel antes de lidas.
+ * @return Número de eventos perdidos desde o boot
  */
-void buttons_read(ButtonStates_t *states);
+uint32_t buttons_eventos_perdidos(void);
 
 /** @} */ // Fim do grupo BUTTONS_DRIVER
 
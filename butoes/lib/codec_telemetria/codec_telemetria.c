@@ -0,0 +1,121 @@
+/**
+ * @file codec_telemetria.c
+ * @brief Implementação do codificador de lotes de telemetria
+ *
+ * No formato binário os campos são escritos byte a byte em little-endian,
+ * sem depender do layout das structs em memória. A temperatura já chega
+ * em centésimos de grau e é formatada no JSON sem ponto flutuante.
+ */
+
+#include <stdio.h>
+#include "codec_telemetria.h"
+#include "sensor_temp.h"
+
+#if TELEMETRIA_FORMATO == TELEMETRIA_FORMATO_BINARIO
+/**
+ * @brief Escreve um inteiro de 16 bits em little-endian.
+ */
+static void escrever_u16_le(uint8_t *destino, uint16_t valor) {
+    destino[0] = (uint8_t)(valor & 0xFF);
+    destino[1] = (uint8_t)(valor >> 8);
+}
+
+/**
+ * @brief Escreve um inteiro de 32 bits em little-endian.
+ */
+static void escrever_u32_le(uint8_t *destino, uint32_t valor) {
+    destino[0] = (uint8_t)(valor & 0xFF);
+    destino[1] = (uint8_t)((valor >> 8) & 0xFF);
+    destino[2] = (uint8_t)((valor >> 16) & 0xFF);
+    destino[3] = (uint8_t)(valor >> 24);
+}
+#endif
+
+/**
+ * @brief Retorna o valor do cabeçalho Content-Type do formato selecionado.
+ */
+const char *codec_telemetria_content_type(void) {
+#if TELEMETRIA_FORMATO == TELEMETRIA_FORMATO_BINARIO
+    return "application/vnd.embarcatech.telemetria; esquema=1";
+#else
+    return "application/json";
+#endif
+}
+
+/**
+ * @brief Começa um novo lote no buffer de saída.
+ *
+ * No formato JSON abre o array; no binário reserva o cabeçalho, cuja
+ * quantidade só é conhecida no fechamento.
+ */
+void codec_telemetria_iniciar_lote(CodificadorLote_t *codificador, uint8_t *destino, size_t capacidade) {
+    codificador->destino = destino;
+    codificador->capacidade = capacidade;
+    codificador->quantidade = 0;
+#if TELEMETRIA_FORMATO == TELEMETRIA_FORMATO_BINARIO
+    destino[0] = TELEMETRIA_ESQUEMA_BOTOES;
+    codificador->usado = TELEMETRIA_TAMANHO_CABECALHO;
+#else
+    destino[0] = '[';
+    codificador->usado = 1;
+#endif
+}
+
+/**
+ * @brief Acrescenta uma amostra ao lote.
+ */
+bool codec_telemetria_adicionar(CodificadorLote_t *codificador, const Amostra_t *amostra) {
+    uint8_t *cursor = codificador->destino + codificador->usado;
+
+#if TELEMETRIA_FORMATO == TELEMETRIA_FORMATO_BINARIO
+    if (codificador->usado + TELEMETRIA_TAMANHO_REGISTRO > codificador->capacidade) {
+        return false;
+    }
+    int32_t centesimos = amostra->estado.temperature_centi;
+    int16_t temperatura = (int16_t)(centesimos > INT16_MAX ? INT16_MAX :
+                                    centesimos < INT16_MIN ? INT16_MIN : centesimos);
+    uint8_t flags = (amostra->estado.button_a_pressed ? 0x01 : 0) |
+                    (amostra->estado.button_b_pressed ? 0x02 : 0);
+
+    escrever_u32_le(cursor, amostra->sequencia);
+    escrever_u32_le(cursor + 4, amostra->timestamp_ms);
+    cursor[8] = flags;
+    escrever_u16_le(cursor + 9, (uint16_t)temperatura);
+    codificador->usado += TELEMETRIA_TAMANHO_REGISTRO;
+#else
+    // Reserva o separador, o ']' de fechamento e o terminador do snprintf
+    size_t separador = (codificador->quantidade > 0) ? 1 : 0;
+    if (codificador->usado + separador + 2 > codificador->capacidade) {
+        return false;
+    }
+    size_t livre = codificador->capacidade - codificador->usado - separador - 2;
+    int escrito = snprintf((char *)cursor + separador, livre + 1,
+                           "{\"seq\": %lu, \"t\": %lu, \"button_a\": %d, \"button_b\": %d, \"temperature\": " TEMPERATURA_CENTI_FORMATO "}",
+                           (unsigned long)amostra->sequencia, (unsigned long)amostra->timestamp_ms,
+                           amostra->estado.button_a_pressed ? 1 : 0,
+                           amostra->estado.button_b_pressed ? 1 : 0,
+                           TEMPERATURA_CENTI_ARGS(amostra->estado.temperature_centi));
+    if (escrito < 0 || (size_t)escrito > livre) {
+        return false;
+    }
+    if (separador) {
+        cursor[0] = ',';
+    }
+    codificador->usado += separador + (size_t)escrito;
+#endif
+
+    codificador->quantidade++;
+    return true;
+}
+
+/**
+ * @brief Fecha o lote.
+ */
+size_t codec_telemetria_finalizar_lote(CodificadorLote_t *codificador) {
+#if TELEMETRIA_FORMATO == TELEMETRIA_FORMATO_BINARIO
+    escrever_u16_le(codificador->destino + 1, codificador->quantidade);
+#else
+    codificador->destino[codificador->usado++] = ']';
+#endif
+    return codificador->usado;
+}
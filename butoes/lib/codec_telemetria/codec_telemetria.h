@@ -0,0 +1,110 @@
+/**
+ * @file codec_telemetria.h
+ * @brief Interface do codificador de lotes de telemetria
+ *
+ * Este arquivo define o codificador usado pelo cliente HTTP para serializar
+ * um lote de amostras dos botões e temperatura. Há dois formatos: JSON
+ * (texto, compatível com o servidor original) e um registro binário
+ * compacto de tamanho fixo em little-endian, identificado por um ID de
+ * esquema. O formato é escolhido em tempo de compilação e anunciado no
+ * cabeçalho Content-Type.
+ */
+
+#ifndef CODEC_TELEMETRIA_H
+#define CODEC_TELEMETRIA_H
+
+#include <stddef.h>
+#include "pico/stdlib.h"
+#include "buffer_amostras.h"
+
+/**
+ * @defgroup CODEC_TELEMETRIA Codificador de Telemetria
+ * @{
+ */
+
+/**
+ * @brief Formato texto: array JSON de objetos
+ */
+#define TELEMETRIA_FORMATO_JSON 0
+
+/**
+ * @brief Formato binário compacto: cabeçalho + registros little-endian de tamanho fixo
+ */
+#define TELEMETRIA_FORMATO_BINARIO 1
+
+/**
+ * @brief Formato usado nos envios (pode ser sobrescrito na linha de compilação)
+ */
+#ifndef TELEMETRIA_FORMATO
+#define TELEMETRIA_FORMATO TELEMETRIA_FORMATO_JSON
+#endif
+
+/**
+ * @brief ID de esquema dos registros binários dos botões e temperatura
+ *
+ * Layout do lote binário:
+ * - byte 0: ID de esquema (TELEMETRIA_ESQUEMA_BOTOES)
+ * - bytes 1-2: quantidade de registros (uint16 little-endian)
+ * - registros de TELEMETRIA_TAMANHO_REGISTRO bytes cada:
+ *   - uint32 número de sequência da amostra
+ *   - uint32 timestamp em ms desde o boot
+ *   - uint8 flags (bit 0 = botão A, bit 1 = botão B)
+ *   - int16 temperatura em centésimos de grau Celsius
+ */
+#define TELEMETRIA_ESQUEMA_BOTOES 0x01
+
+/**
+ * @brief Tamanho, em bytes, do cabeçalho de um lote binário
+ */
+#define TELEMETRIA_TAMANHO_CABECALHO 3
+
+/**
+ * @brief Tamanho, em bytes, de cada registro binário
+ */
+#define TELEMETRIA_TAMANHO_REGISTRO 11
+
+/**
+ * @brief Estado de um lote em codificação
+ */
+typedef struct {
+    uint8_t *destino;    /**< Início do buffer de saída */
+    size_t capacidade;   /**< Tamanho do buffer de saída */
+    size_t usado;        /**< Bytes já escritos */
+    uint16_t quantidade; /**< Amostras já adicionadas */
+} CodificadorLote_t;
+
+/**
+ * @brief Retorna o valor do cabeçalho Content-Type do formato selecionado.
+ * @return String constante com o tipo de mídia
+ */
+const char *codec_telemetria_content_type(void);
+
+/**
+ * @brief Começa um novo lote no buffer de saída.
+ * @param codificador Estado do lote
+ * @param destino Buffer de saída
+ * @param capacidade Tamanho do buffer de saída
+ */
+void codec_telemetria_iniciar_lote(CodificadorLote_t *codificador, uint8_t *destino, size_t capacidade);
+
+/**
+ * @brief Acrescenta uma amostra ao lote.
+ *
+ * Nada é escrito se a amostra não couber junto com o fechamento do lote.
+ *
+ * @param codificador Estado do lote
+ * @param amostra Amostra a ser codificada
+ * @return true se a amostra foi adicionada, false se não havia espaço
+ */
+bool codec_telemetria_adicionar(CodificadorLote_t *codificador, const Amostra_t *amostra);
+
+/**
+ * @brief Fecha o lote.
+ * @param codificador Estado do lote
+ * @return Tamanho final do lote, em bytes
+ */
+size_t codec_telemetria_finalizar_lote(CodificadorLote_t *codificador);
+
+/** @} */ // Fim do grupo CODEC_TELEMETRIA
+
+#endif // CODEC_TELEMETRIA_H
@@ -4,177 +4,1098 @@
  *
  * Este arquivo implementa as funções do cliente HTTP que utiliza lwIP para
  * enviar dados dos botões e temperatura para um servidor remoto via HTTP.
+ *
+ * O cliente é um motor de requisições assíncrono: cada requisição ocupa um
+ * contexto de um pool estático (HTTP_NUM_REQUISICOES), com cópia própria do
+ * corpo, prazo (timeout) e callback de conclusão. As requisições são
+ * atendidas em ordem sobre uma única conexão TCP HTTP/1.1 (keep-alive) com
+ * PROXY_HOST:PROXY_PORT, que é reaberta de forma transparente quando o
+ * servidor a encerra.
+ *
+ * Até HTTP_JANELA_PIPELINE requisições ficam em voo ao mesmo tempo
+ * (pipelining): cada nova requisição é escrita sem esperar a resposta da
+ * anterior e as respostas, que chegam na mesma ordem, são casadas com a
+ * fila de requisições em voo. A janela começa em 1 a cada conexão e cresce
+ * a cada resposta recebida; além dela, só se escreve quando o lwIP tem
+ * espaço de envio (tcp_sndbuf), e cada ACK (tcp_sent) volta a tentar.
+ *
+ * As respostas são lidas em fluxo por resposta_http.h, direto nos pbufs
+ * recebidos e sem alocação, e a janela de recepção é reaberta com
+ * tcp_recved() a cada segmento consumido.
+ *
+ * A parte constante do cabeçalho HTTP (incluindo o Content-Type do formato
+ * de telemetria escolhido em codec_telemetria.h) é montada uma única vez em
+ * http_client_init() e entregue ao lwIP por referência. Apenas o
+ * Content-Length e o corpo são produzidos a cada envio, diretamente no
+ * buffer do contexto, que também é passado sem cópia; por isso um contexto
+ * só volta ao pool depois que todos os seus bytes forem confirmados (ACK).
+ *
+ * As amostras de cada lote em envio ficam copiadas ao lado do contexto até
+ * a resposta. Se o lote falha, elas são devolvidas à task de rede (ver
+ * http_client_retirar_devolvida()), que as grava de novo no log em flash:
+ * a entrega passa a ser pelo menos uma vez, e o servidor descarta
+ * duplicatas pelo número de sequência.
+ *
+ * Todos os callbacks (inclusive os de conclusão entregues a quem fez a
+ * requisição) executam no contexto do lwIP.
  */
 
 #include "cliente_http.h"
+#include <stddef.h>
+#include "lwip/timeouts.h"
+
+/**
+ * @brief Espaço reservado no início do buffer de cada requisição para o valor
+ *        do Content-Length (até 5 dígitos) seguido de "\r\n\r\n"
+ */
+#define RESERVA_CONTENT_LENGTH 9
+
+/**
+ * @brief Período, em ms, da verificação de prazos enquanto há requisições ativas
+ */
+#define INTERVALO_VERIFICACAO_PRAZOS_MS 250
+
+/**
+ * @brief Estados possíveis da conexão persistente com o servidor
+ */
+typedef enum {
+    CONEXAO_FECHADA,     /**< Nenhum PCB aberto */
+    CONEXAO_RESOLVENDO,  /**< Aguardando a resolução DNS de PROXY_HOST */
+    CONEXAO_CONECTANDO,  /**< tcp_connect() emitido, aguardando o handshake */
+    CONEXAO_ABERTA       /**< Conexão estabelecida e pronta para reutilização */
+} EstadoConexao;
+
+/**
+ * @brief Estados de um contexto de requisição do pool
+ */
+typedef enum {
+    REQUISICAO_LIVRE,     /**< Contexto disponível */
+    REQUISICAO_NA_FILA,   /**< Aguardando a vez de ser escrita na conexão */
+    REQUISICAO_ENVIADA,   /**< Escrita na conexão, aguardando a resposta */
+    REQUISICAO_CONCLUIDA  /**< Já finalizada, aguardando o ACK dos últimos bytes */
+} EstadoRequisicao;
+
+/**
+ * @brief Contexto de uma requisição HTTP
+ *
+ * O corpo é escrito a partir de RESERVA_CONTENT_LENGTH e o Content-Length é
+ * encostado à esquerda dele, de modo que a parte variável da requisição fica
+ * contígua em buffer[inicio..] sem nenhum memmove.
+ */
+typedef struct {
+    EstadoRequisicao estado;         /**< Estado do contexto */
+    uint32_t id;                     /**< Identificador entregue a quem fez a requisição */
+    uint32_t prazo_ms;               /**< Instante limite para a conclusão (ms desde o boot) */
+    uint8_t tentativas;              /**< Vezes que a requisição já foi escrita na conexão */
+    uint16_t bytes_sem_ack;          /**< Bytes escritos e ainda não confirmados pelo servidor */
+    EntregaHttp_t entrega;           /**< Instantes de cada etapa da entrega */
+    uint16_t inicio;                 /**< Início da parte variável em buffer */
+    uint16_t tamanho;                /**< Tamanho da parte variável (Content-Length + corpo) */
+    CallbackRequisicaoHttp callback; /**< Callback de conclusão (pode ser NULL) */
+    void *arg;                       /**< Argumento repassado ao callback */
+    char buffer[RESERVA_CONTENT_LENGTH + HTTP_TAMANHO_MAX_CORPO]; /**< Content-Length e corpo */
+} RequisicaoHttp;
+
+/**
+ * @brief Gerenciador da conexão keep-alive com o servidor
+ */
+typedef struct {
+    struct tcp_pcb *pcb;          /**< PCB da conexão, NULL se fechada */
+    EstadoConexao estado;         /**< Estado atual da conexão */
+    uint8_t tentativas_reconexao; /**< Reconexões consecutivas sem sucesso */
+    RequisicaoHttp *em_voo[HTTP_JANELA_PIPELINE]; /**< Requisições escritas aguardando resposta, em ordem de envio */
+    uint8_t num_em_voo;           /**< Número de requisições em em_voo */
+    uint8_t janela;               /**< Limite atual de requisições em voo nesta conexão */
+    LeitorRespostaHttp_t leitor;  /**< Leitura incremental da resposta em andamento */
+    uint32_t etapa_iniciada_em_ms; /**< Início da resolução DNS ou do handshake em andamento */
+} GerenciadorConexao;
+
+/** @brief Instância única da conexão persistente */
+static GerenciadorConexao conexao = { .pcb = NULL, .estado = CONEXAO_FECHADA, .num_em_voo = 0, .janela = 1 };
+
+/** @brief Pool estático de contextos de requisição */
+static RequisicaoHttp pool_requisicoes[HTTP_NUM_REQUISICOES];
+
+/**
+ * @brief Amostras de um lote em envio
+ *
+ * O corpo codificado não serve para recuperar as amostras; é desta cópia
+ * que elas voltam se o lote não for entregue.
+ */
+typedef struct {
+    Amostra_t amostras[HTTP_TAMANHO_LOTE]; /**< Amostras do lote, na ordem de envio */
+    uint16_t quantidade;                   /**< Amostras válidas em amostras */
+} LoteEmEnvio;
+
+/** @brief Cópia das amostras de cada contexto do pool, no mesmo índice */
+static LoteEmEnvio lotes_em_envio[HTTP_NUM_REQUISICOES];
+
+/** @brief Amostras de lotes que falharam, aguardando a task gravá-las no log */
+static BufferAmostras_t amostras_devolvidas;
+
+/** @brief Próximo identificador de requisição (também define a ordem de envio) */
+static uint32_t proximo_id = 1;
+
+/** @brief Contadores do motor de requisições */
+static EstatisticasHttp_t estatisticas;
+
+/** @brief Indica se o timer de verificação de prazos está armado */
+static bool verificacao_agendada = false;
+
+/** @brief Parte constante do cabeçalho, terminando em "Content-Length: " */
+static char cabecalho_fixo[HTTP_TAMANHO_MAX_CABECALHO];
+
+/** @brief Número de bytes válidos em cabecalho_fixo */
+static uint16_t tamanho_cabecalho_fixo = 0;
+
+/** @brief Limite de taxa dos lotes de amostras */
+static LimitadorEnvio_t limitador_lotes;
+
+/** @brief Histogramas das etapas de entrega */
+static LatenciasHttp_t latencias;
+
+/** @brief Chamada quando um contexto volta ao pool */
+static AvisoClienteHttp aviso_liberacao = NULL;
+
+/**
+ * @brief Tempo, em ms, desde um instante anterior.
+ */
+static uint32_t decorrido_ms(uint32_t desde_ms) {
+    return to_ms_since_boot(get_absolute_time()) - desde_ms;
+}
+
+static void iniciar_conexao(void);
+static void processar_fila(void);
+
+/**
+ * @brief Devolve um contexto ao pool.
+ * @param req Contexto a ser liberado
+ */
+static void liberar_requisicao(RequisicaoHttp *req) {
+    req->estado = REQUISICAO_LIVRE;
+    req->callback = NULL;
+    req->arg = NULL;
+    estatisticas.em_andamento--;
+    if (aviso_liberacao) {
+        aviso_liberacao();
+    }
+}
+
+/**
+ * @brief Retira uma requisição da fila de requisições em voo, se estiver nela.
+ * @param req Requisição a ser retirada
+ */
+static void remover_em_voo(RequisicaoHttp *req) {
+    for (uint8_t i = 0; i < conexao.num_em_voo; i++) {
+        if (conexao.em_voo[i] == req) {
+            conexao.num_em_voo--;
+            memmove(&conexao.em_voo[i], &conexao.em_voo[i + 1],
+                    (conexao.num_em_voo - i) * sizeof(conexao.em_voo[0]));
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Finaliza uma requisição e notifica quem a fez.
+ *
+ * O contexto só volta ao pool quando o lwIP não referencia mais o buffer;
+ * até lá ele fica em REQUISICAO_CONCLUIDA.
+ *
+ * @param req Requisição a ser finalizada
+ * @param sucesso true se o servidor respondeu com status 2xx
+ * @param status_http Código de status HTTP (0 se não houve resposta)
+ */
+static void finalizar_requisicao(RequisicaoHttp *req, bool sucesso, int status_http) {
+    remover_em_voo(req);
+    if (sucesso) {
+        estatisticas.concluidas++;
+    } else {
+        estatisticas.falhas++;
+    }
+
+    // A latência e o callback usam o contexto, que só depois pode voltar ao pool
+    req->estado = REQUISICAO_CONCLUIDA;
+    if (status_http != 0) {
+        req->entrega.respondida_em_ms = to_ms_since_boot(get_absolute_time());
+        histograma_latencia_registrar(&latencias.resposta,
+                                      req->entrega.respondida_em_ms - req->entrega.escrita_em_ms);
+    }
+    if (req->callback) {
+        req->callback(req->id, sucesso, status_http, &req->entrega, req->arg);
+    }
+    if (req->bytes_sem_ack == 0) {
+        liberar_requisicao(req);
+    }
+}
+
+/**
+ * @brief Procura a requisição mais antiga na fila.
+ * @return Requisição na fila com o menor id, ou NULL se a fila está vazia
+ */
+static RequisicaoHttp *proxima_da_fila(void) {
+    RequisicaoHttp *mais_antiga = NULL;
+    for (int i = 0; i < HTTP_NUM_REQUISICOES; i++) {
+        RequisicaoHttp *req = &pool_requisicoes[i];
+        if (req->estado == REQUISICAO_NA_FILA && (!mais_antiga || req->id < mais_antiga->id)) {
+            mais_antiga = req;
+        }
+    }
+    return mais_antiga;
+}
+
+/**
+ * @brief Falha todas as requisições que ainda estão na fila.
+ */
+static void falhar_fila(void) {
+    RequisicaoHttp *req;
+    while ((req = proxima_da_fila()) != NULL) {
+        finalizar_requisicao(req, false, 0);
+    }
+}
+
+/**
+ * @brief Desassocia os callbacks do PCB e marca a conexão como fechada.
+ *
+ * Os buffers do pool vão ao lwIP por referência, e tcp_close() mantém os
+ * segmentos ainda não confirmados para retransmiti-los depois do FIN. Por
+ * isso a conexão só é fechada com tcp_close() quando todos os bytes já
+ * foram confirmados; havendo bytes pendentes ela é abortada, e o
+ * tcp_abort() libera os segmentos na hora. Só então o lwIP não referencia
+ * mais nenhum buffer do pool: os contextos já concluídos voltam ao pool e
+ * as requisições que aguardavam resposta voltam para a fila, na mesma
+ * ordem (ou falham, se esgotaram as tentativas).
+ *
+ * @param pcb PCB a ser liberado (pode ser NULL se o lwIP já o liberou)
+ * @param abortar true para usar tcp_abort() em vez de tcp_close()
+ * @return ERR_ABRT se o PCB foi abortado (valor que um callback do lwIP deve
+ *         devolver nesse caso), ERR_OK caso contrário
+ */
+static err_t encerrar_conexao(struct tcp_pcb *pcb, bool abortar) {
+    err_t resultado = ERR_OK;
+    if (pcb) {
+        for (int i = 0; i < HTTP_NUM_REQUISICOES; i++) {
+            if (pool_requisicoes[i].bytes_sem_ack > 0) {
+                abortar = true;
+            }
+        }
+        tcp_arg(pcb, NULL);
+        tcp_recv(pcb, NULL);
+        tcp_sent(pcb, NULL);
+        tcp_err(pcb, NULL);
+        if (abortar || tcp_close(pcb) != ERR_OK) {
+            tcp_abort(pcb);
+            resultado = ERR_ABRT;
+        }
+    }
+    conexao.pcb = NULL;
+    conexao.estado = CONEXAO_FECHADA;
+
+    for (int i = 0; i < HTTP_NUM_REQUISICOES; i++) {
+        RequisicaoHttp *req = &pool_requisicoes[i];
+        if (req->bytes_sem_ack > 0) {
+            // O que não foi confirmado nesta conexão será escrito de novo na próxima
+            req->bytes_sem_ack = 0;
+            req->entrega.confirmada_em_ms = 0;
+        }
+        if (req->estado == REQUISICAO_CONCLUIDA) {
+            liberar_requisicao(req);
+        }
+    }
+
+    // O id não muda, então as requisições devolvidas à fila mantêm a ordem original
+    while (conexao.num_em_voo > 0) {
+        RequisicaoHttp *req = conexao.em_voo[0];
+        if (req->tentativas < HTTP_MAX_TENTATIVAS_REQUISICAO) {
+            remover_em_voo(req);
+            req->estado = REQUISICAO_NA_FILA;
+        } else {
+            finalizar_requisicao(req, false, 0);
+        }
+    }
+    conexao.janela = 1;
+    return resultado;
+}
+
+/**
+ * @brief Reabre a conexão se ainda houver requisições na fila.
+ *
+ * Limita o número de tentativas consecutivas para não entrar em laço
+ * quando o servidor está fora do ar; nesse caso as requisições da fila
+ * falham e o próximo envio tenta de novo.
+ */
+static void reconectar_se_necessario(void) {
+    if (conexao.estado != CONEXAO_FECHADA || !proxima_da_fila()) {
+        return;
+    }
+    if (conexao.tentativas_reconexao >= HTTP_MAX_TENTATIVAS_RECONEXAO) {
+        printf("Servidor indisponível após %d tentativas, descartando requisições.\n",
+               conexao.tentativas_reconexao);
+        conexao.tentativas_reconexao = 0;
+        falhar_fila();
+        return;
+    }
+    conexao.tentativas_reconexao++;
+    iniciar_conexao();
+}
+
+/**
+ * @brief Entradas da fila de envio do lwIP que uma requisição pode ocupar.
+ *
+ * Cada segmento novo ocupa duas (o pbuf de cabeçalhos e o pbuf que aponta
+ * para os dados, já que nada é copiado), e cada um dos dois tcp_write()
+ * pode antes pendurar mais um pbuf no último segmento da fila. Uma
+ * requisição de total bytes abre no máximo total / mss segmentos,
+ * arredondado para cima; com o corpo cheio já passa de um segmento.
+ *
+ * @param total Cabeçalho fixo mais o buffer do contexto, em bytes
+ */
+static uint32_t entradas_fila_envio(uint32_t total) {
+    uint32_t mss = tcp_mss(conexao.pcb);
+    return 2 * ((total + mss - 1) / mss) + 2;
+}
+
+/**
+ * @brief Escreve na conexão as requisições da fila que couberem na janela.
+ *
+ * Só envia com a conexão aberta, enquanto houver menos de conexao.janela
+ * requisições em voo e o lwIP tiver espaço para a requisição inteira. O
+ * cabeçalho fixo e o buffer do contexto são entregues ao lwIP por
+ * referência (sem TCP_WRITE_FLAG_COPY).
+ *
+ * Falta de espaço no buffer de envio não é erro: a requisição continua na
+ * fila e o próximo ACK (callback_dados_enviados) tenta de novo. Só um
+ * ERR_MEM no meio da requisição, com o cabeçalho já na fila, obriga a
+ * abortar a conexão, porque o fluxo ficaria corrompido.
+ *
+ * @return ERR_ABRT se a conexão precisou ser abortada, ERR_OK caso contrário
+ */
+static err_t enviar_proxima_requisicao(void) {
+    if (conexao.estado != CONEXAO_ABERTA) {
+        return ERR_OK;
+    }
+
+    bool escreveu = false;
+    RequisicaoHttp *req;
+    while (conexao.num_em_voo < conexao.janela && (req = proxima_da_fila()) != NULL) {
+        // Sem espaço para a requisição inteira, espera o próximo ACK em vez de
+        // deixar só o cabeçalho na fila
+        uint32_t total = (uint32_t)tamanho_cabecalho_fixo + req->tamanho;
+        if (tcp_sndbuf(conexao.pcb) < total ||
+            tcp_sndqueuelen(conexao.pcb) + entradas_fila_envio(total) > TCP_SND_QUEUELEN) {
+            estatisticas.esperas_envio++;
+            break;
+        }
+
+        err_t erro_envio = tcp_write(conexao.pcb, cabecalho_fixo, tamanho_cabecalho_fixo, TCP_WRITE_FLAG_MORE);
+        if (erro_envio == ERR_MEM) {
+            // Nada foi para a fila: espera o próximo ACK como no caso acima
+            estatisticas.esperas_envio++;
+            break;
+        }
+        if (erro_envio == ERR_OK) {
+            erro_envio = tcp_write(conexao.pcb, req->buffer + req->inicio, req->tamanho, 0);
+        }
+        if (erro_envio != ERR_OK) {
+            printf("Erro ao enviar dados: %d\n", erro_envio);
+            encerrar_conexao(conexao.pcb, true);
+            reconectar_se_necessario();
+            return ERR_ABRT;
+        }
+
+        req->estado = REQUISICAO_ENVIADA;
+        req->tentativas++;
+        req->bytes_sem_ack = (uint16_t)total;
+        req->entrega.escrita_em_ms = to_ms_since_boot(get_absolute_time());
+        histograma_latencia_registrar(&latencias.fila, req->entrega.escrita_em_ms - req->entrega.enfileirada_em_ms);
+        conexao.em_voo[conexao.num_em_voo++] = req;
+        escreveu = true;
+        printf("Requisição %lu enviada para %s:%d (%lu bytes, %u em voo)\n",
+               (unsigned long)req->id, PROXY_HOST, PROXY_PORT, (unsigned long)total, conexao.num_em_voo);
+    }
+
+    if (escreveu) {
+        tcp_output(conexao.pcb);
+    }
+    return ERR_OK;
+}
+
+/**
+ * @brief Faz a fila andar: escreve a próxima requisição ou abre a conexão.
+ */
+static void processar_fila(void) {
+    if (conexao.estado == CONEXAO_ABERTA) {
+        enviar_proxima_requisicao();
+    } else {
+        reconectar_se_necessario();
+    }
+}
+
+/**
+ * @brief Verifica periodicamente os prazos das requisições ativas.
+ *
+ * Executa como timer do lwIP enquanto houver contextos ocupados. Uma
+ * requisição vencida na fila falha com timeout; se ela já estava escrita na
+ * conexão, o PCB travado é abortado e recuperado. Um contexto concluído que
+ * continua preso esperando ACK muito depois do prazo é contado como
+ * vazamento e recuperado da mesma forma.
+ *
+ * @param arg Argumento do timer (não utilizado)
+ */
+static void verificar_prazos(void *arg) {
+    uint32_t agora_ms = to_ms_since_boot(get_absolute_time());
+    bool abortar_conexao = false;
+    bool ocupado = false;
+
+    for (int i = 0; i < HTTP_NUM_REQUISICOES; i++) {
+        RequisicaoHttp *req = &pool_requisicoes[i];
+        if (req->estado == REQUISICAO_LIVRE) {
+            continue;
+        }
+        int32_t atraso_ms = (int32_t)(agora_ms - req->prazo_ms);
+        if (req->estado == REQUISICAO_CONCLUIDA) {
+            if (atraso_ms >= HTTP_TOLERANCIA_VAZAMENTO_MS) {
+                printf("Requisição %lu presa aguardando ACK, recuperando contexto\n", (unsigned long)req->id);
+                estatisticas.vazamentos++;
+                abortar_conexao = true;
+            }
+        } else if (atraso_ms >= 0) {
+            printf("Requisição %lu expirou\n", (unsigned long)req->id);
+            estatisticas.expiradas++;
+            abortar_conexao |= (req->estado == REQUISICAO_ENVIADA);
+            finalizar_requisicao(req, false, 0);
+        }
+        ocupado |= (req->estado != REQUISICAO_LIVRE);
+    }
+
+    if (abortar_conexao && conexao.pcb) {
+        encerrar_conexao(conexao.pcb, true);
+        ocupado = (estatisticas.em_andamento > 0);
+    }
+
+    processar_fila();
+
+    verificacao_agendada = ocupado;
+    if (ocupado) {
+        sys_timeout(INTERVALO_VERIFICACAO_PRAZOS_MS, verificar_prazos, NULL);
+    }
+}
+
+/**
+ * @brief Callback de erro fatal da conexão.
+ *
+ * Chamado pelo lwIP quando a conexão é resetada ou abortada. Nesse ponto o
+ * PCB já foi liberado pelo lwIP e não pode mais ser usado.
+ *
+ * @param arg Argumento passado para o callback (não utilizado)
+ * @param err Código de erro
+ */
+static void callback_erro(void *arg, err_t err) {
+    printf("Conexão com o servidor perdida: %d\n", err);
+    encerrar_conexao(NULL, false);
+    reconectar_se_necessario();
+}
+
+/**
+ * @brief Callback chamado quando o servidor confirma (ACK) dados enviados.
+ *
+ * Os bytes confirmados são descontados das requisições na ordem em que foram
+ * escritas. Uma requisição totalmente confirmada registra o instante do ACK
+ * em EntregaHttp_t::confirmada_em_ms; se já estava concluída, volta ao pool.
+ * O espaço liberado no buffer de envio é usado em seguida pela fila.
+ *
+ * @param arg Argumento passado para o callback (não utilizado)
+ * @param pcb PCB da conexão TCP
+ * @param len Número de bytes confirmados
+ * @return ERR_OK, ou ERR_ABRT se a conexão precisou ser abortada
+ */
+static err_t callback_dados_enviados(void *arg, struct tcp_pcb *pcb, u16_t len) {
+    uint16_t restante = len;
+    while (restante > 0) {
+        RequisicaoHttp *mais_antiga = NULL;
+        for (int i = 0; i < HTTP_NUM_REQUISICOES; i++) {
+            RequisicaoHttp *req = &pool_requisicoes[i];
+            if (req->bytes_sem_ack > 0 && (!mais_antiga || req->id < mais_antiga->id)) {
+                mais_antiga = req;
+            }
+        }
+        if (!mais_antiga) {
+            break;
+        }
+        uint16_t confirmados = MIN(restante, mais_antiga->bytes_sem_ack);
+        mais_antiga->bytes_sem_ack -= confirmados;
+        restante -= confirmados;
+        if (mais_antiga->bytes_sem_ack == 0) {
+            mais_antiga->entrega.confirmada_em_ms = to_ms_since_boot(get_absolute_time());
+            histograma_latencia_registrar(&latencias.envio,
+                                          mais_antiga->entrega.confirmada_em_ms - mais_antiga->entrega.escrita_em_ms);
+            if (mais_antiga->estado == REQUISICAO_CONCLUIDA) {
+                liberar_requisicao(mais_antiga);
+            }
+        }
+    }
+    return enviar_proxima_requisicao();
+}
+
+/**
+ * @brief Entrega o status da resposta que acabou de ser lida à requisição em voo mais antiga.
+ *
+ * Cada resposta recebida também abre a janela em uma requisição, até
+ * HTTP_JANELA_PIPELINE.
+ */
+static void concluir_resposta(void) {
+    int status_http = conexao.leitor.status_http;
+    if (conexao.num_em_voo == 0) {
+        printf("Resposta %d sem requisição pendente, ignorada\n", status_http);
+        return;
+    }
+    RequisicaoHttp *req = conexao.em_voo[0];
+    if (conexao.janela < HTTP_JANELA_PIPELINE) {
+        conexao.janela++;
+    }
+    printf("Resposta %d para a requisição %lu\n", status_http, (unsigned long)req->id);
+    finalizar_requisicao(req, status_http >= 200 && status_http < 300, status_http);
+}
 
 /**
  * @brief Callback para receber a resposta do servidor.
- * 
- * Esta função é chamada automaticamente pelo lwIP quando dados são recebidos 
- * do servidor após o envio de uma requisição HTTP.
+ *
+ * Esta função é chamada automaticamente pelo lwIP quando dados são recebidos
+ * do servidor após o envio de uma requisição HTTP. A cadeia de pbufs é
+ * percorrida no próprio lugar pelo leitor incremental; cada resposta
+ * completa conclui a requisição em voo mais antiga e abre espaço na janela
+ * para a próxima da fila. Os bytes consumidos são confirmados com tcp_recved() para reabrir a
+ * janela de recepção.
+ *
+ * Quando o servidor fecha a conexão (p == NULL), pede Connection: close ou
+ * envia algo que não é uma resposta HTTP, o PCB é liberado e a conexão é
+ * reaberta se ainda houver requisições na fila.
  *
  * @param arg Argumento passado para o callback (não utilizado)
  * @param pcb PCB da conexão TCP
  * @param p Buffer de dados recebidos
  * @param err Código de erro
- * @return ERR_OK se tudo ocorrer bem, ou um código de erro
+ * @return ERR_OK se tudo ocorrer bem, ou ERR_ABRT se a conexão foi abortada
  */
 static err_t callback_resposta_recebida(void *arg, struct tcp_pcb *pcb, struct pbuf *p, err_t err) {
-    
+
     if (!p) {
+        // Um corpo sem tamanho declarado termina justamente com o fechamento
+        if (resposta_http_fim_da_conexao(&conexao.leitor)) {
+            concluir_resposta();
+        }
         printf("Conexão fechada pelo servidor.\n");
-        tcp_close(pcb);
-        return ERR_OK;
+        err_t resultado = encerrar_conexao(pcb, false);
+        reconectar_se_necessario();
+        return resultado;
     }
 
-    printf("Resposta do servidor:\n");
-    char *dados = (char *)malloc(p->tot_len + 1);
-    if (dados) {
-        pbuf_copy_partial(p, dados, p->tot_len, 0);
-        dados[p->tot_len] = '\0';
-        printf("%s\n", dados);
-        free(dados);
+    bool invalida = false;
+    bool fechar = false;
+    for (struct pbuf *q = p; q && !invalida; q = q->next) {
+        const uint8_t *dados = (const uint8_t *)q->payload;
+        uint16_t posicao = 0;
+        while (posicao < q->len) {
+            uint16_t consumidos = 0;
+            ResultadoRespostaHttp resultado = resposta_http_processar(&conexao.leitor, dados + posicao,
+                                                                      (uint16_t)(q->len - posicao), &consumidos);
+            posicao += consumidos;
+            if (resultado == RESPOSTA_HTTP_INVALIDA) {
+                invalida = true;
+                break;
+            }
+            if (resultado == RESPOSTA_HTTP_CONCLUIDA) {
+                fechar |= conexao.leitor.fechar_conexao;
+                concluir_resposta();
+                resposta_http_iniciar(&conexao.leitor);
+            }
+        }
     }
 
+    tcp_recved(pcb, p->tot_len);
     pbuf_free(p);
-    return ERR_OK;
+
+    if (invalida) {
+        printf("Resposta HTTP inválida, reabrindo a conexão\n");
+        if (conexao.num_em_voo > 0) {
+            finalizar_requisicao(conexao.em_voo[0], false, 0);
+        }
+        fechar = true;
+    }
+    if (fechar) {
+        err_t resultado = encerrar_conexao(pcb, invalida);
+        reconectar_se_necessario();
+        return resultado;
+    }
+    return enviar_proxima_requisicao();
 }
 
 /**
  * @brief Callback para quando a conexão TCP é estabelecida.
- * 
+ *
  * Esta função é chamada quando a conexão TCP com o servidor é estabelecida com sucesso.
- * É neste momento que a requisição HTTP POST é montada e enviada para o servidor.
- * 
- * @param arg Argumento passado para o callback (ButtonStates_t*)
+ * A conexão passa a ser reutilizada pelos envios seguintes e a requisição
+ * mais antiga da fila, se houver, é enviada imediatamente; as demais seguem
+ * conforme a janela de pipelining se abre.
+ *
+ * @param arg Argumento passado para o callback (não utilizado)
  * @param pcb PCB da conexão TCP
  * @param err Código de erro
- * @note É aqui que a requisição HTTP é enviada, após a conexão ser estabelecida.
- *      É necessário usar o PROXY_HOST no cabeçalho Host para funcionar corretamente.
  * @return ERR_OK se tudo ocorrer bem, ou um código de erro
  */
 static err_t callback_conectado(void *arg, struct tcp_pcb *pcb, err_t err) {
 
-    ButtonStates_t* estados_completos = (ButtonStates_t*)arg;
-
     if (err != ERR_OK) {
         printf("Erro ao conectar: %d\n", err);
-        tcp_abort(pcb);
-        return err;
+        encerrar_conexao(pcb, true);
+        return ERR_ABRT;
     }
 
-    tcp_recv(pcb, callback_resposta_recebida);
+    printf("Conexão keep-alive aberta com %s:%d\n", PROXY_HOST, PROXY_PORT);
+    histograma_latencia_registrar(&latencias.conexao, decorrido_ms(conexao.etapa_iniciada_em_ms));
+    conexao.estado = CONEXAO_ABERTA;
+    conexao.tentativas_reconexao = 0;
 
-    char corpo_json[192]; 
-    snprintf(corpo_json, sizeof(corpo_json),
-             "{\"button_a\": %d, \"button_b\": %d, \"temperature\": %.2f}",
-             estados_completos->button_a_pressed ? 1 : 0,
-             estados_completos->button_b_pressed ? 1 : 0,
-             estados_completos->temperature);
-    
-    char requisicao[512];
-    snprintf(requisicao, sizeof(requisicao),
-             "POST /dados HTTP/1.1\r\n"
-             "Host: %s\r\n"
-             "Content-Type: application/json\r\n"
-             "Content-Length: %d\r\n"
-             "Connection: close\r\n"
-             "\r\n"
-             "%s",
-             PROXY_HOST, strlen(corpo_json), corpo_json);
+    // Requisições pequenas e espaçadas: não vale esperar o ACK anterior (Nagle)
+    tcp_nagle_disable(pcb);
 
-    cyw43_arch_lwip_begin();
-    err_t erro_envio = tcp_write(pcb, requisicao, strlen(requisicao), TCP_WRITE_FLAG_COPY);
-    if (erro_envio == ERR_OK) {
-        tcp_output(pcb);
-        printf("Requisição enviada para %s:%d:\n%s\n", PROXY_HOST, PROXY_PORT, requisicao);
-    } else {
-        printf("Erro ao enviar dados: %d\n", erro_envio);
-        tcp_abort(pcb);
+    return enviar_proxima_requisicao();
+}
+
+/**
+ * @brief Abre a conexão TCP com o endereço já resolvido do proxy.
+ *
+ * @param ip_resolvido Endereço IP do proxy
+ */
+static void conectar_ao_proxy(const ip_addr_t *ip_resolvido) {
+    struct tcp_pcb *pcb = tcp_new_ip_type(IPADDR_TYPE_V4);
+    if (!pcb) {
+        printf("Erro ao criar pcb\n");
+        conexao.estado = CONEXAO_FECHADA;
+        return;
     }
-    cyw43_arch_lwip_end();
 
-    return ERR_OK;
+    conexao.pcb = pcb;
+    conexao.estado = CONEXAO_CONECTANDO;
+    conexao.janela = 1;
+    resposta_http_iniciar(&conexao.leitor);
+    tcp_arg(pcb, &conexao);
+    tcp_err(pcb, callback_erro);
+    tcp_recv(pcb, callback_resposta_recebida);
+    tcp_sent(pcb, callback_dados_enviados);
+
+    // Conectar à porta do PROXY
+    conexao.etapa_iniciada_em_ms = to_ms_since_boot(get_absolute_time());
+    err_t erro = tcp_connect(pcb, ip_resolvido, PROXY_PORT, callback_conectado);
+    if (erro != ERR_OK) {
+        printf("Erro ao conectar a %s:%d: %d\n", PROXY_HOST, PROXY_PORT, erro);
+        encerrar_conexao(pcb, true);
+    }
 }
 
 /**
  * @brief Callback para quando a resolução DNS é concluída.
- * 
+ *
  * Esta função é chamada quando o processo de resolução DNS para o nome do host é concluído.
  * Se for bem-sucedido, inicia a conexão TCP para o endereço IP resolvido.
- * 
+ *
  * @param nome_host Nome do host que foi resolvido
  * @param ip_resolvido Endereço IP resolvido
- * @param arg Argumento passado para o callback (ButtonStates_t*)
+ * @param arg Argumento passado para o callback (não utilizado)
  * @note Se a resolução falhar, imprime uma mensagem de erro. Em caso de sucesso,
  *       ele segue para tentar a conexão TCP.
  */
 static void callback_dns_resolvido(const char *nome_host, const ip_addr_t *ip_resolvido, void *arg) {
-    
-    ButtonStates_t* dados_recebidos = (ButtonStates_t*)arg;
 
     if (!ip_resolvido) {
         printf("Erro: DNS falhou para %s\n", nome_host);
+        conexao.estado = CONEXAO_FECHADA;
+        reconectar_se_necessario();
         return;
     }
 
     printf("DNS resolveu %s para %s\n", nome_host, ipaddr_ntoa(ip_resolvido));
+    histograma_latencia_registrar(&latencias.dns, decorrido_ms(conexao.etapa_iniciada_em_ms));
+    conectar_ao_proxy(ip_resolvido);
+}
 
-    struct tcp_pcb *pcb = tcp_new_ip_type(IPADDR_TYPE_V4);
-    if (!pcb) {
-        printf("Erro ao criar pcb\n");
-        return;
+/**
+ * @brief Obtém o endereço do proxy (via resolvedor_dns.h) e abre a conexão persistente.
+ */
+static void iniciar_conexao(void) {
+    ip_addr_t endereco_ip;
+
+    conexao.estado = CONEXAO_RESOLVENDO;
+    conexao.etapa_iniciada_em_ms = to_ms_since_boot(get_absolute_time());
+    // IP literal ou nome ainda válido no cache: conecta sem esperar o DNS
+    err_t resultado_dns = resolvedor_dns_obter(PROXY_HOST, &endereco_ip, callback_dns_resolvido, NULL);
+
+    if (resultado_dns == ERR_OK) {
+        histograma_latencia_registrar(&latencias.dns, 0);
+        conectar_ao_proxy(&endereco_ip);
+    } else if (resultado_dns == ERR_INPROGRESS) {
+        printf("Resolução DNS em andamento para %s...\n", PROXY_HOST);
+    } else {
+        printf("Erro ao iniciar DNS para %s: %d\n", PROXY_HOST, resultado_dns);
+        conexao.estado = CONEXAO_FECHADA;
     }
+}
 
-    tcp_arg(pcb, arg);
+/**
+ * @brief Procura um contexto livre no pool.
+ * @return Contexto livre, ou NULL se o pool está cheio
+ */
+static RequisicaoHttp *reservar_requisicao(void) {
+    for (int i = 0; i < HTTP_NUM_REQUISICOES; i++) {
+        if (pool_requisicoes[i].estado == REQUISICAO_LIVRE) {
+            return &pool_requisicoes[i];
+        }
+    }
+    estatisticas.rejeitadas++;
+    return NULL;
+}
 
-    // Conectar à porta do PROXY
-    err_t erro = tcp_connect(pcb, ip_resolvido, PROXY_PORT, callback_conectado);
-    if (erro != ERR_OK) {
-        printf("Erro ao conectar a %s:%d: %d\n", nome_host, PROXY_PORT, erro);
-        tcp_abort(pcb);
+/**
+ * @brief Coloca na fila um contexto cujo corpo já foi escrito no buffer.
+ *
+ * Escreve o Content-Length encostado à esquerda do corpo, registra prazo e
+ * callback e faz a fila andar.
+ *
+ * @param req Contexto reservado com reservar_requisicao()
+ * @param tamanho_corpo Tamanho do corpo escrito a partir de RESERVA_CONTENT_LENGTH
+ * @param timeout_ms Prazo para a conclusão, em ms
+ * @param callback Callback de conclusão (pode ser NULL)
+ * @param arg Argumento repassado ao callback
+ * @return Identificador da requisição
+ */
+static uint32_t submeter_requisicao(RequisicaoHttp *req, uint16_t tamanho_corpo, uint32_t timeout_ms,
+                                    CallbackRequisicaoHttp callback, void *arg) {
+    // Content-Length encostado à esquerda do corpo: "<n>\r\n\r\n"
+    char *corpo = req->buffer + RESERVA_CONTENT_LENGTH;
+    char *cursor = corpo;
+    *--cursor = '\n'; *--cursor = '\r'; *--cursor = '\n'; *--cursor = '\r';
+    uint16_t restante = tamanho_corpo;
+    do {
+        *--cursor = (char)('0' + restante % 10);
+        restante /= 10;
+    } while (restante > 0);
+
+    req->inicio = (uint16_t)(cursor - req->buffer);
+    req->tamanho = (uint16_t)(corpo + tamanho_corpo - cursor);
+    req->id = proximo_id++;
+    req->prazo_ms = to_ms_since_boot(get_absolute_time()) + timeout_ms;
+    req->tentativas = 0;
+    req->bytes_sem_ack = 0;
+    memset(&req->entrega, 0, sizeof(req->entrega));
+    req->entrega.enfileirada_em_ms = to_ms_since_boot(get_absolute_time());
+    req->callback = callback;
+    req->arg = arg;
+    req->estado = REQUISICAO_NA_FILA;
+    estatisticas.em_andamento++;
+
+    if (!verificacao_agendada) {
+        verificacao_agendada = true;
+        sys_timeout(INTERVALO_VERIFICACAO_PRAZOS_MS, verificar_prazos, NULL);
+    }
+
+    if (conexao.estado == CONEXAO_FECHADA) {
+        conexao.tentativas_reconexao = 0;
     }
+    processar_fila();
+    return req->id;
 }
 
 /**
- * @brief Envia os dados do ButtonStates_t para o servidor na nuvem.
- * 
- * Esta função inicia o processo de envio de dados para a nuvem.
- * Primeiro, ela tenta resolver o nome de domínio do servidor por DNS.
- * Dependendo do resultado, pode proceder diretamente com a conexão TCP
- * ou aguardar a resolução DNS assíncrona.
- * 
- * @param dados_a_enviar Ponteiro para a estrutura ButtonStates_t com os dados a enviar
- * @note Usar PROXY_HOST para resolução DNS. Assim que o DNS for resolvido, 
- *       a conexão TCP é estabelecida e os dados são enviados.
+ * @brief Monta a parte constante do cabeçalho HTTP e registra PROXY_HOST no resolvedor.
+ *
+ * Chamada uma única vez na inicialização; o resultado fica em memória
+ * estática e é reutilizado por todas as requisições sem cópia.
  */
-void enviar_dados_para_nuvem(const ButtonStates_t* dados_a_enviar) {
-    ip_addr_t endereco_ip;
-    // Usar PROXY_HOST para resolução DNS
-    err_t resultado_dns = dns_gethostbyname(PROXY_HOST, &endereco_ip, callback_dns_resolvido, (void*)dados_a_enviar);
+void http_client_init(void) {
+    int tamanho = snprintf(cabecalho_fixo, sizeof(cabecalho_fixo),
+                           "POST /dados HTTP/1.1\r\n"
+                           "Host: %s\r\n"
+                           "Content-Type: %s\r\n"
+                           "Connection: keep-alive\r\n"
+                           "Content-Length: ",
+                           PROXY_HOST, codec_telemetria_content_type());
+    tamanho_cabecalho_fixo = (uint16_t)MIN(tamanho, (int)sizeof(cabecalho_fixo) - 1);
 
-    if (resultado_dns == ERR_OK) {
-        // Se já resolvido (cache), conectar diretamente à porta do PROXY
-        printf("Host %s já resolvido para %s\n", PROXY_HOST, ipaddr_ntoa(&endereco_ip));
+    // Um IP literal é convertido aqui, uma única vez
+    resolvedor_dns_preparar(PROXY_HOST);
+    limitador_envio_init(&limitador_lotes, HTTP_LOTES_POR_MINUTO, HTTP_RAJADA_LOTES);
+    buffer_amostras_init(&amostras_devolvidas);
+}
 
-        struct tcp_pcb *pcb = tcp_new_ip_type(IPADDR_TYPE_V4);
-        if (!pcb) {
-            printf("Erro ao criar pcb (cache)\n");
-            return;
-        }
-        
-        tcp_arg(pcb, (void*)dados_a_enviar);
+/**
+ * @brief Enfileira uma requisição POST /dados com cópia do corpo.
+ *
+ * O corpo é copiado para um contexto do pool antes do retorno, então o
+ * ponteiro não precisa continuar válido depois da chamada.
+ *
+ * @param corpo Corpo da requisição
+ * @param tamanho Tamanho do corpo, em bytes (até HTTP_TAMANHO_MAX_CORPO)
+ * @param timeout_ms Prazo para a conclusão, em ms
+ * @param callback Callback de conclusão, chamado no contexto do lwIP (pode ser NULL)
+ * @param arg Argumento repassado ao callback
+ * @return Identificador da requisição, ou -1 se o corpo é grande demais ou o pool está cheio
+ */
+int32_t http_client_enviar_requisicao(const char *corpo, uint16_t tamanho, uint32_t timeout_ms,
+                                      CallbackRequisicaoHttp callback, void *arg) {
+    if (tamanho > HTTP_TAMANHO_MAX_CORPO) {
+        return -1;
+    }
 
-        // Conectar à porta do PROXY
-        err_t erro = tcp_connect(pcb, &endereco_ip, PROXY_PORT, callback_conectado);
-        if (erro != ERR_OK) {
-            printf("Erro ao conectar (cache) a %s:%d: %d\n", PROXY_HOST, PROXY_PORT, erro);
-            tcp_abort(pcb);
+    cyw43_arch_lwip_begin();
+    RequisicaoHttp *req = reservar_requisicao();
+    int32_t id = -1;
+    if (req) {
+        memcpy(req->buffer + RESERVA_CONTENT_LENGTH, corpo, tamanho);
+        id = (int32_t)submeter_requisicao(req, tamanho, timeout_ms, callback, arg);
+    }
+    cyw43_arch_lwip_end();
+    return id;
+}
+
+/**
+ * @brief Copia os contadores do motor de requisições.
+ *
+ * @param destino Estrutura que recebe a cópia dos contadores
+ */
+void http_client_obter_estatisticas(EstatisticasHttp_t *destino) {
+    cyw43_arch_lwip_begin();
+    *destino = estatisticas;
+    cyw43_arch_lwip_end();
+}
+
+/**
+ * @brief Retira uma amostra de um lote que não foi entregue.
+ */
+bool http_client_retirar_devolvida(Amostra_t *amostra) {
+    cyw43_arch_lwip_begin();
+    bool retirou = buffer_amostras_remover(&amostras_devolvidas, amostra);
+    cyw43_arch_lwip_end();
+    return retirou;
+}
+
+/**
+ * @brief Copia os histogramas de latência das etapas de entrega.
+ */
+void http_client_obter_latencias(LatenciasHttp_t *destino) {
+    cyw43_arch_lwip_begin();
+    *destino = latencias;
+    cyw43_arch_lwip_end();
+}
+
+/**
+ * @brief Imprime os histogramas de latência na saída padrão (USB/UART).
+ *
+ * Cada histograma é copiado sob a trava do lwIP e impresso fora dela, para
+ * não segurar a pilha de rede durante o printf.
+ */
+void http_client_imprimir_latencias(void) {
+    static const struct {
+        const char *nome;
+        size_t deslocamento;
+    } etapas[] = {
+        { "espera_buffer", offsetof(LatenciasHttp_t, espera_buffer) },
+        { "fila", offsetof(LatenciasHttp_t, fila) },
+        { "dns", offsetof(LatenciasHttp_t, dns) },
+        { "conexao", offsetof(LatenciasHttp_t, conexao) },
+        { "envio", offsetof(LatenciasHttp_t, envio) },
+        { "resposta", offsetof(LatenciasHttp_t, resposta) },
+    };
+    for (size_t i = 0; i < sizeof(etapas) / sizeof(etapas[0]); i++) {
+        HistogramaLatencia_t copia;
+        cyw43_arch_lwip_begin();
+        copia = *(const HistogramaLatencia_t *)((const uint8_t *)&latencias + etapas[i].deslocamento);
+        cyw43_arch_lwip_end();
+        histograma_latencia_imprimir(&copia, etapas[i].nome);
+    }
+
+    cyw43_arch_lwip_begin();
+    uint32_t devolvidas = estatisticas.amostras_devolvidas;
+    uint32_t perdidas = estatisticas.amostras_perdidas;
+    cyw43_arch_lwip_end();
+    printf("lotes_falhos: devolvidas=%lu perdidas=%lu\n", (unsigned long)devolvidas, (unsigned long)perdidas);
+}
+
+/**
+ * @brief Avalia se o motor de requisições está sobrecarregado.
+ *
+ * Há pressão quando resta no máximo um contexto livre no pool ou quando o
+ * buffer de envio da conexão aberta não comporta mais uma requisição do
+ * tamanho máximo.
+ *
+ * @return true se novos envios devem ser adiados ou agrupados
+ */
+static bool ha_pressao(void) {
+    if (estatisticas.em_andamento + 1 >= HTTP_NUM_REQUISICOES) {
+        return true;
+    }
+    if (conexao.estado == CONEXAO_ABERTA) {
+        uint32_t maximo = (uint32_t)tamanho_cabecalho_fixo + RESERVA_CONTENT_LENGTH + HTTP_TAMANHO_MAX_CORPO;
+        return tcp_sndbuf(conexao.pcb) < maximo;
+    }
+    return false;
+}
+
+/**
+ * @brief Informa se o motor de requisições está pedindo para os produtores desacelerarem.
+ */
+bool http_client_sob_pressao(void) {
+    cyw43_arch_lwip_begin();
+    bool pressao = ha_pressao();
+    cyw43_arch_lwip_end();
+    return pressao;
+}
+
+/**
+ * @brief Verifica se o buffer já justifica um envio.
+ *
+ * Um lote sai quando há HTTP_TAMANHO_LOTE amostras acumuladas ou quando a
+ * amostra mais antiga já esperou HTTP_PRAZO_LOTE_MS. Sob pressão (ver
+ * ha_pressao()) o prazo é ignorado e só lotes completos saem, o que reduz o
+ * número de requisições em vez de falhar o envio.
+ *
+ * @param buffer Buffer de amostras a ser avaliado
+ * @return true se o lote deve ser enviado agora
+ */
+static bool lote_pronto(const BufferAmostras_t *buffer) {
+    Amostra_t mais_antiga;
+    if (!buffer_amostras_espiar(buffer, &mais_antiga)) {
+        return false;
+    }
+    if (buffer_amostras_tamanho(buffer) >= HTTP_TAMANHO_LOTE) {
+        return true;
+    }
+    if (ha_pressao()) {
+        return false;
+    }
+    uint32_t tempo_atual_ms = to_ms_since_boot(get_absolute_time());
+    return tempo_atual_ms - mais_antiga.timestamp_ms >= HTTP_PRAZO_LOTE_MS;
+}
+
+/**
+ * @brief Callback de conclusão dos lotes de amostras.
+ *
+ * Um lote que falhou devolve suas amostras para serem gravadas de novo no
+ * log. O buffer de devolvidas comporta o pool inteiro; o que não couber é
+ * contado como perdido.
+ */
+static void callback_lote_concluido(uint32_t id, bool sucesso, int status_http,
+                                    const EntregaHttp_t *entrega, void *arg) {
+    if (sucesso) {
+        return;
+    }
+    const LoteEmEnvio *lote = (const LoteEmEnvio *)arg;
+    uint16_t devolvidas = 0;
+    for (uint16_t i = 0; i < lote->quantidade; i++) {
+        if (buffer_amostras_tamanho(&amostras_devolvidas) >= BUFFER_AMOSTRAS_CAPACIDADE) {
+            break;
         }
-    } else if (resultado_dns == ERR_INPROGRESS) {
-        printf("Resolução DNS em andamento para %s...\n", PROXY_HOST);
+        buffer_amostras_inserir(&amostras_devolvidas, &lote->amostras[i]);
+        devolvidas++;
+    }
+    estatisticas.amostras_devolvidas += devolvidas;
+    estatisticas.amostras_perdidas += lote->quantidade - devolvidas;
+    printf("Lote %lu não foi entregue (status %d), %u amostras voltam ao log\n",
+           (unsigned long)id, status_http, devolvidas);
+}
+
+/**
+ * @brief Informa se o limite de taxa está segurando o próximo lote.
+ */
+bool http_client_envio_limitado(void) {
+    cyw43_arch_lwip_begin();
+    bool limitado = !limitador_envio_disponivel(&limitador_lotes);
+    cyw43_arch_lwip_end();
+    return limitado;
+}
+
+/**
+ * @brief Calcula quanto falta para enviar_lote_para_nuvem() ter um lote para enviar.
+ */
+uint32_t http_client_ms_ate_proximo_lote(const BufferAmostras_t *buffer) {
+    Amostra_t mais_antiga;
+    if (!buffer_amostras_espiar(buffer, &mais_antiga)) {
+        return HTTP_SEM_PRAZO;
+    }
+
+    cyw43_arch_lwip_begin();
+    uint32_t espera_ms;
+    bool lote_completo = buffer_amostras_tamanho(buffer) >= HTTP_TAMANHO_LOTE;
+    if (estatisticas.em_andamento >= HTTP_NUM_REQUISICOES || (!lote_completo && ha_pressao())) {
+        // Só um contexto liberado muda a situação, e ele chega pelo aviso
+        espera_ms = HTTP_SEM_PRAZO;
     } else {
-        printf("Erro ao iniciar DNS para %s: %d\n", PROXY_HOST, resultado_dns);
+        uint32_t idade_ms = decorrido_ms(mais_antiga.timestamp_ms);
+        espera_ms = (lote_completo || idade_ms >= HTTP_PRAZO_LOTE_MS) ? 0 : HTTP_PRAZO_LOTE_MS - idade_ms;
+        uint32_t ficha_ms = limitador_envio_ms_ate_ficha(&limitador_lotes);
+        if (ficha_ms > espera_ms) {
+            espera_ms = ficha_ms;
+        }
     }
-}
\ No newline at end of file
+    cyw43_arch_lwip_end();
+    return espera_ms;
+}
+
+/**
+ * @brief Define a função chamada sempre que um contexto do pool é liberado.
+ */
+void http_client_definir_aviso(AvisoClienteHttp aviso) {
+    aviso_liberacao = aviso;
+}
+
+/**
+ * @brief Envia um lote de amostras do buffer para o servidor na nuvem.
+ *
+ * Quando o lote está pronto (ver HTTP_TAMANHO_LOTE e HTTP_PRAZO_LOTE_MS), o
+ * limitador tem uma ficha e há contexto livre no pool, retira até HTTP_TAMANHO_LOTE amostras do buffer e
+ * as codifica (JSON ou binário, ver codec_telemetria.h) direto no buffer do
+ * contexto, que é então enfileirado no motor de requisições.
+ *
+ * @param buffer Buffer de onde as amostras são retiradas
+ * @return Número de amostras retiradas do buffer para envio (0 se nada foi enviado)
+ * @note Com o pool cheio, as amostras permanecem no buffer e seguem no próximo lote.
+ */
+uint16_t enviar_lote_para_nuvem(BufferAmostras_t *buffer) {
+    uint16_t enviadas = 0;
+
+    cyw43_arch_lwip_begin();
+
+    if (!lote_pronto(buffer) || !limitador_envio_disponivel(&limitador_lotes)) {
+        cyw43_arch_lwip_end();
+        return 0;
+    }
+    RequisicaoHttp *req = reservar_requisicao();
+    if (!req) {
+        cyw43_arch_lwip_end();
+        return 0;
+    }
+
+    // Codifica o lote direto no buffer do contexto, depois da reserva do Content-Length,
+    // e guarda as amostras para devolvê-las se o lote falhar
+    LoteEmEnvio *copia = &lotes_em_envio[req - pool_requisicoes];
+    CodificadorLote_t lote;
+    codec_telemetria_iniciar_lote(&lote, (uint8_t *)req->buffer + RESERVA_CONTENT_LENGTH, HTTP_TAMANHO_MAX_CORPO);
+    Amostra_t amostra;
+    uint32_t agora_ms = to_ms_since_boot(get_absolute_time());
+    while (enviadas < HTTP_TAMANHO_LOTE && buffer_amostras_espiar(buffer, &amostra)) {
+        if (!codec_telemetria_adicionar(&lote, &amostra)) {
+            break; // Não cabe: a amostra fica para o próximo lote
+        }
+        buffer_amostras_remover(buffer, NULL);
+        histograma_latencia_registrar(&latencias.espera_buffer, agora_ms - amostra.timestamp_ms);
+        copia->amostras[enviadas++] = amostra;
+    }
+    copia->quantidade = enviadas;
+    if (enviadas > 0) {
+        uint16_t tamanho_corpo = (uint16_t)codec_telemetria_finalizar_lote(&lote);
+        submeter_requisicao(req, tamanho_corpo, HTTP_TIMEOUT_REQUISICAO_MS, callback_lote_concluido, copia);
+        limitador_envio_consumir(&limitador_lotes);
+    }
+
+    cyw43_arch_lwip_end();
+    return enviadas;
+}
@@ -0,0 +1,262 @@
+/**
+ * @file resposta_http.c
+ * @brief Implementação do leitor incremental de respostas HTTP/1.1
+ *
+ * As etapas de cabeçalho são lidas linha a linha no buffer fixo do leitor;
+ * as etapas de corpo apenas descontam bytes, sem olhar o conteúdo.
+ */
+
+#include <string.h>
+#include <strings.h>
+#include "resposta_http.h"
+
+/**
+ * @brief Verifica se a linha começa com o nome de campo informado (sem diferenciar maiúsculas).
+ * @param linha Linha do cabeçalho terminada em '\0'
+ * @param nome Nome do campo, incluindo o ':'
+ * @return Ponteiro para o valor do campo (sem espaços iniciais), ou NULL
+ */
+static const char *valor_do_campo(const char *linha, const char *nome) {
+    size_t tamanho_nome = strlen(nome);
+    if (strncasecmp(linha, nome, tamanho_nome) != 0) {
+        return NULL;
+    }
+    const char *valor = linha + tamanho_nome;
+    while (*valor == ' ' || *valor == '\t') {
+        valor++;
+    }
+    return valor;
+}
+
+/**
+ * @brief Verifica se o valor de um campo contém a palavra informada (sem diferenciar maiúsculas).
+ */
+static bool contem_palavra(const char *valor, const char *palavra) {
+    size_t tamanho_palavra = strlen(palavra);
+    for (; *valor; valor++) {
+        if (strncasecmp(valor, palavra, tamanho_palavra) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Interpreta a linha de status "HTTP/1.x NNN motivo".
+ * @return true se a linha é válida
+ */
+static bool ler_linha_status(LeitorRespostaHttp_t *leitor) {
+    const char *linha = leitor->linha;
+    if (strncmp(linha, "HTTP/1.", 7) != 0) {
+        return false;
+    }
+    const char *codigo = strchr(linha, ' ');
+    if (!codigo) {
+        return false;
+    }
+    codigo++;
+    int status = 0;
+    for (int i = 0; i < 3; i++) {
+        if (codigo[i] < '0' || codigo[i] > '9') {
+            return false;
+        }
+        status = status * 10 + (codigo[i] - '0');
+    }
+    leitor->status_http = status;
+    return true;
+}
+
+/**
+ * @brief Decide como o corpo é delimitado ao fim do cabeçalho.
+ */
+static void iniciar_corpo(LeitorRespostaHttp_t *leitor) {
+    int status = leitor->status_http;
+    if (status == 204 || status == 304) {
+        leitor->etapa = RESPOSTA_COMPLETA;
+    } else if (leitor->chunked) {
+        leitor->etapa = RESPOSTA_CHUNK_TAMANHO;
+    } else if (leitor->content_length == 0) {
+        leitor->etapa = RESPOSTA_COMPLETA;
+    } else if (leitor->content_length > 0) {
+        leitor->restante = (uint32_t)leitor->content_length;
+        leitor->etapa = RESPOSTA_CORPO;
+    } else {
+        // Sem tamanho declarado o corpo vai até o servidor fechar a conexão
+        leitor->fechar_conexao = true;
+        leitor->etapa = RESPOSTA_CORPO_ATE_FIM;
+    }
+}
+
+/**
+ * @brief Interpreta um campo do cabeçalho, ou o fim do cabeçalho (linha vazia).
+ * @return true se a linha é válida
+ */
+static bool ler_linha_cabecalho(LeitorRespostaHttp_t *leitor) {
+    const char *linha = leitor->linha;
+    if (linha[0] == '\0') {
+        if (leitor->status_http >= 100 && leitor->status_http < 200) {
+            // Resposta provisória (ex.: 100 Continue): a definitiva vem em seguida
+            resposta_http_iniciar(leitor);
+        } else {
+            iniciar_corpo(leitor);
+        }
+        return true;
+    }
+
+    const char *valor;
+    if ((valor = valor_do_campo(linha, "Content-Length:")) != NULL) {
+        int32_t tamanho = 0;
+        if (*valor < '0' || *valor > '9') {
+            return false;
+        }
+        for (; *valor >= '0' && *valor <= '9'; valor++) {
+            if (tamanho > (INT32_MAX - 9) / 10) {
+                return false;
+            }
+            tamanho = tamanho * 10 + (*valor - '0');
+        }
+        leitor->content_length = tamanho;
+    } else if ((valor = valor_do_campo(linha, "Transfer-Encoding:")) != NULL) {
+        leitor->chunked = contem_palavra(valor, "chunked");
+    } else if ((valor = valor_do_campo(linha, "Connection:")) != NULL) {
+        leitor->fechar_conexao = contem_palavra(valor, "close");
+    }
+    return true;
+}
+
+/**
+ * @brief Interpreta a linha com o tamanho (hexadecimal) de um chunk.
+ * @return true se a linha é válida
+ */
+static bool ler_tamanho_chunk(LeitorRespostaHttp_t *leitor) {
+    uint32_t tamanho = 0;
+    int digitos = 0;
+    for (const char *c = leitor->linha; *c && *c != ';' && *c != ' '; c++) {
+        int valor;
+        if (*c >= '0' && *c <= '9') {
+            valor = *c - '0';
+        } else if (*c >= 'a' && *c <= 'f') {
+            valor = *c - 'a' + 10;
+        } else if (*c >= 'A' && *c <= 'F') {
+            valor = *c - 'A' + 10;
+        } else {
+            return false;
+        }
+        if (++digitos > 7) {
+            return false; // Chunks acima de 256 MB não fazem sentido aqui
+        }
+        tamanho = (tamanho << 4) | (uint32_t)valor;
+    }
+    if (digitos == 0) {
+        return false;
+    }
+    if (tamanho == 0) {
+        leitor->etapa = RESPOSTA_CHUNK_TRAILER;
+    } else {
+        leitor->restante = tamanho;
+        leitor->etapa = RESPOSTA_CHUNK_DADOS;
+    }
+    return true;
+}
+
+/**
+ * @brief Interpreta uma linha completa conforme a etapa atual.
+ * @return true se a linha é válida
+ */
+static bool ler_linha(LeitorRespostaHttp_t *leitor) {
+    switch (leitor->etapa) {
+        case RESPOSTA_LINHA_STATUS:
+            if (!ler_linha_status(leitor)) {
+                return false;
+            }
+            leitor->etapa = RESPOSTA_CABECALHOS;
+            return true;
+        case RESPOSTA_CABECALHOS:
+            return ler_linha_cabecalho(leitor);
+        case RESPOSTA_CHUNK_TAMANHO:
+            return ler_tamanho_chunk(leitor);
+        case RESPOSTA_CHUNK_FIM:
+            leitor->etapa = RESPOSTA_CHUNK_TAMANHO;
+            return leitor->linha[0] == '\0';
+        case RESPOSTA_CHUNK_TRAILER:
+            if (leitor->linha[0] == '\0') {
+                leitor->etapa = RESPOSTA_COMPLETA;
+            }
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Prepara o leitor para uma nova resposta.
+ */
+void resposta_http_iniciar(LeitorRespostaHttp_t *leitor) {
+    leitor->etapa = RESPOSTA_LINHA_STATUS;
+    leitor->status_http = 0;
+    leitor->content_length = -1;
+    leitor->chunked = false;
+    leitor->fechar_conexao = false;
+    leitor->restante = 0;
+    leitor->tamanho_linha = 0;
+}
+
+/**
+ * @brief Consome um pedaço da resposta.
+ */
+ResultadoRespostaHttp resposta_http_processar(LeitorRespostaHttp_t *leitor, const uint8_t *dados,
+                                              uint16_t tamanho, uint16_t *consumidos) {
+    uint16_t i = 0;
+    while (i < tamanho && leitor->etapa != RESPOSTA_COMPLETA) {
+        switch (leitor->etapa) {
+            case RESPOSTA_CORPO:
+            case RESPOSTA_CHUNK_DADOS: {
+                // Descarta o corpo em bloco, sem olhar os bytes
+                uint32_t disponivel = (uint32_t)(tamanho - i);
+                uint32_t descartar = (leitor->restante < disponivel) ? leitor->restante : disponivel;
+                leitor->restante -= descartar;
+                i += (uint16_t)descartar;
+                if (leitor->restante == 0) {
+                    leitor->etapa = (leitor->etapa == RESPOSTA_CORPO) ? RESPOSTA_COMPLETA : RESPOSTA_CHUNK_FIM;
+                }
+                break;
+            }
+            case RESPOSTA_CORPO_ATE_FIM:
+                i = tamanho;
+                break;
+            default: {
+                char c = (char)dados[i++];
+                if (c != '\n') {
+                    if (leitor->tamanho_linha < RESPOSTA_HTTP_TAMANHO_LINHA - 1) {
+                        leitor->linha[leitor->tamanho_linha++] = c;
+                    }
+                    break;
+                }
+                if (leitor->tamanho_linha > 0 && leitor->linha[leitor->tamanho_linha - 1] == '\r') {
+                    leitor->tamanho_linha--;
+                }
+                leitor->linha[leitor->tamanho_linha] = '\0';
+                leitor->tamanho_linha = 0;
+                if (!ler_linha(leitor)) {
+                    *consumidos = i;
+                    return RESPOSTA_HTTP_INVALIDA;
+                }
+                break;
+            }
+        }
+    }
+
+    *consumidos = i;
+    return (leitor->etapa == RESPOSTA_COMPLETA) ? RESPOSTA_HTTP_CONCLUIDA : RESPOSTA_HTTP_INCOMPLETA;
+}
+
+/**
+ * @brief Informa que o servidor fechou a conexão.
+ */
+bool resposta_http_fim_da_conexao(LeitorRespostaHttp_t *leitor) {
+    if (leitor->etapa == RESPOSTA_CORPO_ATE_FIM) {
+        leitor->etapa = RESPOSTA_COMPLETA;
+        return true;
+    }
+    return leitor->etapa == RESPOSTA_COMPLETA;
+}
@@ -0,0 +1,64 @@
+/**
+ * @file limitador_envio.c
+ * @brief Implementação do limitador de taxa de envios (token bucket)
+ *
+ * O limitador não tem proteção contra acesso concorrente: cada instância é
+ * usada por um único módulo, dentro do seu próprio travamento.
+ */
+
+#include "pico/stdlib.h"
+#include "limitador_envio.h"
+
+/** @brief Frações que compõem uma ficha inteira (ms em um minuto) */
+#define FRACOES_POR_FICHA 60000u
+
+/**
+ * @brief Inicializa o limitador com a rajada completa.
+ */
+void limitador_envio_init(LimitadorEnvio_t *limitador, uint32_t envios_por_minuto, uint16_t rajada) {
+    limitador->envios_por_minuto = envios_por_minuto;
+    limitador->capacidade = (uint32_t)rajada * FRACOES_POR_FICHA;
+    limitador->fracoes = limitador->capacidade;
+    limitador->atualizado_em_ms = to_ms_since_boot(get_absolute_time());
+}
+
+/**
+ * @brief Repõe as fichas e informa se um envio é permitido agora.
+ */
+bool limitador_envio_disponivel(LimitadorEnvio_t *limitador) {
+    uint32_t agora_ms = to_ms_since_boot(get_absolute_time());
+    uint32_t decorrido_ms = agora_ms - limitador->atualizado_em_ms;
+    limitador->atualizado_em_ms = agora_ms;
+
+    // Compara antes de multiplicar: um intervalo longo estouraria 32 bits
+    uint32_t faltam = limitador->capacidade - limitador->fracoes;
+    if (decorrido_ms >= faltam / limitador->envios_por_minuto + 1) {
+        limitador->fracoes = limitador->capacidade;
+    } else {
+        limitador->fracoes += decorrido_ms * limitador->envios_por_minuto;
+        if (limitador->fracoes > limitador->capacidade) {
+            limitador->fracoes = limitador->capacidade;
+        }
+    }
+    return limitador->fracoes >= FRACOES_POR_FICHA;
+}
+
+/**
+ * @brief Consome a ficha de um envio realizado.
+ */
+void limitador_envio_consumir(LimitadorEnvio_t *limitador) {
+    if (limitador->fracoes >= FRACOES_POR_FICHA) {
+        limitador->fracoes -= FRACOES_POR_FICHA;
+    }
+}
+
+/**
+ * @brief Calcula quanto falta para a próxima ficha inteira.
+ */
+uint32_t limitador_envio_ms_ate_ficha(LimitadorEnvio_t *limitador) {
+    if (limitador_envio_disponivel(limitador)) {
+        return 0;
+    }
+    uint32_t faltam = FRACOES_POR_FICHA - limitador->fracoes;
+    return (faltam + limitador->envios_por_minuto - 1) / limitador->envios_por_minuto;
+}
@@ -0,0 +1,180 @@
+/**
+ * @file log_flash.h
+ * @brief Interface do log de amostras em flash para períodos sem Wi-Fi
+ *
+ * Enquanto o Wi-Fi está fora, as amostras são gravadas em um log circular
+ * somente-acréscimo na região livre do fim da flash QSPI; depois da
+ * reconexão elas são repostas no buffer de envio em pequenas levas, sem
+ * tomar o lugar das amostras ao vivo.
+ *
+ * A gravação é feita por páginas de LOG_FLASH_TAMANHO_PAGINA bytes: as
+ * amostras se acumulam em uma página na RAM e só vão para a flash quando
+ * ela enche. Os setores são reutilizados em ordem circular, de modo que
+ * todos são apagados o mesmo número de vezes (nivelamento de desgaste).
+ *
+ * O acesso à flash passa por MemoriaFlash_t e o instante atual chega como
+ * parâmetro, o que permite trocar a flash real por uma memória na RAM e
+ * testar o log no computador (ver ferramentas/teste_log_flash.c).
+ */
+
+#ifndef LOG_FLASH_H
+#define LOG_FLASH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "buffer_amostras.h"
+
+/**
+ * @defgroup LOG_FLASH Log de Amostras em Flash
+ * @{
+ */
+
+/**
+ * @brief Tamanho, em bytes, da região da flash reservada ao log
+ *
+ * A região fica no fim da flash; o firmware precisa caber antes dela.
+ */
+#define LOG_FLASH_TAMANHO_REGIAO (256 * 1024)
+
+/**
+ * @brief Unidade mínima de programação da flash, em bytes
+ */
+#define LOG_FLASH_TAMANHO_PAGINA 256
+
+/**
+ * @brief Unidade mínima de apagamento da flash, em bytes
+ */
+#define LOG_FLASH_TAMANHO_SETOR 4096
+
+/**
+ * @brief Tamanho, em bytes, do cabeçalho de cada página do log
+ */
+#define LOG_FLASH_TAMANHO_CABECALHO 16
+
+/**
+ * @brief Número de amostras guardadas em cada página
+ */
+#define LOG_FLASH_AMOSTRAS_POR_PAGINA ((uint16_t)((LOG_FLASH_TAMANHO_PAGINA - LOG_FLASH_TAMANHO_CABECALHO) / sizeof(Amostra_t)))
+
+/**
+ * @brief Intervalo mínimo, em ms, entre duas reposições de página
+ *
+ * Limita a vazão da reposição para que as amostras antigas não ocupem todos
+ * os lotes enquanto chegam amostras novas.
+ */
+#define LOG_FLASH_INTERVALO_REPOSICAO_MS 250
+
+/**
+ * @brief Operações de acesso à memória que guarda o log
+ *
+ * Os endereços são relativos ao início da região do log. A memória deve se
+ * comportar como uma flash NOR: o apagamento deixa todos os bytes em 0xFF
+ * e a programação só consegue levar bits de 1 para 0.
+ */
+typedef struct {
+    uint32_t tamanho_regiao; /**< Tamanho da região, múltiplo de LOG_FLASH_TAMANHO_SETOR */
+
+    /**
+     * @brief Copia bytes da memória.
+     * @param endereco Endereço relativo de início
+     * @param destino Buffer de destino
+     * @param tamanho Número de bytes
+     */
+    void (*ler)(uint32_t endereco, void *destino, size_t tamanho);
+
+    /**
+     * @brief Apaga um setor inteiro.
+     * @param endereco Endereço relativo do setor (alinhado a LOG_FLASH_TAMANHO_SETOR)
+     * @return true se o setor foi apagado
+     */
+    bool (*apagar_setor)(uint32_t endereco);
+
+    /**
+     * @brief Programa uma página inteira.
+     * @param endereco Endereço relativo da página (alinhado a LOG_FLASH_TAMANHO_PAGINA)
+     * @param dados LOG_FLASH_TAMANHO_PAGINA bytes a programar
+     * @return true se a página foi programada
+     */
+    bool (*programar_pagina)(uint32_t endereco, const uint8_t *dados);
+} MemoriaFlash_t;
+
+/**
+ * @brief Estado do log
+ */
+typedef struct {
+    const MemoriaFlash_t *memoria;  /**< Memória que guarda o log */
+    uint32_t num_paginas;           /**< Páginas na região do log */
+    uint32_t pagina_escrita;        /**< Próxima página a ser programada */
+    uint32_t pagina_leitura;        /**< Página pendente mais antiga */
+    uint32_t paginas_pendentes;     /**< Páginas gravadas e ainda não repostas */
+    uint32_t proxima_sequencia;     /**< Número de sequência da próxima página */
+    uint32_t ultima_reposicao_ms;   /**< Instante da última reposição */
+    uint16_t quantidade_ram;        /**< Amostras na página em montagem */
+    uint8_t pagina_ram[LOG_FLASH_TAMANHO_PAGINA]; /**< Página em montagem */
+    uint8_t pagina_aux[LOG_FLASH_TAMANHO_PAGINA]; /**< Página lida durante a reposição */
+    uint32_t gravadas;              /**< Amostras gravadas no log */
+    uint32_t repostas;              /**< Amostras devolvidas ao buffer de envio */
+    uint32_t perdidas;              /**< Amostras perdidas (log cheio ou página corrompida) */
+} LogFlash_t;
+
+/**
+ * @brief Retorna a memória da flash QSPI do Pico.
+ *
+ * As operações de escrita usam flash_safe_execute(), que suspende o outro
+ * núcleo e as interrupções durante o apagamento e a programação.
+ *
+ * @return Memória que acessa os últimos LOG_FLASH_TAMANHO_REGIAO bytes da flash
+ */
+const MemoriaFlash_t *memoria_flash_pico(void);
+
+/**
+ * @brief Monta o log a partir do conteúdo atual da memória.
+ *
+ * Varre os cabeçalhos das páginas para encontrar o fim do log e a página
+ * pendente mais antiga, de modo que amostras gravadas antes de um
+ * reinício também são repostas.
+ *
+ * @param log Estado do log
+ * @param memoria Memória que guarda o log
+ */
+void log_flash_init(LogFlash_t *log, const MemoriaFlash_t *memoria);
+
+/**
+ * @brief Acrescenta uma amostra ao log.
+ *
+ * Quando a página em montagem enche ela é programada na flash. Com o log
+ * cheio, o setor mais antigo é apagado e suas amostras pendentes se perdem.
+ *
+ * @param log Estado do log
+ * @param amostra Amostra a ser gravada
+ */
+void log_flash_gravar(LogFlash_t *log, const Amostra_t *amostra);
+
+/**
+ * @brief Devolve ao buffer de envio uma leva de amostras do log.
+ *
+ * No máximo uma página é reposta a cada LOG_FLASH_INTERVALO_REPOSICAO_MS,
+ * e só quando o buffer tem espaço para ela sem sobrescrever nenhuma
+ * amostra. As páginas da flash saem primeiro, depois a página em montagem.
+ *
+ * A página da flash só é marcada como reposta aqui; se o envio das suas
+ * amostras falhar depois, cabe ao chamador gravá-las de novo no log.
+ *
+ * @param log Estado do log
+ * @param buffer Buffer de envio
+ * @param agora_ms Instante atual, em ms desde o boot
+ * @return Número de amostras repostas
+ */
+uint16_t log_flash_repor(LogFlash_t *log, BufferAmostras_t *buffer, uint32_t agora_ms);
+
+/**
+ * @brief Indica se há amostras no log aguardando reposição.
+ * @param log Estado do log
+ * @return true se há amostras pendentes
+ */
+bool log_flash_tem_pendentes(const LogFlash_t *log);
+
+/** @} */ // Fim do grupo LOG_FLASH
+
+#endif // LOG_FLASH_H
@@ -0,0 +1,106 @@
+/**
+ * @file relatorio_consumo.c
+ * @brief Implementação do relatório de despertares e de tempo dormindo
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+#include "relatorio_consumo.h"
+
+/** @brief Nomes dos motivos, na ordem de MotivoDespertar_t */
+static const char *const NOMES_MOTIVOS[DESPERTAR_NUM_MOTIVOS] = {
+    "botao", "temperatura", "amostra", "rede", "prazo"
+};
+
+/** @brief Despertares de task desde o boot, por motivo; cada um só é escrito pela task que o conta */
+static volatile uint32_t despertares_task[DESPERTAR_NUM_MOTIVOS];
+
+/** @brief Saídas do sono da CPU desde o boot */
+static volatile uint32_t despertares_cpu = 0;
+
+/** @brief Tempo dormindo desde o boot, em µs */
+static volatile uint64_t dormindo_us = 0;
+
+/** @brief Despertares de task no relatório anterior; só o relatório escreve aqui */
+static uint32_t despertares_task_anterior[DESPERTAR_NUM_MOTIVOS];
+
+#if configUSE_TICKLESS_IDLE
+/** @brief Saídas do sono no relatório anterior */
+static uint32_t despertares_cpu_anterior = 0;
+
+/** @brief Tempo dormindo no relatório anterior, em µs */
+static uint64_t dormindo_us_anterior = 0;
+#endif
+
+/** @brief Instante da última entrada no sono */
+static uint64_t inicio_sono_us;
+
+/** @brief Início da janela atual */
+static uint64_t inicio_janela_us = 0;
+
+/**
+ * @brief Marca a entrada no sono.
+ */
+void relatorio_consumo_antes_de_dormir(void) {
+    inicio_sono_us = time_us_64();
+}
+
+/**
+ * @brief Conta um despertar da CPU e o tempo dormido.
+ */
+void relatorio_consumo_depois_de_dormir(void) {
+    dormindo_us += time_us_64() - inicio_sono_us;
+    despertares_cpu++;
+}
+
+/**
+ * @brief Conta um despertar de task.
+ */
+void relatorio_consumo_contar(MotivoDespertar_t motivo) {
+    if (motivo < DESPERTAR_NUM_MOTIVOS) {
+        despertares_task[motivo]++;
+    }
+}
+
+/**
+ * @brief Imprime a janela atual em despertares por segundo e começa outra.
+ *
+ * Os contadores nunca são zerados aqui: a janela é a diferença para os
+ * valores do relatório anterior, e assim só quem conta escreve em cada
+ * contador. As taxas saem em centésimos, sem ponto flutuante.
+ */
+void relatorio_consumo_imprimir(void) {
+    uint64_t agora_us = time_us_64();
+    uint64_t janela_us = agora_us - inicio_janela_us;
+    if (janela_us == 0) {
+        return;
+    }
+
+    printf("Consumo: janela de %lu s |", (unsigned long)(janela_us / 1000000));
+    for (int motivo = 0; motivo < DESPERTAR_NUM_MOTIVOS; motivo++) {
+        uint32_t total = despertares_task[motivo];
+        uint32_t centesimos = (uint32_t)((total - despertares_task_anterior[motivo]) * 100000000ull / janela_us);
+        printf(" %s=%lu.%02lu/s", NOMES_MOTIVOS[motivo],
+               (unsigned long)(centesimos / 100), (unsigned long)(centesimos % 100));
+        despertares_task_anterior[motivo] = total;
+    }
+
+#if configUSE_TICKLESS_IDLE
+    // Tickless roda em um núcleo só: a ociosa, que escreve estes dois, não interrompe esta leitura
+    uint32_t total_cpu = despertares_cpu;
+    uint64_t total_dormindo_us = dormindo_us;
+    uint32_t centesimos_cpu = (uint32_t)((total_cpu - despertares_cpu_anterior) * 100000000ull / janela_us);
+    uint32_t permil_dormindo = (uint32_t)((total_dormindo_us - dormindo_us_anterior) * 1000 / janela_us);
+    despertares_cpu_anterior = total_cpu;
+    dormindo_us_anterior = total_dormindo_us;
+    printf(" | CPU: %lu.%02lu despertares/s, %lu.%lu%% dormindo\n",
+           (unsigned long)(centesimos_cpu / 100), (unsigned long)(centesimos_cpu % 100),
+           (unsigned long)(permil_dormindo / 10), (unsigned long)(permil_dormindo % 10));
+#else
+    // Sem tickless a ociosa gira sem dormir e o tick acorda a CPU sempre
+    printf(" | CPU: %lu despertares/s do tick, sem sono (tickless desligado)\n",
+           (unsigned long)configTICK_RATE_HZ);
+#endif
+    inicio_janela_us = agora_us;
+}
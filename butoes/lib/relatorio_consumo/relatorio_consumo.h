@@ -0,0 +1,67 @@
+/**
+ * @file relatorio_consumo.h
+ * @brief Interface do relatório de despertares e de tempo dormindo
+ *
+ * Conta quantas vezes a CPU sai do sono e quanto tempo passa dormindo (no
+ * modo tickless, pelos ganchos configPRE_SLEEP_PROCESSING e
+ * configPOST_SLEEP_PROCESSING do FreeRTOS) e quantas vezes cada task acorda,
+ * separadas pelo motivo. O relatório periódico mostra esses números por
+ * segundo, para comparar o modo normal com o de baixo consumo; a corrente
+ * em si precisa ser medida na alimentação da placa (ver README).
+ */
+
+#ifndef RELATORIO_CONSUMO_H
+#define RELATORIO_CONSUMO_H
+
+#include <stdint.h>
+
+/**
+ * @defgroup RELATORIO_CONSUMO Relatório de Consumo
+ * @{
+ */
+
+/**
+ * @brief Motivo de uma task ter acordado
+ */
+typedef enum {
+    DESPERTAR_BOTAO,       /**< Evento do amostrador de botões */
+    DESPERTAR_TEMPERATURA, /**< Nova medida de temperatura */
+    DESPERTAR_AMOSTRA,     /**< Amostra chegando no anel da task de Wi-Fi */
+    DESPERTAR_REDE,        /**< Contexto do cliente HTTP liberado */
+    DESPERTAR_PRAZO,       /**< Fim de um prazo calculado (lote, reconexão, relatório) */
+    DESPERTAR_NUM_MOTIVOS
+} MotivoDespertar_t;
+
+/**
+ * @brief Marca a entrada no sono (gancho configPRE_SLEEP_PROCESSING).
+ *
+ * Chamada pela task ociosa com o escalonador suspenso; não pode bloquear.
+ */
+void relatorio_consumo_antes_de_dormir(void);
+
+/**
+ * @brief Conta um despertar da CPU e o tempo dormido (gancho configPOST_SLEEP_PROCESSING).
+ */
+void relatorio_consumo_depois_de_dormir(void);
+
+/**
+ * @brief Conta um despertar de task.
+ *
+ * Cada motivo deve ser contado por uma única task, já que os contadores
+ * não têm proteção contra acesso concorrente.
+ *
+ * @param motivo Motivo do despertar
+ */
+void relatorio_consumo_contar(MotivoDespertar_t motivo);
+
+/**
+ * @brief Imprime os despertares por segundo e a fração do tempo dormindo
+ *        desde o relatório anterior.
+ *
+ * Só lê os contadores; a janela seguinte começa dos valores lidos.
+ */
+void relatorio_consumo_imprimir(void);
+
+/** @} */ // Fim do grupo RELATORIO_CONSUMO
+
+#endif // RELATORIO_CONSUMO_H
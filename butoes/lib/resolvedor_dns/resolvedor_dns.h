@@ -0,0 +1,95 @@
+/**
+ * @file resolvedor_dns.h
+ * @brief Interface da camada de resolução de nomes com cache
+ *
+ * Fica entre os clientes de rede e o DNS do lwIP. Endereços IP literais
+ * são convertidos uma única vez, sem passar pelo DNS; nomes resolvidos
+ * ficam em cache por RESOLVEDOR_DNS_TTL_MS e são renovados em segundo
+ * plano antes de expirar, enquanto o endereço antigo continua sendo
+ * entregue. Pedidos simultâneos para o mesmo nome geram uma única consulta.
+ *
+ * Todas as funções devem ser chamadas no contexto do lwIP (dentro de
+ * cyw43_arch_lwip_begin()/end() ou de um callback do lwIP).
+ */
+
+#ifndef RESOLVEDOR_DNS_H
+#define RESOLVEDOR_DNS_H
+
+#include <stdbool.h>
+#include "lwip/err.h"
+#include "lwip/ip_addr.h"
+
+/**
+ * @defgroup RESOLVEDOR_DNS Resolvedor DNS com Cache
+ * @{
+ */
+
+/**
+ * @brief Número de nomes mantidos no cache
+ */
+#define RESOLVEDOR_DNS_NUM_ENTRADAS 4
+
+/**
+ * @brief Tamanho máximo de um nome no cache, incluindo o terminador
+ */
+#define RESOLVEDOR_DNS_TAMANHO_NOME 64
+
+/**
+ * @brief Número máximo de pedidos aguardando a mesma consulta
+ */
+#define RESOLVEDOR_DNS_MAX_ESPERA 4
+
+/**
+ * @brief Validade, em ms, de um nome resolvido
+ *
+ * O DNS do lwIP não informa o TTL do registro a quem pede a resolução, por
+ * isso a validade é fixa; o cache interno do lwIP, que respeita o TTL
+ * real, ainda atende as renovações sem ir à rede enquanto for válido.
+ */
+#define RESOLVEDOR_DNS_TTL_MS (5 * 60 * 1000)
+
+/**
+ * @brief Fração da validade (em %) após a qual a renovação em segundo plano começa
+ */
+#define RESOLVEDOR_DNS_RENOVACAO_PERCENTUAL 75
+
+/**
+ * @brief Período, em ms, da verificação das entradas a renovar
+ */
+#define RESOLVEDOR_DNS_INTERVALO_VERIFICACAO_MS 10000
+
+/**
+ * @brief Callback de conclusão de uma resolução assíncrona
+ *
+ * @param nome Nome pedido
+ * @param endereco Endereço resolvido, ou NULL se a resolução falhou
+ * @param arg Argumento informado no pedido
+ */
+typedef void (*CallbackResolucaoDns)(const char *nome, const ip_addr_t *endereco, void *arg);
+
+/**
+ * @brief Registra um nome no cache sem esperar pela resolução
+ *
+ * Um IP literal é convertido na hora e nunca expira; um nome só é
+ * consultado no primeiro resolvedor_dns_obter().
+ *
+ * @param nome Nome ou IP literal
+ * @return true se o nome tem entrada no cache, false se o cache está cheio
+ */
+bool resolvedor_dns_preparar(const char *nome);
+
+/**
+ * @brief Obtém o endereço de um nome
+ *
+ * @param nome Nome ou IP literal
+ * @param endereco Recebe o endereço quando o retorno é ERR_OK
+ * @param callback Chamado quando a consulta terminar, se o retorno for ERR_INPROGRESS
+ * @param arg Argumento repassado ao callback
+ * @return ERR_OK se o endereço já estava disponível, ERR_INPROGRESS se uma
+ *         consulta está em andamento, ou outro código de erro
+ */
+err_t resolvedor_dns_obter(const char *nome, ip_addr_t *endereco, CallbackResolucaoDns callback, void *arg);
+
+/** @} */ // Fim do grupo RESOLVEDOR_DNS
+
+#endif // RESOLVEDOR_DNS_H
@@ -4,46 +4,195 @@
  *
  * Este arquivo implementa as funções para inicialização e leitura
  * do sensor de temperatura interno do Raspberry Pi Pico.
+ *
+ * O driver não toca no ADC: registra o canal 4 no serviço de ADC, que a
+ * cada SENSOR_TEMP_PERIODO_SAIDA_MS publica a soma e a soma dos quadrados
+ * de uma rajada de conversões. A média da rajada é a saída do decimador e a
+ * soma dos quadrados dá a variância, sem guardar as conversões.
  */
 
+#include <stdio.h>
 #include "sensor_temp.h"
-#include "hardware/adc.h" 
+#include "servico_adc.h"
+#include "hardware/clocks.h"
+
+/** @brief Volts por unidade do ADC de 12 bits */
+#define VOLTS_POR_LSB (3.3 / 4095.0)
+
+/** @brief Tensão do sensor interno a TEMPERATURA_REFERENCIA_C, em V */
+#define TENSAO_REFERENCIA_V 0.706
+
+/** @brief Inclinação do sensor interno, em V/°C */
+#define INCLINACAO_SENSOR_V_POR_C 0.001721
+
+/** @brief Temperatura correspondente a TENSAO_REFERENCIA_V na fórmula de calibração, em °C */
+#define TEMPERATURA_REFERENCIA_C 21.0
+
+_Static_assert(SENSOR_TEMP_PERIODO_SAIDA_MS >= 1 && SENSOR_TEMP_PERIODO_SAIDA_MS <= SERVICO_ADC_PERIODO_MAXIMO_MS,
+               "SENSOR_TEMP_PERIODO_SAIDA_MS fora da faixa aceita pelo serviço de ADC");
+
+/** @brief Conversões somadas em cada medida */
+#if SENSOR_TEMP_MODO == SENSOR_TEMP_MODO_SOBREAMOSTRADO
+#define CONVERSOES_POR_MEDIDA SENSOR_TEMP_SOBREAMOSTRAGEM
+#else
+#define CONVERSOES_POR_MEDIDA 1
+#endif
 
 /**
- * @brief Inicializa o ADC para leitura do sensor de temperatura interno.
+ * @brief Coeficientes da conversão linear em ponto fixo (Q24)
  *
- * Esta função inicializa o módulo ADC do RP2040 e habilita o sensor 
- * de temperatura interno para permitir as leituras de temperatura.
+ * T_centi = OFFSET - soma * COEFICIENTE, com a divisão pelo número de
+ * conversões já embutida no coeficiente. As expressões em double são
+ * constantes de compilação; em tempo de execução só há uma multiplicação
+ * de 64 bits e um deslocamento.
+ * @{
+ */
+#define COEFICIENTE_Q24 ((int64_t)(VOLTS_POR_LSB / INCLINACAO_SENSOR_V_POR_C * 100.0 * 16777216.0 / CONVERSOES_POR_MEDIDA + 0.5))
+#define OFFSET_Q24 ((int64_t)((TEMPERATURA_REFERENCIA_C + TENSAO_REFERENCIA_V / INCLINACAO_SENSOR_V_POR_C) * 100.0 * 16777216.0 + 0.5))
+/** @} */
+
+/**
+ * @brief Ganho ao quadrado, em (centésimos de °C por LSB)² / conversões², em Q24
+ *
+ * Converte N²·variância (em LSB²), que é o que a soma e a soma dos
+ * quadrados fornecem sem divisão, para variância em (centésimos de °C)².
+ */
+#define GANHO_VARIANCIA_Q24 ((int64_t)((VOLTS_POR_LSB / INCLINACAO_SENSOR_V_POR_C * 100.0) * \
+                                       (VOLTS_POR_LSB / INCLINACAO_SENSOR_V_POR_C * 100.0) * 16777216.0 / \
+                                       ((double)CONVERSOES_POR_MEDIDA * CONVERSOES_POR_MEDIDA) + 0.5))
+
+/** @brief Última medida convertida */
+static MedidaTemperatura_t ultima_medida;
+
+/** @brief Sequência da publicação do serviço que gerou ultima_medida (0 = nenhuma) */
+static uint32_t sequencia_convertida = 0;
+
+/** @brief Chamada a cada publicação do canal de temperatura */
+static AvisoMedidaTemperatura_t aviso_medida = NULL;
+
+/**
+ * @brief Converte a soma de CONVERSOES_POR_MEDIDA leituras do ADC em centésimos de grau.
+ * @param soma Soma das leituras brutas
+ * @return Temperatura em centésimos de grau Celsius, arredondada
  */
-void sensor_temp_init(void) {
-    adc_init();
+static int32_t converter_para_centi(uint32_t soma) {
+    int64_t temperatura_q24 = OFFSET_Q24 - (int64_t)soma * COEFICIENTE_Q24;
+    return (int32_t)((temperatura_q24 + (1 << 23)) >> 24);
+}
 
-    adc_set_temp_sensor_enabled(true);
+/**
+ * @brief Converte uma publicação do serviço de ADC em ultima_medida.
+ * @param leitura Soma e soma dos quadrados de CONVERSOES_POR_MEDIDA conversões
+ */
+static void converter_leitura(const LeituraAdc_t *leitura) {
+    // N·Σx² - (Σx)² = N²·variância, exato em inteiros e nunca negativo (zero com N = 1)
+    int64_t n2_variancia = (int64_t)CONVERSOES_POR_MEDIDA * (int64_t)leitura->soma_quadrados -
+                           (int64_t)leitura->soma * leitura->soma;
+    ultima_medida.temperatura_centi = converter_para_centi(leitura->soma);
+    ultima_medida.variancia_centi2 = (uint32_t)((n2_variancia * GANHO_VARIANCIA_Q24) >> 24);
+    ultima_medida.variancia_media_centi2 = ultima_medida.variancia_centi2 / CONVERSOES_POR_MEDIDA;
+    ultima_medida.conversoes = leitura->conversoes;
+    ultima_medida.medido_em_ms = leitura->publicado_em_ms;
+    sequencia_convertida = leitura->sequencia;
 }
 
 /**
- * @brief Lê a temperatura do sensor interno.
- *
- * Esta função realiza a leitura do sensor de temperatura interno do RP2040.
- * O processo envolve:
- * 1. Selecionar o canal ADC 4, que está conectado ao sensor de temperatura
- * 2. Realizar a leitura do ADC
- * 3. Converter o valor digital para tensão
- * 4. Converter a tensão para temperatura em graus Celsius
+ * @brief Repassa a publicação do canal de temperatura ao aviso definido (na interrupção).
+ */
+static void medida_publicada(uint8_t canal, void *arg) {
+    if (aviso_medida) {
+        aviso_medida();
+    }
+}
+
+/**
+ * @brief Registra o sensor de temperatura interno no serviço de ADC.
  *
- * @return A temperatura em graus Celsius.
- */
-float sensor_temp_read(void) {
-    // Seleciona o canal 4 do ADC onde o sensor de temperatura está conectado
-    adc_select_input(4);
-    
-    uint16_t valor_adc = adc_read();
-    
-    // Converte o valor do ADC para tensão 
+ * A conversão só começa com servico_adc_iniciar(), chamada depois que
+ * todos os sensores se registraram.
+ */
+bool sensor_temp_init(void) {
+    return servico_adc_registrar(SERVICO_ADC_CANAL_TEMPERATURA, SENSOR_TEMP_PERIODO_SAIDA_MS,
+                                 CONVERSOES_POR_MEDIDA, medida_publicada, NULL);
+}
+
+/**
+ * @brief Define quem é avisado a cada medida nova.
+ */
+void sensor_temp_definir_aviso(AvisoMedidaTemperatura_t aviso) {
+    aviso_medida = aviso;
+}
+
+/**
+ * @brief Obtém a medida mais recente, com a variância.
+ */
+bool sensor_temp_medir(MedidaTemperatura_t *medida) {
+    LeituraAdc_t leitura;
+    // Só converte de novo quando o serviço publicou uma rajada nova
+    if (servico_adc_ler(SERVICO_ADC_CANAL_TEMPERATURA, &leitura) && leitura.sequencia != sequencia_convertida) {
+        converter_leitura(&leitura);
+    }
+    *medida = ultima_medida;
+    return sequencia_convertida != 0;
+}
+
+#if SENSOR_TEMP_BENCHMARK
+/**
+ * @brief Conversão antiga, em float, mantida apenas como referência do benchmark.
+ */
+static float converter_float_referencia(uint16_t valor_adc) {
     float voltagem = (valor_adc / 4095.0f) * 3.3f;
-    
-    // Converte a tensão para temperatura usando a fórmula de calibração do sensor
-    float temperatura = 21.0f - (voltagem - 0.706f) / 0.001721f;
-    
-    return temperatura;
-}
\ No newline at end of file
+    return 21.0f - (voltagem - 0.706f) / 0.001721f;
+}
+
+/**
+ * @brief Converte microssegundos gastos em N amostras para ciclos por amostra.
+ */
+static uint32_t ciclos_por_amostra(uint64_t duracao_us, uint32_t amostras) {
+    return (uint32_t)(duracao_us * (clock_get_hz(clk_sys) / 1000000u) / amostras);
+}
+
+/**
+ * @brief Mede e imprime o custo, em ciclos por amostra, da conversão e da formatação.
+ */
+void sensor_temp_benchmark(void) {
+    const uint32_t amostras = 4096;
+    volatile int32_t destino_centi = 0;
+    volatile float destino_float = 0.0f;
+    char texto[24];
+    uint64_t inicio;
+
+    inicio = time_us_64();
+    for (uint32_t adc = 0; adc < amostras; adc++) {
+        destino_float = converter_float_referencia((uint16_t)adc);
+    }
+    uint32_t conversao_float = ciclos_por_amostra(time_us_64() - inicio, amostras);
+
+    // Uma leitura por "medida", como no modo simples
+    inicio = time_us_64();
+    for (uint32_t adc = 0; adc < amostras; adc++) {
+        destino_centi = (int32_t)((OFFSET_Q24 - (int64_t)adc * COEFICIENTE_Q24 * CONVERSOES_POR_MEDIDA + (1 << 23)) >> 24);
+    }
+    uint32_t conversao_fixo = ciclos_por_amostra(time_us_64() - inicio, amostras);
+
+    inicio = time_us_64();
+    for (uint32_t adc = 0; adc < amostras; adc++) {
+        snprintf(texto, sizeof(texto), "%.2f", (double)converter_float_referencia((uint16_t)adc));
+    }
+    uint32_t formatacao_float = ciclos_por_amostra(time_us_64() - inicio, amostras);
+
+    inicio = time_us_64();
+    for (uint32_t adc = 0; adc < amostras; adc++) {
+        int32_t centi = (int32_t)((OFFSET_Q24 - (int64_t)adc * COEFICIENTE_Q24 * CONVERSOES_POR_MEDIDA + (1 << 23)) >> 24);
+        snprintf(texto, sizeof(texto), TEMPERATURA_CENTI_FORMATO, TEMPERATURA_CENTI_ARGS(centi));
+    }
+    uint32_t formatacao_fixo = ciclos_por_amostra(time_us_64() - inicio, amostras);
+
+    (void)destino_centi;
+    (void)destino_float;
+    printf("Benchmark temperatura (ciclos/amostra): conversao float=%lu fixo=%lu | "
+           "conversao+JSON float=%lu fixo=%lu\n",
+           (unsigned long)conversao_float, (unsigned long)conversao_fixo,
+           (unsigned long)formatacao_float, (unsigned long)formatacao_fixo);
+}
+#endif
@@ -10,7 +10,6 @@
 #define SENSOR_TEMP_H
 
 #include "pico/stdlib.h"
-#include "hardware/adc.h"
 
 /**
  * @defgroup TEMPERATURE_SENSOR Driver de Sensor de Temperatura
@@ -18,23 +17,132 @@
  */
 
 /**
- * @brief Inicializa o ADC para leitura do sensor de temperatura interno.
+ * @brief Uma conversão do ADC por medida
+ */
+#define SENSOR_TEMP_MODO_SIMPLES 0
+
+/**
+ * @brief Rajada de SENSOR_TEMP_SOBREAMOSTRAGEM conversões por medida, decimadas por média (boxcar)
+ */
+#define SENSOR_TEMP_MODO_SOBREAMOSTRADO 1
+
+/**
+ * @brief Modo de medição usado pelo driver (pode ser sobrescrito na linha de compilação)
+ */
+#ifndef SENSOR_TEMP_MODO
+#define SENSOR_TEMP_MODO SENSOR_TEMP_MODO_SOBREAMOSTRADO
+#endif
+
+/**
+ * @brief Número de conversões somadas em cada medida no modo sobreamostrado
+ *
+ * Cada fator de 4 reduz o desvio do ruído pela metade (um bit a mais de
+ * resolução). Com a taxa de quadros mínima do serviço de ADC
+ * (SERVICO_ADC_TAXA_MINIMA_QUADROS_HZ), 256 conversões levam cerca de 26 ms.
+ */
+#ifndef SENSOR_TEMP_SOBREAMOSTRAGEM
+#define SENSOR_TEMP_SOBREAMOSTRAGEM 256
+#endif
+
+/**
+ * @brief Intervalo, em ms, entre duas medidas novas (taxa de saída do decimador)
+ *
+ * É o período com que o canal é registrado no serviço de ADC (1 ms a
+ * SERVICO_ADC_PERIODO_MAXIMO_MS, conferido na compilação). Leituras feitas
+ * antes do fim do intervalo devolvem a última medida, então o custo de CPU
+ * é de uma rajada por intervalo, qualquer que seja a frequência de chamada.
+ */
+#ifndef SENSOR_TEMP_PERIODO_SAIDA_MS
+#define SENSOR_TEMP_PERIODO_SAIDA_MS 1000
+#endif
+
+/**
+ * @brief Compila sensor_temp_benchmark(), que compara a conversão em ponto fixo com a antiga em float
+ */
+#ifndef SENSOR_TEMP_BENCHMARK
+#define SENSOR_TEMP_BENCHMARK 0
+#endif
+
+/**
+ * @brief Formato printf de uma temperatura em centésimos de grau, sem ponto flutuante
+ *
+ * Usar junto com TEMPERATURA_CENTI_ARGS(), que fornece sinal, parte inteira
+ * e centésimos. Ex.: printf("Temp: " TEMPERATURA_CENTI_FORMATO " C", TEMPERATURA_CENTI_ARGS(t)).
+ */
+#define TEMPERATURA_CENTI_FORMATO "%s%ld.%02ld"
+
+/**
+ * @brief Argumentos para TEMPERATURA_CENTI_FORMATO a partir de uma temperatura em centésimos
+ */
+#define TEMPERATURA_CENTI_ARGS(centi) \
+    ((centi) < 0 ? "-" : ""), \
+    (long)(((centi) < 0 ? -(centi) : (centi)) / 100), \
+    (long)(((centi) < 0 ? -(centi) : (centi)) % 100)
+
+/**
+ * @brief Resultado de uma medida de temperatura
+ *
+ * Todos os valores são inteiros: o RP2040 não tem FPU e a conversão é
+ * feita em ponto fixo.
+ */
+typedef struct {
+    int32_t temperatura_centi;       /**< Temperatura em centésimos de grau Celsius */
+    uint32_t variancia_centi2;       /**< Variância das conversões individuais, em (centésimos de °C)² */
+    uint32_t variancia_media_centi2; /**< Variância estimada da temperatura medida (variancia / conversoes) */
+    uint16_t conversoes;             /**< Número de conversões usadas na medida */
+    uint32_t medido_em_ms;           /**< Instante da medida, em ms desde o boot */
+} MedidaTemperatura_t;
+
+/**
+ * @brief Registra o sensor de temperatura interno no serviço de ADC.
+ *
+ * Não configura o ADC: quem faz isso é servico_adc_iniciar(), chamada
+ * depois que todos os sensores se registraram.
+ *
+ * @return true se o canal foi registrado; sem ele nenhuma medida é publicada
+ */
+bool sensor_temp_init(void);
+
+/**
+ * @brief Função chamada a cada medida nova, na interrupção do serviço de ADC
+ */
+typedef void (*AvisoMedidaTemperatura_t)(void);
+
+/**
+ * @brief Define quem é avisado a cada medida nova.
  *
- * Esta função configura o conversor analógico-digital (ADC) e habilita
- * o sensor de temperatura interno do RP2040 para medições.
+ * Permite esperar a próxima medida bloqueado (ex.: com uma notificação de
+ * task) em vez de consultar sensor_temp_medir() periodicamente. O aviso
+ * roda em interrupção e não pode bloquear.
+ *
+ * @param aviso Função de aviso (NULL para desligar)
  */
-void sensor_temp_init(void);
+void sensor_temp_definir_aviso(AvisoMedidaTemperatura_t aviso);
 
 /**
- * @brief Lê a temperatura do sensor interno.
+ * @brief Obtém a medida mais recente, com a variância.
+ *
+ * Não bloqueia: converte a publicação mais recente do serviço de ADC, que
+ * chega a cada SENSOR_TEMP_PERIODO_SAIDA_MS. A variância vem das próprias
+ * conversões da rajada; no modo simples não há como estimá-la e ela fica
+ * em zero.
  *
- * Esta função seleciona o canal ADC apropriado, realiza a leitura do 
- * sensor de temperatura interno e converte o valor lido para temperatura em graus Celsius.
+ * @param medida Destino da medida
+ * @return false se o serviço ainda não publicou nenhuma medida
+ */
+bool sensor_temp_medir(MedidaTemperatura_t *medida);
+
+#if SENSOR_TEMP_BENCHMARK
+/**
+ * @brief Mede e imprime o custo, em ciclos por amostra, da conversão e da formatação.
  *
- * @return A temperatura em graus Celsius.
+ * Compara o caminho em ponto fixo com o antigo caminho em float (conversão
+ * com divisões em float e JSON com "%.2f") sobre as 4096 leituras possíveis
+ * do ADC. Bloqueia por alguns milissegundos.
  */
-float sensor_temp_read(void);
+void sensor_temp_benchmark(void);
+#endif
 
 /** @} */ // Fim do grupo TEMPERATURE_SENSOR
 
-#endif // SENSOR_TEMP_H
\ No newline at end of file
+#endif // SENSOR_TEMP_H
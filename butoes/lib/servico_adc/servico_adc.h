@@ -0,0 +1,130 @@
+/**
+ * @file servico_adc.h
+ * @brief Interface do serviço que compartilha o ADC entre vários sensores
+ *
+ * O serviço é o único dono do ADC. Cada sensor registra o seu canal com
+ * um período de publicação e um número de conversões por publicação; ao
+ * iniciar, o ADC passa a converter em round-robin todos os canais
+ * registrados, com o DMA gravando os resultados em dois blocos alternados.
+ * A interrupção de fim de bloco soma as conversões de cada canal e, a cada
+ * período do canal, publica a soma e a soma dos quadrados.
+ *
+ * A leitura de uma publicação nunca bloqueia quem lê nem quem publica: cada
+ * canal tem um contador de versão (seqlock) e o leitor só repete a cópia
+ * se uma publicação acontecer no meio dela.
+ */
+
+#ifndef SERVICO_ADC_H
+#define SERVICO_ADC_H
+
+#include "pico/stdlib.h"
+
+/**
+ * @defgroup SERVICO_ADC Serviço de ADC
+ * @{
+ */
+
+/**
+ * @brief Número de canais do ADC do RP2040 (GPIO 26 a 29 e sensor de temperatura)
+ */
+#define SERVICO_ADC_NUM_CANAIS 5
+
+/**
+ * @brief Canal ligado ao sensor de temperatura interno
+ */
+#define SERVICO_ADC_CANAL_TEMPERATURA 4
+
+/**
+ * @brief Menor taxa de quadros, em Hz, com que o ADC percorre os canais registrados
+ *
+ * Uma taxa alta faz as conversões de cada publicação saírem em rajada,
+ * logo no início do período do canal, como na sobreamostragem por FIFO.
+ * O divisor de clock do ADC não passa de 65535, o que limita a taxa de
+ * conversões a cerca de 732 por segundo.
+ */
+#ifndef SERVICO_ADC_TAXA_MINIMA_QUADROS_HZ
+#define SERVICO_ADC_TAXA_MINIMA_QUADROS_HZ 10000
+#endif
+
+/**
+ * @brief Interrupções de fim de bloco por segundo desejadas (define o tamanho dos blocos)
+ *
+ * Cada bloco acorda a CPU; quem precisa economizar energia usa poucos
+ * blocos por segundo e uma taxa de quadros baixa.
+ */
+#ifndef SERVICO_ADC_BLOCOS_POR_SEGUNDO
+#define SERVICO_ADC_BLOCOS_POR_SEGUNDO 50
+#endif
+
+/**
+ * @brief Maior período de publicação aceito por servico_adc_registrar(), em ms
+ *
+ * Mantém o período em quadros dentro de 32 bits na maior taxa de quadros.
+ */
+#define SERVICO_ADC_PERIODO_MAXIMO_MS 3600000u
+
+/**
+ * @brief Capacidade, em amostras, de cada um dos dois blocos do DMA
+ */
+#define SERVICO_ADC_AMOSTRAS_POR_BLOCO 512
+
+/**
+ * @brief Função chamada a cada publicação de um canal
+ *
+ * Roda dentro da interrupção do DMA: não pode bloquear. Serve para acordar
+ * quem espera a medida (ex.: xTaskNotifyFromISR()).
+ *
+ * @param canal Canal que acabou de publicar
+ * @param arg Argumento informado no registro
+ */
+typedef void (*ServicoAdcCallback_t)(uint8_t canal, void *arg);
+
+/**
+ * @brief Uma publicação de um canal
+ */
+typedef struct {
+    uint32_t soma;            /**< Soma das conversões do período */
+    uint64_t soma_quadrados;  /**< Soma dos quadrados das conversões do período */
+    uint16_t conversoes;      /**< Conversões somadas (o valor pedido no registro) */
+    uint32_t sequencia;       /**< Número da publicação, a partir de 1 */
+    uint32_t publicado_em_ms; /**< Instante da publicação, em ms desde o boot */
+} LeituraAdc_t;
+
+/**
+ * @brief Registra um canal no serviço.
+ *
+ * Deve ser chamada antes de servico_adc_iniciar(). O ADC percorre os
+ * canais juntos, na maior taxa de quadros pedida; canais mais lentos usam
+ * só as primeiras conversões de cada período e ignoram as demais.
+ *
+ * @param canal Canal do ADC (0 a 3 para os GPIO 26 a 29, 4 para a temperatura)
+ * @param periodo_ms Intervalo entre duas publicações, em ms (1 a SERVICO_ADC_PERIODO_MAXIMO_MS)
+ * @param conversoes Conversões somadas em cada publicação
+ * @param callback Chamada a cada publicação, na interrupção (pode ser NULL)
+ * @param arg Argumento repassado ao callback
+ * @return true se o canal foi registrado; false se o canal ou o período é
+ *         inválido, o canal já foi registrado ou o serviço já foi iniciado
+ */
+bool servico_adc_registrar(uint8_t canal, uint32_t periodo_ms, uint16_t conversoes,
+                           ServicoAdcCallback_t callback, void *arg);
+
+/**
+ * @brief Configura o ADC e o DMA para os canais registrados e começa a converter.
+ *
+ * Chamar uma vez, depois que todos os sensores registraram seus canais.
+ *
+ * @return true se a conversão começou
+ */
+bool servico_adc_iniciar(void);
+
+/**
+ * @brief Copia a publicação mais recente de um canal, sem bloquear.
+ * @param canal Canal registrado
+ * @param leitura Recebe a publicação
+ * @return true se o canal já publicou pelo menos uma vez
+ */
+bool servico_adc_ler(uint8_t canal, LeituraAdc_t *leitura);
+
+/** @} */ // Fim do grupo SERVICO_ADC
+
+#endif // SERVICO_ADC_H
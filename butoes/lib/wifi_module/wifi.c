@@ -13,9 +13,10 @@
 /**
  * @brief Inicializa a conexão Wi-Fi.
  * 
- * Esta função inicializa o hardware Wi-Fi CYW43, configura o modo estação
- * e tenta estabelecer conexão com a rede Wi-Fi configurada. Em caso de falha
- * na inicialização, a função retorna imediatamente com código de erro.
+ * Na primeira chamada inicializa o hardware Wi-Fi CYW43 e configura o modo
+ * estação; as chamadas seguintes apenas tentam reconectar à rede Wi-Fi
+ * configurada. Em caso de falha na inicialização, a função retorna
+ * imediatamente com código de erro.
  * 
  * @return 0 se a conexão for bem-sucedida, -1 caso contrário.
  * @note Inicializa o módulo Wi-Fi, ativa o modo estação e tenta conectar à rede especificada.
@@ -23,17 +24,23 @@
  */
 int conexao_wifi() {
 
+    static bool inicializado = false;
     int conexao;
 
-    while (cyw43_arch_init())
-    {
-        printf("Falha ao inicializar Wi-Fi\n");
-        sleep_ms(100);
-        return -1;
+    if (!inicializado) {
+        if (cyw43_arch_init()) {
+            printf("Falha ao inicializar Wi-Fi\n");
+            sleep_ms(100);
+            return -1;
+        }
+        cyw43_arch_enable_sta_mode();
+#if defined(BAIXO_CONSUMO) && BAIXO_CONSUMO
+        // O rádio dorme entre os beacons do AP; a latência de recepção sobe para algumas centenas de ms
+        cyw43_wifi_pm(&cyw43_state, CYW43_AGGRESSIVE_PM);
+#endif
+        inicializado = true;
     }
 
-    cyw43_arch_enable_sta_mode();
-
     printf("Conectando ao Wi-Fi '%s'...\n", NOME_REDE_WIFI);
     
     conexao = cyw43_arch_wifi_connect_timeout_ms(NOME_REDE_WIFI, SENHA_REDE_WIFI, CYW43_AUTH_WPA2_AES_PSK, 10000);
@@ -41,4 +48,19 @@ int conexao_wifi() {
     char *menssagem = (conexao == 0) ? "Wifi Conectado...\n" : "Falha ao Conectar...\n";
     printf(menssagem);
     return conexao;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Verifica se a interface Wi-Fi está associada e com endereço IP.
+ *
+ * O estado consultado inclui a netif do lwIP, então a leitura é feita com
+ * a trava do lwIP, como os acessos do cliente HTTP.
+ *
+ * @return true se o enlace está ativo, false caso contrário
+ */
+bool wifi_esta_conectado(void) {
+    cyw43_arch_lwip_begin();
+    int status = cyw43_tcpip_link_status(&cyw43_state, CYW43_ITF_STA);
+    cyw43_arch_lwip_end();
+    return status == CYW43_LINK_UP;
+}
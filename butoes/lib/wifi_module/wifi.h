@@ -9,6 +9,8 @@
 #ifndef WIFI_H
 #define WIFI_H
 
+#include <stdbool.h>
+
 /**
  * @defgroup WIFI_MODULE Módulo Wi-Fi
  * @{
@@ -35,6 +37,15 @@
  */
 int conexao_wifi();
 
+/**
+ * @brief Verifica se a conexão Wi-Fi continua ativa
+ *
+ * Permite detectar a queda do ponto de acesso depois da conexão inicial.
+ *
+ * @return true se o enlace está ativo e com IP, false caso contrário
+ */
+bool wifi_esta_conectado(void);
+
 /** @} */ // Fim do grupo WIFI_MODULE
 
 #endif
\ No newline at end of file
@@ -21,47 +21,111 @@
 
 #include "FreeRTOS.h"
 #include "task.h"
-#include "queue.h"
 
 #include "buttons.h"
 #include "cliente_http.h"
 #include "wifi.h"
 #include "sensor_temp.h"
+#include "detector_mudanca.h"
+#include "servico_adc.h"
+#include "buffer_amostras.h"
+#include "log_flash.h"
+#include "relatorio_consumo.h"
+#include "anel_spsc.h"
 
 /**
  * @defgroup APP_MAIN Aplicação Principal
  * @{
  */
 
-/**
- * @brief Intervalo em milissegundos para envio de dados para a nuvem
- */
-#define INTERVALO_ENVIO_DADOS_BOTOES_MS 1000
-
 /**
  * @brief Prioridades e tamanhos de stack para tasks do FreeRTOS
  * @{
  */
-#define BUTTON_TASK_PRIORITY   (tskIDLE_PRIORITY + 1) /**< Prioridade da task de botões */
-#define WIFI_TASK_PRIORITY     (tskIDLE_PRIORITY + 2) /**< Prioridade da task de Wi-Fi (maior para garantir envio de dados) */
+#define BUTTON_TASK_PRIORITY   (tskIDLE_PRIORITY + 3) /**< Prioridade da task de botões (maior: fica bloqueada e só acorda por evento, com latência mínima) */
+#define WIFI_TASK_PRIORITY     (tskIDLE_PRIORITY + 2) /**< Prioridade da task de Wi-Fi (abaixo da de botões, que a preempta a cada evento) */
 #define BUTTON_TASK_STACK_SIZE (configMINIMAL_STACK_SIZE + 256) /**< Tamanho da stack da task de botões */
 #define WIFI_TASK_STACK_SIZE   configMINIMAL_STACK_SIZE * 2     /**< Tamanho da stack da task de Wi-Fi */
 /** @} */
 
 /**
- * @brief Fila para comunicação entre tasks
- * 
- * Esta fila é usada para passar eventos de mudança dos botões da task de botões
- * para a task de Wi-Fi, que então envia os dados para a nuvem.
+ * @brief Intervalo, em ms, entre os relatórios de latência e de despertares impressos pela task de Wi-Fi
+ */
+#define INTERVALO_RELATORIOS_MS 60000
+
+/**
+ * @brief Intervalo, em ms, entre as tentativas de reconexão ao Wi-Fi
+ */
+#define INTERVALO_RECONEXAO_WIFI_MS 10000
+
+/**
+ * @brief Maior intervalo, em ms, que a task de Wi-Fi dorme com a conexão ativa
+ *
+ * Sem amostras nem envios pendentes, é só com esse despertar que uma queda
+ * do enlace é percebida.
+ */
+#define INTERVALO_SUPERVISAO_WIFI_MS 10000
+
+/**
+ * @brief Detector de mudança da temperatura
+ *
+ * Variações de até 0,5 °C são tratadas como ruído; uma variação maior
+ * precisa durar 2 s para virar amostra, e a temperatura gera no máximo uma
+ * amostra a cada 10 s. Os botões continuam gerando amostra a cada mudança.
+ */
+static const ConfigDetector_t CONFIG_DETECTOR_TEMPERATURA = {
+    .banda = 50,                    // centésimos de grau
+    .debounce_ms = 2000,
+    .permanencia_minima_ms = 10000
+};
+
+/**
+ * @brief Amostras que o anel entre as tasks comporta (potência de 2)
+ */
+#define CAPACIDADE_ANEL_AMOSTRAS 32
+
+/**
+ * @brief Anel para comunicação entre tasks
+ *
+ * Passa as amostras da task de botões (única produtora) para a task de
+ * Wi-Fi (única consumidora), que então as envia para a nuvem. Não usa
+ * trava do kernel nem bloqueia a task de botões, e a task de Wi-Fi só é
+ * notificada quando o anel deixa de estar vazio.
  */
-static QueueHandle_t xButtonEventQueue = NULL;
+static AnelSpsc_t anel_amostras;
+
+/** @brief Armazenamento do anel de amostras */
+static Amostra_t armazenamento_anel_amostras[CAPACIDADE_ANEL_AMOSTRAS];
+
+/**
+ * @brief Buffer de amostras aguardando envio em lote
+ *
+ * Usado apenas pela task de Wi-Fi: toda amostra recebida do anel é guardada
+ * aqui e o cliente HTTP a envia no próximo lote.
+ */
+static BufferAmostras_t buffer_amostras_botoes;
+
+/**
+ * @brief Log em flash das amostras recebidas enquanto o Wi-Fi está fora
+ *
+ * Usado apenas pela task de Wi-Fi: depois da reconexão as amostras voltam
+ * aos poucos para buffer_amostras_botoes.
+ */
+static LogFlash_t log_amostras_botoes;
 
 /**
  * @brief Variáveis globais para gerenciamento do estado Wi-Fi
  * @{
  */
 static bool wifi_conectado_status_botoes = false;   /**< Indica se o Wi-Fi está conectado */
-static uint32_t ultimo_envio_botoes_ms = 0;         /**< Timestamp do último envio de dados */
+/** @} */
+
+/**
+ * @brief Handles das tasks, usados pelos avisos que as acordam
+ * @{
+ */
+static TaskHandle_t button_task_handle = NULL; /**< Acordada pelos botões e pela temperatura */
+static TaskHandle_t wifi_task_handle = NULL;   /**< Acordada por amostras e pelo cliente HTTP */
 /** @} */
 
 /**
@@ -70,6 +134,9 @@ static uint32_t ultimo_envio_botoes_ms = 0;         /**< Timestamp do último en
  */
 /**
  * @brief Task responsável por monitorar os botões e enviar atualizações para a task Wi-Fi
+ *
+ * Fica bloqueada até a IRQ do amostrador de botões (PIO) notificar uma mudança
+ * confirmada, ou até a próxima medida de temperatura.
  * @param pvParameters Parâmetros passados para a task (não utilizado)
  */
 static void button_task(void *pvParameters);
@@ -91,28 +158,59 @@ static void wifi_task(void *pvParameters);
  */
 static bool tentar_conectar_wifi_botoes_freertos(void);
 
+/**
+ * @brief Acorda a task de botões a cada medida nova de temperatura (na interrupção do ADC)
+ */
+static void avisar_button_task(void);
+
+/**
+ * @brief Acorda a task de Wi-Fi quando o anel de amostras deixa de estar vazio ou o cliente HTTP libera um contexto
+ */
+static void avisar_wifi_task(void);
+
+/**
+ * @brief Calcula quanto a task de Wi-Fi pode dormir até o próximo prazo
+ * @param ultimo_relatorio_ms Instante do último relatório periódico
+ * @param ultima_tentativa_ms Instante da última tentativa de reconexão
+ * @return Tempo em ms até o prazo mais próximo
+ */
+static uint32_t calcular_espera_wifi_ms(uint32_t ultimo_relatorio_ms, uint32_t ultima_tentativa_ms);
+
 int main(void) {
     stdio_init_all();
     printf("Sistema de Botões e Temperatura inicializando com FreeRTOS...\n");
 
     buttons_init();
     printf("Botões GPIO inicializados.\n");
-    sensor_temp_init();
+    if (!sensor_temp_init()) {
+        printf("Falha ao registrar o sensor de temperatura no serviço de ADC!\n");
+    }
+    // Todos os sensores analógicos já registraram seus canais
+    if (!servico_adc_iniciar()) {
+        printf("Falha ao iniciar o serviço de ADC!\n");
+    }
     printf("Sensor de temperatura inicializado.\n");
+#if SENSOR_TEMP_BENCHMARK
+    sensor_temp_benchmark();
+#endif
+    http_client_init();
 
 
-    // Cria a fila para eventos dos botões
-    xButtonEventQueue = xQueueCreate(5, sizeof(ButtonStates_t));
-    if (xButtonEventQueue == NULL) {
-        printf("Falha ao criar a fila de eventos dos botões!\n");
+    // Cria o anel para as amostras dos botões; o aviso acorda a task de Wi-Fi
+    if (!anel_spsc_init(&anel_amostras, armazenamento_anel_amostras, sizeof(Amostra_t),
+                        CAPACIDADE_ANEL_AMOSTRAS, avisar_wifi_task)) {
+        printf("Falha ao criar o anel de amostras dos botões!\n");
         while (1);
     }
 
     // Cria a task de leitura dos botões
-    xTaskCreate(button_task, "ButtonTask", BUTTON_TASK_STACK_SIZE, NULL, BUTTON_TASK_PRIORITY, NULL);
+    xTaskCreate(button_task, "ButtonTask", BUTTON_TASK_STACK_SIZE, NULL, BUTTON_TASK_PRIORITY, &button_task_handle);
 
-    TaskHandle_t wifiTaskHandle;
-    xTaskCreate(wifi_task, "WifiTask", WIFI_TASK_STACK_SIZE, NULL, WIFI_TASK_PRIORITY, &wifiTaskHandle);
+    xTaskCreate(wifi_task, "WifiTask", WIFI_TASK_STACK_SIZE, NULL, WIFI_TASK_PRIORITY, &wifi_task_handle);
+
+    // As tasks só acordam por eventos: medidas novas, amostras e contextos HTTP liberados
+    sensor_temp_definir_aviso(avisar_button_task);
+    http_client_definir_aviso(avisar_wifi_task);
 
     printf("Scheduler FreeRTOS iniciando...\n");
     vTaskStartScheduler();
@@ -125,33 +223,63 @@ int main(void) {
 static void button_task(void *pvParameters) {
     printf("Button Task iniciada no Core %d\n", get_core_num());
     ButtonStates_t estado_atual_botoes;
-    ButtonStates_t estado_anterior_botoes;
-
-    estado_anterior_botoes.button_a_pressed = false;
-    estado_anterior_botoes.button_b_pressed = true;
-
-    buttons_read(&estado_anterior_botoes);
+    EventoBotao_t evento;
+    Amostra_t amostra;
+    uint32_t proxima_sequencia = 0;
+    DetectorMudanca_t detector_temperatura;
+    MedidaTemperatura_t medida;
+
+    // O fluxo de eventos parte de todos os botões pressionados e corrige logo na partida
+    estado_atual_botoes.button_a_pressed = true;
+    estado_atual_botoes.button_b_pressed = true;
+    if (!buttons_iniciar_eventos()) {
+        printf("Sem PIO livre para o amostrador dos botões!\n");
+    }
+    // A primeira medida vira a referência, sem gerar amostra. Até o serviço de ADC
+    // publicar a primeira, a task dorme no aviso da temperatura; uma notificação de
+    // botão consumida aqui não se perde, porque o evento continua no anel do driver
+    while (!sensor_temp_medir(&medida)) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+    detector_mudanca_init(&detector_temperatura, &CONFIG_DETECTOR_TEMPERATURA);
+    detector_mudanca_atualizar(&detector_temperatura, medida.temperatura_centi, to_ms_since_boot(get_absolute_time()));
 
     while (true) {
-        buttons_read(&estado_atual_botoes);
-        estado_atual_botoes.temperature = sensor_temp_read();
+        // Dorme até uma mudança de botão ou até o aviso de uma nova medida de temperatura
+        bool houve_evento = buttons_aguardar_evento(&evento, portMAX_DELAY);
+        relatorio_consumo_contar(houve_evento ? DESPERTAR_BOTAO : DESPERTAR_TEMPERATURA);
+        uint32_t instante_leitura_ms = to_ms_since_boot(get_absolute_time());
+        if (houve_evento) {
+            // O instante da amostra é o da borda, reconstruído do contador do PIO
+            instante_leitura_ms = (uint32_t)(evento.borda_us / 1000);
+            if (evento.pino == BUTTON_A_PIN) {
+                estado_atual_botoes.button_a_pressed = evento.pressionado;
+            } else {
+                estado_atual_botoes.button_b_pressed = evento.pressionado;
+            }
+        }
 
-        bool mudou = (estado_atual_botoes.button_a_pressed != estado_anterior_botoes.button_a_pressed ||
-                      estado_atual_botoes.button_b_pressed != estado_anterior_botoes.button_b_pressed);
+        sensor_temp_medir(&medida); // Já houve uma medida: não bloqueia nem falha
+        bool temperatura_mudou = detector_mudanca_atualizar(&detector_temperatura, medida.temperatura_centi,
+                                                            to_ms_since_boot(get_absolute_time()));
+        // A amostra leva a última temperatura aceita, para que o ruído não apareça nos dados
+        estado_atual_botoes.temperature_centi = detector_mudanca_valor(&detector_temperatura);
 
-        if (mudou) {
-            printf("Mudança Botões (Core %d): A=%s, B=%s. Temp: %.2f C\n", get_core_num(), // <<< ATUALIZADO
+        if (houve_evento || temperatura_mudou) {
+            printf("Mudança Botões (Core %d): A=%s, B=%s. Temp: " TEMPERATURA_CENTI_FORMATO " C (borda há %lu us)\n",
+                   get_core_num(),
                    estado_atual_botoes.button_a_pressed ? "ON" : "OFF",
                    estado_atual_botoes.button_b_pressed ? "ON" : "OFF",
-                   estado_atual_botoes.temperature);
-
-            if (xQueueSend(xButtonEventQueue, &estado_atual_botoes, (TickType_t)10) != pdPASS) {
-                printf("Falha ao enviar para a fila de botões!\n");
+                   TEMPERATURA_CENTI_ARGS(estado_atual_botoes.temperature_centi),
+                   houve_evento ? (unsigned long)(time_us_64() - evento.borda_us) : 0ul);
+
+            amostra.sequencia = proxima_sequencia++;
+            amostra.timestamp_ms = instante_leitura_ms;
+            amostra.estado = estado_atual_botoes;
+            if (!anel_spsc_inserir(&anel_amostras, &amostra)) {
+                printf("Anel de amostras cheio: amostra %lu descartada!\n", (unsigned long)amostra.sequencia);
             }
-            estado_anterior_botoes.button_a_pressed = estado_atual_botoes.button_a_pressed;
-            estado_anterior_botoes.button_b_pressed = estado_atual_botoes.button_b_pressed;
         }
-        vTaskDelay(pdMS_TO_TICKS(50));
     }
 }
 
@@ -167,37 +295,141 @@ static bool tentar_conectar_wifi_botoes_freertos(void) {
     }
 }
 
+/**
+ * @brief Acorda a task de botões a cada medida nova de temperatura.
+ */
+static void avisar_button_task(void) {
+    BaseType_t acordou_prioritaria = pdFALSE;
+    vTaskNotifyGiveFromISR(button_task_handle, &acordou_prioritaria);
+    portYIELD_FROM_ISR(acordou_prioritaria);
+}
+
+/**
+ * @brief Acorda a task de Wi-Fi quando o anel de amostras deixa de estar
+ *        vazio ou o cliente HTTP libera um contexto.
+ *
+ * O anel avisa de dentro da task de botões; o contexto pode ser liberado
+ * no lwIP, em interrupção, ou dentro de uma chamada da própria task.
+ */
+static void avisar_wifi_task(void) {
+    if (portCHECK_IF_IN_ISR()) {
+        BaseType_t acordou_prioritaria = pdFALSE;
+        vTaskNotifyGiveFromISR(wifi_task_handle, &acordou_prioritaria);
+        portYIELD_FROM_ISR(acordou_prioritaria);
+    } else {
+        xTaskNotifyGive(wifi_task_handle);
+    }
+}
+
+/**
+ * @brief Tempo que falta, em ms, para completar um intervalo iniciado em desde_ms.
+ */
+static uint32_t ms_ate_fim_intervalo(uint32_t desde_ms, uint32_t intervalo_ms) {
+    uint32_t decorrido = to_ms_since_boot(get_absolute_time()) - desde_ms;
+    return decorrido >= intervalo_ms ? 0 : intervalo_ms - decorrido;
+}
+
+/**
+ * @brief Calcula quanto a task de Wi-Fi pode dormir até o próximo prazo.
+ *
+ * Os prazos são o próximo relatório e, com a conexão ativa, o próximo lote
+ * (prazo da amostra mais antiga ou limite de taxa) e a supervisão do
+ * enlace; sem ela, a próxima tentativa de reconexão. Amostras novas e
+ * contextos HTTP liberados acordam a task antes, por notificação.
+ */
+static uint32_t calcular_espera_wifi_ms(uint32_t ultimo_relatorio_ms, uint32_t ultima_tentativa_ms) {
+    uint32_t espera_ms = ms_ate_fim_intervalo(ultimo_relatorio_ms, INTERVALO_RELATORIOS_MS);
+    if (wifi_conectado_status_botoes) {
+        uint32_t lote_ms = http_client_ms_ate_proximo_lote(&buffer_amostras_botoes);
+        if (lote_ms < espera_ms) {
+            espera_ms = lote_ms;
+        }
+        if (INTERVALO_SUPERVISAO_WIFI_MS < espera_ms) {
+            espera_ms = INTERVALO_SUPERVISAO_WIFI_MS;
+        }
+    } else {
+        uint32_t reconexao_ms = ms_ate_fim_intervalo(ultima_tentativa_ms, INTERVALO_RECONEXAO_WIFI_MS);
+        if (reconexao_ms < espera_ms) {
+            espera_ms = reconexao_ms;
+        }
+    }
+    return espera_ms;
+}
+
 static void wifi_task(void *pvParameters) {
     printf("WiFi Task iniciada no Core %d\n", get_core_num());
-    ButtonStates_t estado_recebido_botoes;
+    Amostra_t amostra_recebida;
+    uint32_t ultimo_relatorio_ms = to_ms_since_boot(get_absolute_time());
+    uint32_t ultima_tentativa_ms;
 
+    buffer_amostras_init(&buffer_amostras_botoes);
+    log_flash_init(&log_amostras_botoes, memoria_flash_pico());
     wifi_conectado_status_botoes = tentar_conectar_wifi_botoes_freertos();
+    ultima_tentativa_ms = to_ms_since_boot(get_absolute_time());
 
     while (true) {
-        cyw43_arch_poll();
+        // Na arquitetura threadsafe_background o lwIP roda em interrupção, sem cyw43_arch_poll():
+        // a task dorme até uma notificação (amostra nova ou contexto HTTP liberado) ou o próximo prazo
+        uint32_t espera_ms = calcular_espera_wifi_ms(ultimo_relatorio_ms, ultima_tentativa_ms);
+        uint32_t avisos = ulTaskNotifyTake(pdTRUE, espera_ms == HTTP_SEM_PRAZO ? portMAX_DELAY : pdMS_TO_TICKS(espera_ms));
+        bool havia_amostra = anel_spsc_tamanho(&anel_amostras) > 0;
+        relatorio_consumo_contar(havia_amostra ? DESPERTAR_AMOSTRA : (avisos ? DESPERTAR_REDE : DESPERTAR_PRAZO));
+
+        // Toda amostra recebida do anel é guardada para o próximo lote; se o cliente está
+        // segurando um lote inteiro (limite de taxa ou contrapressão), ela substitui a
+        // mais recente ao vivo ainda não enviada (nunca uma reposta do log)
+        while (anel_spsc_remover(&anel_amostras, &amostra_recebida)) {
+            if (wifi_conectado_status_botoes && (http_client_envio_limitado() || http_client_sob_pressao())) {
+                buffer_amostras_coalescer(&buffer_amostras_botoes, &amostra_recebida, HTTP_TAMANHO_LOTE);
+            } else {
+                buffer_amostras_inserir(&buffer_amostras_botoes, &amostra_recebida);
+            }
+        }
 
-        // Tenta receber da fila
-        if (xQueueReceive(xButtonEventQueue, &estado_recebido_botoes, pdMS_TO_TICKS(100))) {
-            // Se recebeu algo da fila e o Wi-Fi está conectado
-            if (wifi_conectado_status_botoes) {
-                uint32_t tempo_atual_ms = to_ms_since_boot(get_absolute_time());
-                if (tempo_atual_ms - ultimo_envio_botoes_ms >= INTERVALO_ENVIO_DADOS_BOTOES_MS) {
-                    printf("Enviando dados (botões e temp: %.2fC) para a nuvem (Core %d)...\n",estado_recebido_botoes.temperature, get_core_num());
-                    enviar_dados_para_nuvem(&estado_recebido_botoes);
+        // Amostras de lotes que falharam voltam ao log e são repostas como as gravadas sem Wi-Fi
+        while (http_client_retirar_devolvida(&amostra_recebida)) {
+            log_flash_gravar(&log_amostras_botoes, &amostra_recebida);
+        }
+
+        if (wifi_conectado_status_botoes && !wifi_esta_conectado()) {
+            printf("Botões (Core %d): conexão Wi-Fi perdida, gravando amostras na flash.\n", get_core_num());
+            wifi_conectado_status_botoes = false;
+        }
 
-                    ultimo_envio_botoes_ms = tempo_atual_ms;
-                }
+        // O cliente HTTP decide se o lote já está completo ou se o prazo venceu
+        if (wifi_conectado_status_botoes) {
+            // Amostras gravadas durante a queda voltam aos poucos, sem tomar o lugar das novas
+            uint16_t repostas = log_flash_repor(&log_amostras_botoes, &buffer_amostras_botoes,
+                                                to_ms_since_boot(get_absolute_time()));
+            if (repostas > 0) {
+                printf("Repondo %u amostras gravadas na flash...\n", repostas);
+            }
+            uint16_t enviadas = enviar_lote_para_nuvem(&buffer_amostras_botoes);
+            if (enviadas > 0) {
+                printf("Enviando lote de %u amostras (botões e temp) para a nuvem (Core %d)...\n", enviadas, get_core_num());
             }
         }
 
+        if (ms_ate_fim_intervalo(ultimo_relatorio_ms, INTERVALO_RELATORIOS_MS) == 0) {
+            if (wifi_conectado_status_botoes) {
+                http_client_imprimir_latencias();
+            }
+            relatorio_consumo_imprimir();
+            ultimo_relatorio_ms = to_ms_since_boot(get_absolute_time());
+        }
+
         // Lógica de reconexão ou status do Wi-Fi
         if (!wifi_conectado_status_botoes) {
-            static uint32_t ultimo_log_wifi_falhou_botoes = 0;
-            if (to_ms_since_boot(get_absolute_time()) - ultimo_log_wifi_falhou_botoes > 10000) {
+            // Sem Wi-Fi as amostras vão para a flash em vez de se perderem no buffer
+            while (buffer_amostras_remover(&buffer_amostras_botoes, &amostra_recebida)) {
+                log_flash_gravar(&log_amostras_botoes, &amostra_recebida);
+            }
+
+            if (ms_ate_fim_intervalo(ultima_tentativa_ms, INTERVALO_RECONEXAO_WIFI_MS) == 0) {
                 printf("Botões (Core %d): WiFi não conectado. Tentando reconectar...\n", get_core_num());
                 wifi_conectado_status_botoes = tentar_conectar_wifi_botoes_freertos();
-                ultimo_log_wifi_falhou_botoes = to_ms_since_boot(get_absolute_time());
+                ultima_tentativa_ms = to_ms_since_boot(get_absolute_time());
             }
         }
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,55 @@
+/**
+ * @file codificar_lote_telemetria.c
+ * @brief Codifica no host um lote de amostras do joystick com o codec do firmware
+ *
+ * Lê uma amostra por linha da entrada padrão ("seq t x y botão"), passa
+ * todas pelo codec_telemetria.c do rosa_dos_ventos e escreve o corpo do lote
+ * na saída padrão. O formato é o de TELEMETRIA_FORMATO na compilação; o
+ * número de amostras que couberam no lote vai para a saída de erro.
+ *
+ *     gcc -std=c11 -DTELEMETRIA_FORMATO=2 -Iferramentas/host \
+ *         -Irosa_dos_ventos/lib/codec_telemetria -Irosa_dos_ventos/lib/buffer_amostras \
+ *         -Irosa_dos_ventos/lib/joystick_driver ferramentas/codificar_lote_telemetria.c \
+ *         rosa_dos_ventos/lib/codec_telemetria/codec_telemetria.c -o /tmp/codificar_lote
+ *     printf '1 100 50 50 0\n2 150 52 49 1\n' | /tmp/codificar_lote [capacidade]
+ *
+ * Usado por ferramentas/teste_codec_telemetria.py.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "codec_telemetria.h"
+
+/** @brief Maior lote aceito, em bytes */
+#define CAPACIDADE_MAXIMA 4096
+
+int main(int argc, char **argv) {
+    static uint8_t corpo[CAPACIDADE_MAXIMA];
+    size_t capacidade = argc > 1 ? strtoul(argv[1], NULL, 0) : CAPACIDADE_MAXIMA;
+    if (capacidade < TELEMETRIA_TAMANHO_CABECALHO || capacidade > CAPACIDADE_MAXIMA) {
+        fprintf(stderr, "capacidade inválida (%d a %d bytes)\n", TELEMETRIA_TAMANHO_CABECALHO, CAPACIDADE_MAXIMA);
+        return 2;
+    }
+
+    CodificadorLote_t lote;
+    codec_telemetria_iniciar_lote(&lote, corpo, capacidade);
+
+    uint32_t sequencia, timestamp_ms;
+    int x, y, botao;
+    while (scanf("%" SCNu32 " %" SCNu32 " %d %d %d", &sequencia, &timestamp_ms, &x, &y, &botao) == 5) {
+        Amostra_t amostra = {
+            .sequencia = sequencia,
+            .timestamp_ms = timestamp_ms,
+            .estado = { .x_position = x, .y_position = y, .button_pressed = (uint8_t)botao },
+        };
+        if (!codec_telemetria_adicionar(&lote, &amostra)) {
+            break; // Como no cliente HTTP, o resto fica para o próximo lote
+        }
+    }
+
+    size_t tamanho = codec_telemetria_finalizar_lote(&lote);
+    fwrite(corpo, 1, tamanho, stdout);
+    fprintf(stderr, "%u\n", lote.quantidade);
+    return 0;
+}
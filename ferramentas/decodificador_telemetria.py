@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+"""Decodificador dos lotes de telemetria gerados por codec_telemetria.
+
+Entende os três formatos do firmware: JSON, binário de tamanho fixo
+(esquemas 0x01 e 0x02) e diferencial com varints (esquema 0x03). Pode ser
+importado (decodificar_lote) ou usado na linha de comando para converter
+um corpo capturado em JSON:
+
+    python3 decodificador_telemetria.py lote.bin
+    cat lote.bin | python3 decodificador_telemetria.py
+
+Os layouts estão documentados em lib/codec_telemetria/codec_telemetria.h
+de cada projeto.
+"""
+
+import json
+import struct
+import sys
+
+ESQUEMA_BOTOES = 0x01
+ESQUEMA_JOYSTICK = 0x02
+ESQUEMA_JOYSTICK_DELTA = 0x03
+
+TAMANHO_CABECALHO = 3
+
+# Layout dos registros de tamanho fixo
+REGISTRO_BOTOES = struct.Struct("<IIBh")
+REGISTRO_JOYSTICK = struct.Struct("<IIBBB")
+
+
+def ler_varint(dados, posicao):
+    """Lê um varint LEB128 e retorna (valor, nova posição)."""
+    valor = 0
+    deslocamento = 0
+    while True:
+        if posicao >= len(dados) or deslocamento > 28:
+            raise ValueError("varint truncado ou longo demais")
+        byte = dados[posicao]
+        posicao += 1
+        valor |= (byte & 0x7F) << deslocamento
+        if not byte & 0x80:
+            return valor, posicao
+        deslocamento += 7
+
+
+def desfazer_zigzag(valor):
+    """Inverte o mapeamento zig-zag (0, 1, 2, 3, ... -> 0, -1, 1, -2, ...)."""
+    return (valor >> 1) ^ -(valor & 1)
+
+
+def amostra_joystick(seq, t, x, y, botao):
+    return {"seq": seq, "t": t, "x": x, "y": y, "button": botao}
+
+
+def decodificar_delta(corpo, quantidade):
+    """Decodifica as amostras de um lote diferencial (esquema 0x03)."""
+    if quantidade == 0:
+        return []
+    amostras = [amostra_joystick(*REGISTRO_JOYSTICK.unpack_from(corpo, TAMANHO_CABECALHO))]
+    posicao = TAMANHO_CABECALHO + REGISTRO_JOYSTICK.size
+    for _ in range(quantidade - 1):
+        anterior = amostras[-1]
+        deltas = []
+        for _ in range(5):
+            valor, posicao = ler_varint(corpo, posicao)
+            deltas.append(desfazer_zigzag(valor))
+        amostras.append(amostra_joystick((anterior["seq"] + deltas[0]) & 0xFFFFFFFF,
+                                         (anterior["t"] + deltas[1]) & 0xFFFFFFFF,
+                                         anterior["x"] + deltas[2],
+                                         anterior["y"] + deltas[3],
+                                         anterior["button"] + deltas[4]))
+    if posicao != len(corpo):
+        raise ValueError(f"{len(corpo) - posicao} bytes sobrando no fim do lote")
+    return amostras
+
+
+def decodificar_lote(corpo):
+    """Decodifica um lote em uma lista de dicionários, no mesmo formato do JSON."""
+    if corpo[:1] == b"[":
+        return json.loads(corpo.decode("utf-8"))
+
+    esquema, quantidade = struct.unpack_from("<BH", corpo, 0)
+    if esquema == ESQUEMA_JOYSTICK_DELTA:
+        return decodificar_delta(corpo, quantidade)
+
+    amostras = []
+    if esquema == ESQUEMA_JOYSTICK:
+        for i in range(quantidade):
+            campos = REGISTRO_JOYSTICK.unpack_from(corpo, TAMANHO_CABECALHO + i * REGISTRO_JOYSTICK.size)
+            amostras.append(amostra_joystick(*campos))
+    elif esquema == ESQUEMA_BOTOES:
+        for i in range(quantidade):
+            seq, t, flags, centi_graus = REGISTRO_BOTOES.unpack_from(
+                corpo, TAMANHO_CABECALHO + i * REGISTRO_BOTOES.size)
+            amostras.append({"seq": seq, "t": t, "button_a": flags & 1, "button_b": (flags >> 1) & 1,
+                             "temperature": centi_graus / 100.0})
+    else:
+        raise ValueError(f"esquema desconhecido 0x{esquema:02x}")
+    return amostras
+
+
+def main():
+    if len(sys.argv) > 1:
+        with open(sys.argv[1], "rb") as arquivo:
+            corpo = arquivo.read()
+    else:
+        corpo = sys.stdin.buffer.read()
+    print(json.dumps(decodificar_lote(corpo), indent=2))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,166 @@
+/**
+ * @file estresse_anel_spsc.c
+ * @brief Teste de estresse do anel SPSC no host, com duas threads
+ *
+ * Compila o próprio anel_spsc.c do firmware. Uma thread produz elementos
+ * numerados e a outra os consome dormindo num semáforo, que o aviso do
+ * anel incrementa como o xTaskNotifyGive() do firmware. O teste falha se
+ * um elemento chega fora de ordem, corrompido ou não chega, e também se o
+ * consumidor fica sem aviso com elementos no anel (aviso perdido).
+ *
+ *     gcc -O2 -pthread -Ibutoes/lib/anel_spsc ferramentas/estresse_anel_spsc.c \
+ *         butoes/lib/anel_spsc/anel_spsc.c -o /tmp/estresse_anel_spsc
+ *     /tmp/estresse_anel_spsc [elementos] [capacidade]
+ *
+ * O produtor alterna rajadas com pausas curtas, para que o anel passe
+ * muitas vezes por vazio e por cheio.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "anel_spsc.h"
+
+/** @brief Maior capacidade aceita na linha de comando */
+#define CAPACIDADE_MAXIMA 4096
+
+/** @brief Tempo, em ms, que o consumidor espera um aviso antes de conferir o anel */
+#define ESPERA_AVISO_MS 1000
+
+/** @brief Elemento de teste, do tamanho de uma Amostra_t do firmware */
+typedef struct {
+    uint32_t sequencia;
+    uint32_t complemento; /**< ~sequencia, para detectar cópia pela metade */
+    uint32_t carga[4];
+} Elemento_t;
+
+static Elemento_t armazenamento[CAPACIDADE_MAXIMA];
+static AnelSpsc_t anel;
+static sem_t semaforo_aviso;
+static atomic_uint_least32_t avisos = 0;
+static uint32_t total_elementos;
+static atomic_bool consumidor_falhou = false;
+
+/**
+ * @brief Aviso do anel: acorda o consumidor.
+ */
+static void avisar_consumidor(void) {
+    atomic_fetch_add_explicit(&avisos, 1, memory_order_relaxed);
+    sem_post(&semaforo_aviso);
+}
+
+/**
+ * @brief Gerador pseudoaleatório simples (xorshift32) para as rajadas.
+ */
+static uint32_t sortear(uint32_t *estado) {
+    uint32_t x = *estado;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *estado = x;
+}
+
+/**
+ * @brief Produz os elementos em ordem; com o anel cheio, tenta de novo.
+ */
+static void *produtor(void *arg) {
+    uint32_t semente = 0x12345678u;
+    uint32_t sequencia = 0;
+    while (sequencia < total_elementos) {
+        uint32_t rajada = sortear(&semente) % 64 + 1;
+        for (uint32_t i = 0; i < rajada && sequencia < total_elementos; i++) {
+            Elemento_t elemento = { .sequencia = sequencia, .complemento = ~sequencia };
+            for (int j = 0; j < 4; j++) {
+                elemento.carga[j] = sequencia * 2654435761u + (uint32_t)j;
+            }
+            while (!anel_spsc_inserir(&anel, &elemento)) {
+                if (atomic_load(&consumidor_falhou)) {
+                    return NULL;
+                }
+                sched_yield();
+            }
+            sequencia++;
+        }
+        if (sortear(&semente) % 4 == 0) {
+            struct timespec pausa = { 0, (long)(sortear(&semente) % 20000) };
+            nanosleep(&pausa, NULL);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Consome até o último elemento, conferindo ordem e conteúdo.
+ * @return NULL se tudo chegou, ou a mensagem do primeiro erro
+ */
+static void *consumidor(void *arg) {
+    uint32_t esperado = 0;
+    Elemento_t elemento;
+    while (esperado < total_elementos) {
+        while (anel_spsc_remover(&anel, &elemento)) {
+            if (elemento.sequencia != esperado) {
+                fprintf(stderr, "fora de ordem: esperado %" PRIu32 ", recebido %" PRIu32 "\n",
+                        esperado, elemento.sequencia);
+                return "ordem";
+            }
+            if (elemento.complemento != ~elemento.sequencia ||
+                elemento.carga[3] != elemento.sequencia * 2654435761u + 3u) {
+                fprintf(stderr, "elemento %" PRIu32 " corrompido\n", elemento.sequencia);
+                return "conteúdo";
+            }
+            esperado++;
+        }
+        if (esperado == total_elementos) {
+            break;
+        }
+
+        // Anel vazio: dorme até o aviso, como a task de Wi-Fi
+        struct timespec prazo;
+        clock_gettime(CLOCK_REALTIME, &prazo);
+        prazo.tv_sec += ESPERA_AVISO_MS / 1000;
+        if (sem_timedwait(&semaforo_aviso, &prazo) != 0 && errno == ETIMEDOUT &&
+            anel_spsc_tamanho(&anel) > 0) {
+            fprintf(stderr, "aviso perdido: %" PRIu32 " elementos no anel sem aviso\n",
+                    anel_spsc_tamanho(&anel));
+            return "aviso";
+        }
+    }
+    return NULL;
+}
+
+int main(int argc, char **argv) {
+    total_elementos = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 0) : 10000000u;
+    uint32_t capacidade = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 0) : 32u;
+    if (capacidade > CAPACIDADE_MAXIMA ||
+        !anel_spsc_init(&anel, armazenamento, sizeof(Elemento_t), capacidade, avisar_consumidor)) {
+        fprintf(stderr, "capacidade inválida: use uma potência de 2 até %d\n", CAPACIDADE_MAXIMA);
+        return 2;
+    }
+    sem_init(&semaforo_aviso, 0, 0);
+
+    pthread_t thread_produtor, thread_consumidor;
+    void *erro;
+    pthread_create(&thread_consumidor, NULL, consumidor, NULL);
+    pthread_create(&thread_produtor, NULL, produtor, NULL);
+    pthread_join(thread_consumidor, &erro);
+    if (erro != NULL) {
+        atomic_store(&consumidor_falhou, true);
+    }
+    pthread_join(thread_produtor, NULL);
+
+    if (erro != NULL) {
+        printf("FALHOU (%s)\n", (const char *)erro);
+        return 1;
+    }
+    printf("OK: %" PRIu32 " elementos em ordem, capacidade %" PRIu32 ", %" PRIu32 " avisos, "
+           "%" PRIu32 " recusas com o anel cheio\n",
+           total_elementos, capacidade, (uint32_t)atomic_load(&avisos), anel.descartados);
+    return 0;
+}
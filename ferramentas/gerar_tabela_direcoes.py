@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+"""Gera as tabelas de decodificação de direção do joystick (tabela_direcoes.h).
+
+O firmware da Rosa dos Ventos recebe X e Y já calibrados, centrados em zero
+e na faixa -127..127. Com o valor absoluto de cada eixo reduzido a
+RESOLUCAO passos, duas tabelas do primeiro quadrante dão o ângulo (em
+1/256 de volta) e a magnitude (em % da deflexão total); uma terceira tabela
+leva o ângulo ao setor, para 8 ou 16 direções. Assim a decodificação não
+faz atan2, raiz nem divisão em tempo de execução.
+
+O arquivo gerado é versionado; rode de novo só ao mudar os parâmetros:
+
+    python3 ferramentas/gerar_tabela_direcoes.py \\
+        > rosa_dos_ventos/lib/direcao_joystick/tabela_direcoes.h
+"""
+
+import argparse
+import math
+import sys
+
+# Passos por eixo nas tabelas do quadrante (o índice é |eixo| >> DESLOCAMENTO)
+RESOLUCAO = 64
+EIXO_MAXIMO = 127
+DESLOCAMENTO = 1
+
+PASSOS_POR_VOLTA = 256
+
+
+def angulo_quadrante(i, j):
+    """Ângulo, em 1/256 de volta, do centro da célula (i, j) do quadrante."""
+    x = (i << DESLOCAMENTO) + ((1 << DESLOCAMENTO) - 1) / 2
+    y = (j << DESLOCAMENTO) + ((1 << DESLOCAMENTO) - 1) / 2
+    return round(math.atan2(y, x) * PASSOS_POR_VOLTA / (2 * math.pi))
+
+
+def magnitude_quadrante(i, j):
+    """Magnitude, em % da deflexão total e limitada a 100, do centro da célula (i, j)."""
+    x = (i << DESLOCAMENTO) + ((1 << DESLOCAMENTO) - 1) / 2
+    y = (j << DESLOCAMENTO) + ((1 << DESLOCAMENTO) - 1) / 2
+    return min(100, round(math.hypot(x, y) * 100 / EIXO_MAXIMO))
+
+
+def setor(angulo, setores):
+    """Setor (0 = leste, sentido anti-horário) que contém o ângulo."""
+    largura = PASSOS_POR_VOLTA / setores
+    return int((angulo + largura / 2) // largura) % setores
+
+
+def formatar_tabela(nome, linhas, tipo="uint8_t"):
+    """Formata uma tabela C de uma ou duas dimensões."""
+    saida = []
+    if isinstance(linhas[0], list):
+        saida.append(f"static const {tipo} {nome}[{len(linhas)}][{len(linhas[0])}] = {{")
+        for linha in linhas:
+            saida.append("    {" + ", ".join(str(v) for v in linha) + "},")
+    else:
+        saida.append(f"static const {tipo} {nome}[{len(linhas)}] = {{")
+        for inicio in range(0, len(linhas), 16):
+            saida.append("    " + ", ".join(str(v) for v in linhas[inicio:inicio + 16]) + ",")
+    saida.append("};")
+    return "\n".join(saida)
+
+
+def gerar():
+    angulos = [[angulo_quadrante(i, j) for j in range(RESOLUCAO)] for i in range(RESOLUCAO)]
+    magnitudes = [[magnitude_quadrante(i, j) for j in range(RESOLUCAO)] for i in range(RESOLUCAO)]
+    setores_8 = [setor(a, 8) for a in range(PASSOS_POR_VOLTA)]
+    setores_16 = [setor(a, 16) for a in range(PASSOS_POR_VOLTA)]
+
+    return f"""/**
+ * @file tabela_direcoes.h
+ * @brief Tabelas de decodificação de direção do joystick
+ *
+ * Arquivo gerado por ferramentas/gerar_tabela_direcoes.py; não editar à mão.
+ *
+ * As tabelas do quadrante são indexadas por [|x| >> TABELA_DIRECOES_DESLOCAMENTO]
+ * [|y| >> TABELA_DIRECOES_DESLOCAMENTO], com x e y calibrados em
+ * -{EIXO_MAXIMO}..{EIXO_MAXIMO}. As tabelas de setor são indexadas pelo ângulo em
+ * 1/{PASSOS_POR_VOLTA} de volta e devolvem o setor contado a partir do leste, no
+ * sentido anti-horário.
+ */
+
+#ifndef TABELA_DIRECOES_H
+#define TABELA_DIRECOES_H
+
+#include <stdint.h>
+
+/** @brief Passos por eixo nas tabelas do quadrante */
+#define TABELA_DIRECOES_RESOLUCAO {RESOLUCAO}
+
+/** @brief Deslocamento que leva |eixo| (0-{EIXO_MAXIMO}) ao índice das tabelas do quadrante */
+#define TABELA_DIRECOES_DESLOCAMENTO {DESLOCAMENTO}
+
+/** @brief Ângulo no primeiro quadrante, em 1/{PASSOS_POR_VOLTA} de volta (0 = eixo X, {PASSOS_POR_VOLTA // 4} = eixo Y) */
+{formatar_tabela("TABELA_ANGULO_QUADRANTE", angulos)}
+
+/** @brief Magnitude no primeiro quadrante, em % da deflexão total (limitada a 100) */
+{formatar_tabela("TABELA_MAGNITUDE_QUADRANTE", magnitudes)}
+
+/** @brief Setor de cada ângulo com 8 direções */
+{formatar_tabela("TABELA_SETOR_8", setores_8)}
+
+/** @brief Setor de cada ângulo com 16 direções */
+{formatar_tabela("TABELA_SETOR_16", setores_16)}
+
+#endif // TABELA_DIRECOES_H
+"""
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("-o", "--saida", help="arquivo de saída (padrão: saída padrão)")
+    args = parser.parse_args()
+
+    conteudo = gerar()
+    if args.saida:
+        with open(args.saida, "w", encoding="utf-8") as arquivo:
+            arquivo.write(conteudo)
+    else:
+        sys.stdout.write(conteudo)
+
+
+if __name__ == "__main__":
+    main()
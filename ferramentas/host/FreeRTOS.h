@@ -0,0 +1,32 @@
+/**
+ * @file FreeRTOS.h
+ * @brief Substituto de FreeRTOS.h para compilar no host (tipos e macros do porte)
+ */
+
+#ifndef INC_FREERTOS_H
+#define INC_FREERTOS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE ((BaseType_t)1)
+#define pdFAIL pdFALSE
+#define pdPASS pdTRUE
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFu)
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define tskIDLE_PRIORITY ((UBaseType_t)0)
+#define portYIELD_FROM_ISR(x) ((void)(x))
+#define portCHECK_IF_IN_ISR() 0
+
+// Com o config/ do projeto na linha de inclusão, as opções do kernel também valem
+#if __has_include("FreeRTOSConfig.h")
+#include "FreeRTOSConfig.h"
+#endif
+
+#endif // INC_FREERTOS_H
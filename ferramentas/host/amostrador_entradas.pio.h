@@ -0,0 +1,34 @@
+/**
+ * @file amostrador_entradas.pio.h
+ * @brief Substituto do cabeçalho que o pioasm gera de butoes/lib/buttons_driver/amostrador_entradas.pio
+ *
+ * Só os offsets públicos e o tamanho do programa, que precisam acompanhar o
+ * .pio; as instruções ficam zeradas, porque no host quem faz o papel do PIO
+ * é o programa de teste (ferramentas/modelo_amostrador_pio.py é quem
+ * interpreta o programa de verdade).
+ */
+
+#ifndef _AMOSTRADOR_ENTRADAS_PIO_H
+#define _AMOSTRADOR_ENTRADAS_PIO_H
+
+#include "hardware/pio.h"
+
+#define amostrador_entradas_offset_amostrar 0u
+#define amostrador_entradas_offset_leitura 1u
+#define amostrador_entradas_offset_confirmacao 14u
+
+static const uint16_t amostrador_entradas_program_instructions[30] = { 0 };
+
+static const pio_program_t amostrador_entradas_program = {
+    .instructions = amostrador_entradas_program_instructions,
+    .length = 30,
+    .origin = -1,
+};
+
+static inline pio_sm_config amostrador_entradas_program_get_default_config(uint offset) {
+    pio_sm_config config = { 0 };
+    (void)offset;
+    return config;
+}
+
+#endif // _AMOSTRADOR_ENTRADAS_PIO_H
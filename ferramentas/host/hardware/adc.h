@@ -0,0 +1,26 @@
+/**
+ * @file adc.h
+ * @brief Substituto de hardware/adc.h para compilar no host (só declarações)
+ */
+
+#ifndef _HARDWARE_ADC_H
+#define _HARDWARE_ADC_H
+
+#include "pico/stdlib.h"
+
+typedef struct {
+    volatile uint32_t fifo;
+} adc_hw_t;
+
+extern adc_hw_t *adc_hw;
+
+void adc_init(void);
+void adc_gpio_init(uint gpio);
+void adc_select_input(uint input);
+void adc_set_round_robin(uint input_mask);
+void adc_set_temp_sensor_enabled(bool enable);
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift);
+void adc_set_clkdiv(float clkdiv);
+void adc_run(bool run);
+
+#endif // _HARDWARE_ADC_H
@@ -0,0 +1,20 @@
+/**
+ * @file flash.h
+ * @brief Substituto de hardware/flash.h para compilar no host (só declarações)
+ */
+
+#ifndef _HARDWARE_FLASH_H
+#define _HARDWARE_FLASH_H
+
+#include "pico/stdlib.h"
+
+#define FLASH_PAGE_SIZE (1u << 8)
+#define FLASH_SECTOR_SIZE (1u << 12)
+#define PICO_FLASH_SIZE_BYTES (2 * 1024 * 1024)
+// Do tamanho de um ponteiro, para que (const void *)(XIP_BASE + ...) compile no host de 64 bits
+#define XIP_BASE ((uintptr_t)0x10000000u)
+
+void flash_range_erase(uint32_t flash_offs, size_t count);
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count);
+
+#endif // _HARDWARE_FLASH_H
@@ -0,0 +1,19 @@
+/**
+ * @file gpio.h
+ * @brief Substituto de hardware/gpio.h para compilar no host (só declarações)
+ */
+
+#ifndef _HARDWARE_GPIO_H
+#define _HARDWARE_GPIO_H
+
+#include "pico/stdlib.h"
+
+#define GPIO_IN false
+#define GPIO_OUT true
+
+void gpio_init(uint gpio);
+void gpio_set_dir(uint gpio, bool out);
+void gpio_pull_up(uint gpio);
+bool gpio_get(uint gpio);
+
+#endif // _HARDWARE_GPIO_H
@@ -0,0 +1,11 @@
+/**
+ * @file sync.h
+ * @brief Substituto de hardware/sync.h para compilar no host
+ */
+
+#ifndef _HARDWARE_SYNC_H
+#define _HARDWARE_SYNC_H
+
+#define __dmb() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+#endif // _HARDWARE_SYNC_H
@@ -0,0 +1,15 @@
+/**
+ * @file dns.h
+ * @brief Substituto de lwip/dns.h para compilar no host (só declarações)
+ */
+
+#ifndef LWIP_HDR_DNS_H
+#define LWIP_HDR_DNS_H
+
+#include "lwip/ip_addr.h"
+
+typedef void (*dns_found_callback)(const char *name, const ip_addr_t *ipaddr, void *callback_arg);
+
+err_t dns_gethostbyname(const char *hostname, ip_addr_t *addr, dns_found_callback found, void *callback_arg);
+
+#endif // LWIP_HDR_DNS_H
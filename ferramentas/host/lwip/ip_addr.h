@@ -0,0 +1,26 @@
+/**
+ * @file ip_addr.h
+ * @brief Substituto de lwip/ip_addr.h para compilar no host (só IPv4)
+ */
+
+#ifndef LWIP_HDR_IP_ADDR_H
+#define LWIP_HDR_IP_ADDR_H
+
+#include "lwip/err.h"
+
+typedef struct {
+    u32_t addr;
+} ip_addr_t;
+
+#define IPADDR_TYPE_V4 0U
+#define IP_ADDR_ANY ((ip_addr_t *)0)
+
+#define ip_addr_copy(dest, src) ((dest) = (src))
+#define ip_addr_set_zero(ipaddr) ((ipaddr)->addr = 0)
+#define ip_addr_cmp(addr1, addr2) ((addr1)->addr == (addr2)->addr)
+#define ip4_addr_get_u32(src_ipaddr) ((src_ipaddr)->addr)
+
+char *ipaddr_ntoa(const ip_addr_t *addr);
+int ipaddr_aton(const char *cp, ip_addr_t *addr);
+
+#endif // LWIP_HDR_IP_ADDR_H
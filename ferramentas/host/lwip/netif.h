@@ -0,0 +1,19 @@
+/**
+ * @file netif.h
+ * @brief Substituto de lwip/netif.h para compilar no host (só declarações)
+ */
+
+#ifndef LWIP_HDR_NETIF_H
+#define LWIP_HDR_NETIF_H
+
+#include "lwip/ip_addr.h"
+
+struct netif {
+    ip_addr_t ip_addr;
+};
+
+extern struct netif *netif_default;
+
+#define netif_ip4_addr(netif) ((const ip_addr_t *)&((netif)->ip_addr))
+
+#endif // LWIP_HDR_NETIF_H
@@ -0,0 +1,27 @@
+/**
+ * @file pbuf.h
+ * @brief Substituto de lwip/pbuf.h para compilar no host (só declarações)
+ */
+
+#ifndef LWIP_HDR_PBUF_H
+#define LWIP_HDR_PBUF_H
+
+#include "lwip/err.h"
+
+typedef enum { PBUF_TRANSPORT = 74, PBUF_IP = 54, PBUF_LINK = 14, PBUF_RAW = 0 } pbuf_layer;
+typedef enum { PBUF_RAM = 0x0280, PBUF_ROM = 0x0001, PBUF_REF = 0x0041, PBUF_POOL = 0x0182 } pbuf_type;
+
+struct pbuf {
+    struct pbuf *next;
+    void *payload;
+    u16_t tot_len;
+    u16_t len;
+};
+
+struct pbuf *pbuf_alloc(pbuf_layer l, u16_t length, pbuf_type type);
+void pbuf_realloc(struct pbuf *p, u16_t size);
+u8_t pbuf_free(struct pbuf *p);
+u16_t pbuf_copy_partial(const struct pbuf *p, void *dataptr, u16_t len, u16_t offset);
+err_t pbuf_take(struct pbuf *buf, const void *dataptr, u16_t len);
+
+#endif // LWIP_HDR_PBUF_H
@@ -0,0 +1,16 @@
+/**
+ * @file timeouts.h
+ * @brief Substituto de lwip/timeouts.h para compilar no host (só declarações)
+ */
+
+#ifndef LWIP_HDR_TIMEOUTS_H
+#define LWIP_HDR_TIMEOUTS_H
+
+#include "lwip/err.h"
+
+typedef void (*sys_timeout_handler)(void *arg);
+
+void sys_timeout(u32_t msecs, sys_timeout_handler handler, void *arg);
+void sys_untimeout(sys_timeout_handler handler, void *arg);
+
+#endif // LWIP_HDR_TIMEOUTS_H
@@ -0,0 +1,21 @@
+/**
+ * @file udp.h
+ * @brief Substituto de lwip/udp.h para compilar no host (só declarações)
+ */
+
+#ifndef LWIP_HDR_UDP_H
+#define LWIP_HDR_UDP_H
+
+#include "lwip/ip_addr.h"
+#include "lwip/pbuf.h"
+
+struct udp_pcb {
+    u16_t local_port;
+};
+
+struct udp_pcb *udp_new(void);
+struct udp_pcb *udp_new_ip_type(u8_t type);
+err_t udp_sendto(struct udp_pcb *pcb, struct pbuf *p, const ip_addr_t *dst_ip, u16_t dst_port);
+void udp_remove(struct udp_pcb *pcb);
+
+#endif // LWIP_HDR_UDP_H
@@ -0,0 +1,31 @@
+/**
+ * @file cyw43_arch.h
+ * @brief Substituto de pico/cyw43_arch.h para compilar no host (só declarações)
+ */
+
+#ifndef _PICO_CYW43_ARCH_H
+#define _PICO_CYW43_ARCH_H
+
+#include "pico/stdlib.h"
+
+#define CYW43_AUTH_WPA2_AES_PSK 0x00400004
+#define CYW43_ITF_STA 0
+#define CYW43_LINK_UP 3
+#define CYW43_AGGRESSIVE_PM 0x00210a1u
+
+typedef struct {
+    int itf_state;
+} cyw43_t;
+
+extern cyw43_t cyw43_state;
+
+int cyw43_arch_init(void);
+void cyw43_arch_enable_sta_mode(void);
+int cyw43_arch_wifi_connect_timeout_ms(const char *ssid, const char *pw, uint32_t auth, uint32_t timeout);
+void cyw43_arch_poll(void);
+void cyw43_arch_lwip_begin(void);
+void cyw43_arch_lwip_end(void);
+int cyw43_tcpip_link_status(cyw43_t *self, int itf);
+int cyw43_wifi_pm(cyw43_t *self, uint32_t pm);
+
+#endif // _PICO_CYW43_ARCH_H
@@ -0,0 +1,13 @@
+/**
+ * @file flash.h
+ * @brief Substituto de pico/flash.h para compilar no host (só declarações)
+ */
+
+#ifndef _PICO_FLASH_H
+#define _PICO_FLASH_H
+
+#include "pico/stdlib.h"
+
+int flash_safe_execute(void (*func)(void *), void *param, uint32_t enter_exit_timeout_ms);
+
+#endif // _PICO_FLASH_H
@@ -0,0 +1,14 @@
+/**
+ * @file multicore.h
+ * @brief Substituto de pico/multicore.h para compilar no host (só declarações)
+ */
+
+#ifndef _PICO_MULTICORE_H
+#define _PICO_MULTICORE_H
+
+#include "pico/stdlib.h"
+
+void multicore_launch_core1(void (*entry)(void));
+void multicore_lockout_victim_init(void);
+
+#endif // _PICO_MULTICORE_H
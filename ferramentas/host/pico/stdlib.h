@@ -0,0 +1,51 @@
+/**
+ * @file stdlib.h
+ * @brief Substituto de pico/stdlib.h para compilar no host, sem o Pico SDK
+ *
+ * Os módulos de lógica pura (log_flash, buffer_amostras, codec_telemetria,
+ * detector_mudanca...) só usam do SDK os tipos e macros abaixo. Basta pôr
+ * ferramentas/host antes dos diretórios do projeto na linha de inclusão.
+ * As funções, aqui e nos outros cabeçalhos deste diretório, são só
+ * declaradas: o programa de teste que as usa implementa o periférico
+ * simulado, e ferramentas/verificar_sintaxe.py nem chega a ligar.
+ */
+
+#ifndef _PICO_STDLIB_H
+#define _PICO_STDLIB_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+typedef unsigned int uint;
+
+#ifndef MIN
+#define MIN(a, b) ((b) < (a) ? (b) : (a))
+#endif
+
+#ifndef MAX
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+#endif
+
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+
+#define PICO_OK 0
+
+/** @brief Relógio */
+typedef uint64_t absolute_time_t;
+absolute_time_t get_absolute_time(void);
+uint32_t to_ms_since_boot(absolute_time_t t);
+uint64_t time_us_64(void);
+absolute_time_t make_timeout_time_ms(uint32_t ms);
+int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to);
+void sleep_ms(uint32_t ms);
+void tight_loop_contents(void);
+
+bool stdio_init_all(void);
+uint get_core_num(void);
+
+// Como no SDK, pico/stdlib.h também traz os GPIOs
+#include "hardware/gpio.h"
+
+#endif // _PICO_STDLIB_H
@@ -0,0 +1,11 @@
+/**
+ * @file timers.h
+ * @brief Substituto de timers.h do FreeRTOS para compilar no host
+ */
+
+#ifndef TIMERS_H
+#define TIMERS_H
+
+#include "FreeRTOS.h"
+
+#endif // TIMERS_H
@@ -0,0 +1,343 @@
+#!/usr/bin/env python3
+"""Modelo em software do amostrador de entradas em PIO (amostrador_entradas.pio).
+
+Interpreta o próprio arquivo .pio, instrução por instrução e ciclo a ciclo,
+com o subconjunto de instruções que o programa usa (mov, in, out, jmp, push,
+irq e set) e a mesma configuração que buttons.c aplica na carga: as
+instruções "in pins" reescritas para o número de pinos do bloco, limiar de
+OUT igual à janela de debounce e ISR deslocando para a esquerda. As palavras
+que sairiam na FIFO RX são decodificadas em eventos da mesma forma que o
+driver, com o instante da borda reconstruído a partir do contador de
+amostras.
+
+A entrada é um arquivo de trilha com uma mudança de nível por linha,
+"<instante em µs> <níveis dos pinos em binário, pino mais alto à esquerda>":
+
+    0     11
+    1000  10
+    1040  11
+    1090  10
+
+    python3 ferramentas/modelo_amostrador_pio.py trilha.txt
+    python3 ferramentas/modelo_amostrador_pio.py --palavras trilha.txt
+
+A trilha pode trazer os eventos esperados, um por linha,
+"evento <instante da borda em µs> <GPIO> pressionado|solto". Com
+--conferir, os eventos simulados são comparados com eles (a borda com
+tolerância de uma amostra) e o script termina com código 1 se alguma
+trilha divergir. As trilhas de ferramentas/trilhas_pio cobrem a partida,
+o ressalto dentro da janela, pulsos mais curtos que a janela e dois pinos
+mudando juntos:
+
+    python3 ferramentas/modelo_amostrador_pio.py --conferir ferramentas/trilhas_pio/*.txt
+
+Os valores padrão seguem butoes/lib/buttons_driver/buttons.h.
+"""
+
+import argparse
+import re
+import sys
+
+CAMINHO_PROGRAMA_PADRAO = "butoes/lib/buttons_driver/amostrador_entradas.pio"
+
+# Padrões de buttons.h
+PINO_BASE_PADRAO = 5
+NUM_PINOS_PADRAO = 2
+PERIODO_AMOSTRA_US_PADRAO = 250
+DEBOUNCE_AMOSTRAS_PADRAO = 20
+
+# Ciclos da máquina de estados por amostra no laço principal do programa
+CICLOS_POR_AMOSTRA = 7
+
+PROFUNDIDADE_FIFO_RX = 8  # FIFO RX unida à TX
+MASCARA_32 = 0xFFFFFFFF
+
+
+def ler_programa(caminho):
+    """Monta o programa: lista de (mnemônico, operandos, atraso), rótulos e wrap."""
+    instrucoes = []
+    rotulos = {}
+    wrap_target = 0
+    wrap = None
+    for linha in open(caminho, encoding="utf-8"):
+        linha = linha.split(";")[0].split("//")[0].strip()
+        if not linha or linha.startswith(".program"):
+            continue
+        if linha == ".wrap_target":
+            wrap_target = len(instrucoes)
+            continue
+        if linha == ".wrap":
+            wrap = len(instrucoes) - 1
+            continue
+        if linha.startswith("%") or linha.startswith("."):
+            continue
+        rotulo = re.match(r"^(?:public\s+)?(\w+):$", linha)
+        if rotulo:
+            rotulos[rotulo.group(1)] = len(instrucoes)
+            continue
+        atraso = 0
+        m = re.search(r"\[(\d+)\]\s*$", linha)
+        if m:
+            atraso = int(m.group(1))
+            linha = linha[:m.start()].strip()
+        partes = linha.split(None, 1)
+        operandos = [o.strip() for o in partes[1].split(",")] if len(partes) > 1 else []
+        instrucoes.append((partes[0], operandos, atraso))
+    if wrap is None:
+        wrap = len(instrucoes) - 1
+    return instrucoes, rotulos, wrap_target, wrap
+
+
+class MaquinaEstados:
+    """Uma máquina de estados do PIO, restrita ao que o amostrador usa."""
+
+    def __init__(self, programa, pino_base, num_pinos, limiar_out):
+        self.instrucoes, self.rotulos, self.wrap_target, self.wrap = programa
+        self.pino_base = pino_base
+        self.num_pinos = num_pinos
+        self.limiar_out = limiar_out
+        self.pc = self.wrap_target
+        self.x = 0
+        self.y = MASCARA_32  # buttons.c inicia Y com ~0
+        self.isr = 0
+        self.osr = 0
+        self.contagem_isr = 0
+        self.contagem_out = 32
+        self.atraso = 0
+        self.fifo_rx = []
+        self.irqs = 0
+
+    def _fonte(self, nome, gpio):
+        inverter = nome.startswith("~") or nome.startswith("!")
+        nome = nome.lstrip("~!")
+        if nome == "pins":
+            valor = ((gpio >> self.pino_base) | (gpio << (32 - self.pino_base))) & MASCARA_32
+        else:
+            valor = {"x": self.x, "y": self.y, "null": 0, "isr": self.isr, "osr": self.osr}[nome]
+        return (~valor & MASCARA_32) if inverter else valor
+
+    def _destino(self, nome, valor):
+        if nome == "x":
+            self.x = valor
+        elif nome == "y":
+            self.y = valor
+        elif nome == "isr":
+            self.isr = valor
+            self.contagem_isr = 0
+        elif nome == "osr":
+            self.osr = valor
+            self.contagem_out = 0
+        elif nome != "null":
+            raise ValueError("destino não modelado: " + nome)
+
+    def _condicao(self, condicao):
+        if condicao == "x!=y":
+            return self.x != self.y
+        if condicao == "!osre":
+            return self.contagem_out < self.limiar_out
+        if condicao in ("x--", "y--"):
+            registrador = condicao[0]
+            valor = getattr(self, registrador)
+            setattr(self, registrador, (valor - 1) & MASCARA_32)
+            return valor != 0
+        if condicao == "!x":
+            return self.x == 0
+        if condicao == "!y":
+            return self.y == 0
+        raise ValueError("condição não modelada: " + condicao)
+
+    def ciclo(self, gpio):
+        """Executa um ciclo com os GPIO no nível dado (bit n = GPIO n)."""
+        if self.atraso:
+            self.atraso -= 1
+            return
+        mnemonico, operandos, atraso = self.instrucoes[self.pc]
+        proximo = self.wrap_target if self.pc == self.wrap else self.pc + 1
+
+        if mnemonico == "mov":
+            self._destino(operandos[0], self._fonte(operandos[1], gpio))
+        elif mnemonico == "set":
+            self._destino(operandos[0], int(operandos[1]))
+        elif mnemonico == "in":
+            # "in pins" é reescrita na carga com o número de pinos do bloco
+            bits = self.num_pinos if operandos[0] == "pins" else int(operandos[1])
+            mascara = (1 << bits) - 1
+            self.isr = ((self.isr << bits) | (self._fonte(operandos[0], gpio) & mascara)) & MASCARA_32
+            self.contagem_isr = min(32, self.contagem_isr + bits)
+        elif mnemonico == "out":
+            bits = int(operandos[1])
+            dado = self.osr & ((1 << bits) - 1)
+            self.osr >>= bits
+            self.contagem_out = min(32, self.contagem_out + bits)
+            self._destino(operandos[0], dado)
+        elif mnemonico == "jmp":
+            if len(operandos) == 1 and " " in operandos[0]:
+                condicao, alvo = operandos[0].split()
+            elif len(operandos) == 1:
+                condicao, alvo = None, operandos[0]
+            else:
+                raise ValueError("jmp mal formado")
+            if condicao is None or self._condicao(condicao):
+                proximo = self.rotulos[alvo]
+        elif mnemonico == "push":
+            if len(self.fifo_rx) >= PROFUNDIDADE_FIFO_RX:
+                if operandos and operandos[0] == "noblock":
+                    self.isr = 0
+                    self.contagem_isr = 0
+                    self.pc = proximo
+                # Bloqueado: repete a instrução no próximo ciclo, sem atraso
+                return
+            self.fifo_rx.append(self.isr)
+            self.isr = 0
+            self.contagem_isr = 0
+        elif mnemonico == "irq":
+            self.irqs += 1
+        else:
+            raise ValueError("instrução não modelada: " + mnemonico)
+
+        self.pc = proximo
+        self.atraso = atraso
+
+
+def ler_trilha(caminho):
+    """Lê a trilha: lista de (instante em µs, níveis dos pinos) e lista de eventos esperados."""
+    arquivo = sys.stdin if caminho == "-" else open(caminho, encoding="utf-8")
+    trilha = []
+    esperados = []
+    for linha in arquivo:
+        linha = linha.split("#")[0].strip()
+        if not linha:
+            continue
+        campos = linha.split()
+        if campos[0] == "evento":
+            if len(campos) != 4 or campos[3] not in ("pressionado", "solto"):
+                raise ValueError("evento mal formado: " + linha)
+            esperados.append({"pino": int(campos[2]), "pressionado": campos[3] == "pressionado",
+                              "borda_us": float(campos[1])})
+            continue
+        instante, niveis = campos
+        trilha.append((float(instante), int(niveis, 2)))
+    trilha.sort()
+    return trilha, esperados
+
+
+def simular(programa, trilha, pino_base, num_pinos, periodo_us, debounce_amostras, duracao_us):
+    """Roda o programa sobre a trilha e retorna as palavras que iriam para a FIFO RX."""
+    maquina = MaquinaEstados(programa, pino_base, num_pinos, debounce_amostras)
+    microssegundos_por_ciclo = periodo_us / CICLOS_POR_AMOSTRA
+    palavras = []
+    indice = 0
+    niveis = 0
+    ciclos = int(duracao_us / microssegundos_por_ciclo)
+    for ciclo in range(ciclos):
+        agora_us = ciclo * microssegundos_por_ciclo
+        while indice < len(trilha) and trilha[indice][0] <= agora_us:
+            niveis = trilha[indice][1]
+            indice += 1
+        maquina.ciclo(niveis << pino_base)
+        # O DMA esvazia a FIFO assim que as palavras chegam
+        palavras.extend(maquina.fifo_rx)
+        maquina.fifo_rx.clear()
+    return palavras
+
+
+def decodificar(palavras, pino_base, num_pinos, periodo_us, debounce_amostras):
+    """Converte os pares (estado, contador) em eventos por pino, como buttons.c.
+
+    O estado inicial do driver é zero (todos os pinos em nível baixo, ou
+    seja, pressionados), o mesmo valor de X na partida da máquina.
+    """
+    eventos = []
+    entregue = 0
+    mascara = (1 << num_pinos) - 1
+    amostras_alto = 0
+    ultimo_contador = 0
+    for i in range(0, len(palavras) - 1, 2):
+        estado = palavras[i] & mascara
+        amostras = MASCARA_32 - palavras[i + 1]
+        if amostras < ultimo_contador:
+            amostras_alto += 1 << 32
+        ultimo_contador = amostras
+        borda_us = (amostras_alto + amostras - debounce_amostras - 1) * periodo_us
+        diferenca = estado ^ entregue
+        while diferenca:
+            bit = (diferenca & -diferenca).bit_length() - 1
+            diferenca &= diferenca - 1
+            eventos.append({
+                "pino": pino_base + bit,
+                "pressionado": not (estado >> bit) & 1,
+                "borda_us": borda_us,
+            })
+        entregue = estado
+    return eventos
+
+
+def conferir(eventos, esperados, periodo_us):
+    """Compara os eventos simulados com os esperados e retorna a lista de divergências."""
+    divergencias = []
+    for i in range(max(len(eventos), len(esperados))):
+        obtido = eventos[i] if i < len(eventos) else None
+        esperado = esperados[i] if i < len(esperados) else None
+        if (obtido is None or esperado is None or obtido["pino"] != esperado["pino"]
+                or obtido["pressionado"] != esperado["pressionado"]
+                or abs(obtido["borda_us"] - esperado["borda_us"]) > periodo_us):
+            divergencias.append("evento %d: esperado %s, obtido %s" % (
+                i, formatar_evento(esperado) if esperado else "nenhum",
+                formatar_evento(obtido) if obtido else "nenhum"))
+    return divergencias
+
+
+def formatar_evento(evento):
+    return "%10d us  GPIO %2d  %s" % (evento["borda_us"], evento["pino"],
+                                      "pressionado" if evento["pressionado"] else "solto")
+
+
+def main():
+    analisador = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    analisador.add_argument("trilhas", nargs="+", help="arquivos de trilha de níveis ('-' para stdin)")
+    analisador.add_argument("--programa", default=CAMINHO_PROGRAMA_PADRAO)
+    analisador.add_argument("--pino-base", type=int, default=PINO_BASE_PADRAO)
+    analisador.add_argument("--num-pinos", type=int, default=NUM_PINOS_PADRAO)
+    analisador.add_argument("--periodo-us", type=int, default=PERIODO_AMOSTRA_US_PADRAO)
+    analisador.add_argument("--debounce-amostras", type=int, default=DEBOUNCE_AMOSTRAS_PADRAO)
+    analisador.add_argument("--margem-us", type=float, default=20000,
+                            help="tempo simulado depois da última mudança")
+    analisador.add_argument("--palavras", action="store_true",
+                            help="mostra também as palavras cruas da FIFO RX")
+    analisador.add_argument("--conferir", action="store_true",
+                            help="compara com os eventos esperados de cada trilha e sai com 1 se divergirem")
+    args = analisador.parse_args()
+
+    if not 1 <= args.debounce_amostras <= 32:
+        analisador.error("a janela de debounce vai de 1 a 32 amostras (limiar de OUT)")
+
+    programa = ler_programa(args.programa)
+    falhas = 0
+    for caminho in args.trilhas:
+        trilha, esperados = ler_trilha(caminho)
+        duracao_us = (trilha[-1][0] if trilha else 0) + args.margem_us
+        palavras = simular(programa, trilha, args.pino_base, args.num_pinos,
+                           args.periodo_us, args.debounce_amostras, duracao_us)
+        eventos = decodificar(palavras, args.pino_base, args.num_pinos,
+                              args.periodo_us, args.debounce_amostras)
+
+        if args.conferir:
+            divergencias = conferir(eventos, esperados, args.periodo_us)
+            print("%s: %s" % (caminho, "FALHOU" if divergencias else "OK (%d eventos)" % len(eventos)))
+            for divergencia in divergencias:
+                print("    " + divergencia)
+            falhas += bool(divergencias)
+            continue
+
+        if len(args.trilhas) > 1:
+            print("== " + caminho)
+        if args.palavras:
+            for i in range(0, len(palavras) - 1, 2):
+                print("estado=0x%08x contador=0x%08x" % (palavras[i], palavras[i + 1]))
+        for evento in eventos:
+            print(formatar_evento(evento))
+    return 1 if falhas else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
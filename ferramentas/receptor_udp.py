@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+"""Receptor de teste para o transporte UDP de telemetria.
+
+Escuta os datagramas enviados por rosa_dos_ventos compilado com
+TRANSPORTE_TELEMETRIA=TRANSPORTE_UDP, decodifica as amostras com
+decodificador_telemetria.py (qualquer TELEMETRIA_FORMATO) e usa o número
+de sequência para medir perda, duplicação e reordenação.
+
+Uso:
+    python3 receptor_udp.py [--porta 5005] [--silencioso]
+
+O formato do datagrama está documentado em
+rosa_dos_ventos/lib/udp_client_module/cliente_udp.h.
+"""
+
+import argparse
+import socket
+import struct
+import time
+
+from decodificador_telemetria import decodificar_lote
+
+VERSAO_PROTOCOLO = 1
+TAMANHO_CABECALHO = 5
+
+
+class MedidorPerda:
+    """Contabiliza datagramas recebidos, perdidos, duplicados e fora de ordem."""
+
+    def __init__(self):
+        self.maior_sequencia = None
+        self.vistos = set()
+        self.recebidos = 0
+        self.duplicados = 0
+        self.fora_de_ordem = 0
+        self.amostras = 0
+
+    def registrar(self, sequencia, quantidade_amostras):
+        if sequencia in self.vistos:
+            self.duplicados += 1
+            return
+        self.vistos.add(sequencia)
+        self.recebidos += 1
+        self.amostras += quantidade_amostras
+        if self.maior_sequencia is None or sequencia > self.maior_sequencia:
+            self.maior_sequencia = sequencia
+        else:
+            self.fora_de_ordem += 1
+
+    def perdidos(self):
+        if self.maior_sequencia is None:
+            return 0
+        esperados = self.maior_sequencia - min(self.vistos) + 1
+        return esperados - self.recebidos
+
+    def resumo(self):
+        perdidos = self.perdidos()
+        total = self.recebidos + perdidos
+        taxa = (100.0 * perdidos / total) if total else 0.0
+        return (f"datagramas={self.recebidos} amostras={self.amostras} "
+                f"perdidos={perdidos} ({taxa:.2f}%) duplicados={self.duplicados} "
+                f"fora_de_ordem={self.fora_de_ordem}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--porta", type=int, default=5005)
+    parser.add_argument("--silencioso", action="store_true",
+                        help="não imprime as amostras, apenas o resumo")
+    args = parser.parse_args()
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind(("0.0.0.0", args.porta))
+    sock.settimeout(1.0)
+    print(f"Aguardando datagramas na porta UDP {args.porta}...")
+
+    medidor = MedidorPerda()
+    ultimo_resumo = time.monotonic()
+    try:
+        while True:
+            try:
+                dados, origem = sock.recvfrom(2048)
+            except socket.timeout:
+                dados = None
+
+            if dados:
+                if len(dados) < TAMANHO_CABECALHO or dados[0] != VERSAO_PROTOCOLO:
+                    print(f"Datagrama inválido de {origem[0]} ({len(dados)} bytes)")
+                else:
+                    (sequencia,) = struct.unpack_from("<I", dados, 1)
+                    try:
+                        amostras = decodificar_lote(dados[TAMANHO_CABECALHO:])
+                    except (ValueError, struct.error) as erro:
+                        print(f"Seq {sequencia}: lote inválido ({erro})")
+                        amostras = []
+                    medidor.registrar(sequencia, len(amostras))
+                    if not args.silencioso:
+                        for amostra in amostras:
+                            print(f"seq={sequencia} {amostra}")
+
+            if time.monotonic() - ultimo_resumo >= 5.0:
+                print(medidor.resumo())
+                ultimo_resumo = time.monotonic()
+    except KeyboardInterrupt:
+        pass
+    print(medidor.resumo())
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+"""Teste de ida e volta do codec de telemetria do rosa_dos_ventos.
+
+Compila codec_telemetria.c do firmware no host, uma vez para cada formato
+(JSON, binário e diferencial), junto com codificar_lote_telemetria.c e o
+substituto de pico/stdlib.h em ferramentas/host. Cada caso é codificado
+pelo firmware e decodificado por decodificar_lote(); o teste falha (código
+de saída diferente de zero) se alguma amostra não voltar igual.
+
+    python3 ferramentas/teste_codec_telemetria.py
+
+Os casos cobrem a sequência e o timestamp dando a volta em 2^32, saltos de
+eixo de uma ponta à outra, lotes vazios e de uma amostra, e lotes cortados
+por falta de espaço, que precisam continuar decodificáveis.
+"""
+
+import os
+import subprocess
+import sys
+import tempfile
+
+from decodificador_telemetria import decodificar_lote
+
+RAIZ = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+PROJETO = os.path.join(RAIZ, "rosa_dos_ventos", "lib")
+
+FORMATOS = {"json": 0, "binario": 1, "delta": 2}
+
+VOLTA = 1 << 32
+
+
+def compilar(formato, diretorio):
+    """Compila o codificador no formato pedido e retorna o caminho do executável."""
+    executavel = os.path.join(diretorio, f"codificar_{formato}")
+    subprocess.run(["gcc", "-std=c11", "-Wall", f"-DTELEMETRIA_FORMATO={FORMATOS[formato]}",
+                    "-I" + os.path.join(RAIZ, "ferramentas", "host"),
+                    "-I" + os.path.join(PROJETO, "codec_telemetria"),
+                    "-I" + os.path.join(PROJETO, "buffer_amostras"),
+                    "-I" + os.path.join(PROJETO, "joystick_driver"),
+                    os.path.join(RAIZ, "ferramentas", "codificar_lote_telemetria.c"),
+                    os.path.join(PROJETO, "codec_telemetria", "codec_telemetria.c"),
+                    "-o", executavel], check=True)
+    return executavel
+
+
+def codificar(executavel, amostras, capacidade=None):
+    """Codifica as amostras com o firmware e retorna (corpo, amostras que couberam)."""
+    entrada = "".join(f"{a['seq']} {a['t']} {a['x']} {a['y']} {a['button']}\n" for a in amostras)
+    argumentos = [executavel] + ([str(capacidade)] if capacidade is not None else [])
+    saida = subprocess.run(argumentos, input=entrada.encode(), capture_output=True, check=True)
+    return saida.stdout, int(saida.stderr)
+
+
+def amostra(seq, t, x, y, botao):
+    return {"seq": seq % VOLTA, "t": t % VOLTA, "x": x, "y": y, "button": botao}
+
+
+def casos():
+    """Lotes de teste: nome -> lista de amostras."""
+    tipico = [amostra(1000 + i, 5000 + 50 * i, 50 + i % 3, 50 - i % 2, (i // 4) & 1) for i in range(16)]
+    volta = [amostra(VOLTA - 3 + i, VOLTA - 100 + 60 * i, 100 - 10 * i, 10 * i, i & 1) for i in range(6)]
+    extremos = [amostra(7, 0, 0, 100, 0), amostra(8, 1, 100, 0, 1), amostra(9, 2, 0, 100, 0),
+                amostra(20, 90000, 100, 100, 1), amostra(0, VOLTA - 1, 0, 0, 0)]
+    return {
+        "vazio": [],
+        "uma amostra": [amostra(VOLTA - 1, VOLTA - 1, 100, 0, 1)],
+        "típico": tipico,
+        "volta em 2^32": volta,
+        "saltos e retrocessos": extremos,
+    }
+
+
+def conferir(formato, executavel):
+    """Confere todos os casos em um formato; retorna o número de falhas."""
+    falhas = 0
+    for nome, amostras in casos().items():
+        corpo, quantidade = codificar(executavel, amostras)
+        decodificadas = decodificar_lote(corpo)
+        if quantidade != len(amostras) or decodificadas != amostras:
+            print(f"FALHOU {formato}/{nome}: esperado {amostras}, decodificado {decodificadas}")
+            falhas += 1
+
+    # Lote cortado: o que coube sai inteiro e o corpo termina exatamente no fim do lote
+    amostras = casos()["volta em 2^32"]
+    completo, _ = codificar(executavel, amostras)
+    for capacidade in range(len(completo) - 1, 2, -1):
+        corpo, quantidade = codificar(executavel, amostras, capacidade)
+        if len(corpo) > capacidade or decodificar_lote(corpo) != amostras[:quantidade]:
+            print(f"FALHOU {formato}/cortado em {capacidade} bytes: {quantidade} amostras")
+            falhas += 1
+    return falhas
+
+
+def main():
+    falhas = 0
+    with tempfile.TemporaryDirectory() as diretorio:
+        for formato in FORMATOS:
+            executavel = compilar(formato, diretorio)
+            falhas_formato = conferir(formato, executavel)
+            print(f"{formato}: {'OK' if falhas_formato == 0 else f'{falhas_formato} falhas'}")
+            falhas += falhas_formato
+    return 1 if falhas else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,174 @@
+/**
+ * @file teste_detector_mudanca.c
+ * @brief Teste do detector de mudança no host, com as configurações dos firmwares
+ *
+ * Alimenta o detector_mudanca.c do firmware com sequências de leituras a
+ * cada 50 ms (o INTERVALO_AMOSTRAGEM_MS do rosa_dos_ventos) e confere em que
+ * leituras ele aceita mudança.
+ *
+ *     gcc -std=c11 -Wall -Iferramentas/host -Irosa_dos_ventos/lib/detector_mudanca \
+ *         ferramentas/teste_detector_mudanca.c rosa_dos_ventos/lib/detector_mudanca/detector_mudanca.c \
+ *         -o /tmp/teste_detector_mudanca
+ *     /tmp/teste_detector_mudanca
+ *
+ * Cobre o ruído de 49 a 52 com o eixo parado em 50, o degrau para 60, a
+ * volta para a banda no meio do debounce, a permanência mínima da
+ * temperatura do butoes, o botão sem atraso e o relógio dando a volta em
+ * 2^32 ms no meio do debounce.
+ */
+
+#undef NDEBUG
+
+#include <assert.h>
+#include <stdio.h>
+#include "detector_mudanca.h"
+
+/** @brief Período de amostragem usado em todas as sequências */
+#define PERIODO_MS 50
+
+/** @brief Mesmos valores de CONFIG_DETECTOR_EIXO em rosa_dos_ventos/src/app_main.c */
+static const ConfigDetector_t CONFIG_EIXO = { .banda = 2, .debounce_ms = 100, .permanencia_minima_ms = 0 };
+
+/** @brief Mesmos valores de CONFIG_DETECTOR_BOTAO em rosa_dos_ventos/src/app_main.c */
+static const ConfigDetector_t CONFIG_BOTAO = { .banda = 0, .debounce_ms = 0, .permanencia_minima_ms = 0 };
+
+/** @brief Mesmos valores de CONFIG_DETECTOR_TEMPERATURA em butoes/src/app_main.c */
+static const ConfigDetector_t CONFIG_TEMPERATURA = { .banda = 50, .debounce_ms = 2000, .permanencia_minima_ms = 10000 };
+
+/**
+ * @brief Entrega as leituras, uma a cada PERIODO_MS a partir de inicio_ms.
+ * @return Número de leituras aceitas; o índice da última fica em ultima_aceita
+ */
+static int alimentar(DetectorMudanca_t *detector, const int32_t *leituras, int quantidade,
+                     uint32_t inicio_ms, int *ultima_aceita) {
+    int aceitas = 0;
+    for (int i = 0; i < quantidade; i++) {
+        if (detector_mudanca_atualizar(detector, leituras[i], inicio_ms + (uint32_t)i * PERIODO_MS)) {
+            aceitas++;
+            *ultima_aceita = i;
+        }
+    }
+    return aceitas;
+}
+
+/**
+ * @brief Eixo parado em 50 com ruído de 49 a 52, depois um degrau para 60.
+ */
+static void teste_ruido_e_degrau(void) {
+    DetectorMudanca_t detector;
+    detector_mudanca_init(&detector, &CONFIG_EIXO);
+    assert(detector_mudanca_atualizar(&detector, 50, 0)); // A primeira leitura é sempre aceita
+
+    // 10 s de ruído dentro da banda: nenhuma mudança e nada contado como suprimido
+    static const int32_t ruido[] = { 49, 51, 52, 50, 49, 52, 51, 50 };
+    uint32_t agora_ms = PERIODO_MS;
+    for (int i = 0; i < 200; i++, agora_ms += PERIODO_MS) {
+        assert(!detector_mudanca_atualizar(&detector, ruido[i % 8], agora_ms));
+    }
+    assert(detector_mudanca_valor(&detector) == 50);
+    assert(detector.suprimidas == 0);
+
+    // Degrau para 60: aceito uma única vez, na leitura em que completa 100 ms fora da banda
+    int32_t degrau[40];
+    for (int i = 0; i < 40; i++) {
+        degrau[i] = 60 + (i % 3) - 1; // 59..61, ruído em torno do novo valor
+    }
+    degrau[0] = degrau[1] = degrau[2] = 60;
+    int ultima = -1;
+    assert(alimentar(&detector, degrau, 40, agora_ms, &ultima) == 1);
+    assert(ultima == 100 / PERIODO_MS);
+    assert(detector_mudanca_valor(&detector) == 60);
+    assert(detector.suprimidas == 2);
+    printf("ruído 49..52 e degrau para 60: OK\n");
+}
+
+/**
+ * @brief Uma leitura de volta na banda no meio do debounce reinicia a contagem.
+ */
+static void teste_volta_para_banda(void) {
+    DetectorMudanca_t detector;
+    detector_mudanca_init(&detector, &CONFIG_EIXO);
+    detector_mudanca_atualizar(&detector, 50, 0);
+
+    static const int32_t leituras[] = { 60, 60, 51, 60, 60, 60, 60 };
+    int ultima = -1;
+    assert(alimentar(&detector, leituras, 7, PERIODO_MS, &ultima) == 1);
+    assert(ultima == 5); // 3 (recomeço) + 100 ms
+    assert(detector_mudanca_valor(&detector) == 60);
+
+    // Um pico isolado, mais curto que o debounce, nunca vira mudança
+    static const int32_t pico[] = { 60, 60, 90, 60, 60, 61, 59, 60 };
+    assert(alimentar(&detector, pico, 8, 1000, &ultima) == 0);
+    assert(detector_mudanca_valor(&detector) == 60);
+    printf("volta para a banda: OK\n");
+}
+
+/**
+ * @brief Temperatura: debounce de 2 s e no máximo uma mudança a cada 10 s.
+ */
+static void teste_permanencia_minima(void) {
+    DetectorMudanca_t detector;
+    detector_mudanca_init(&detector, &CONFIG_TEMPERATURA);
+    assert(detector_mudanca_atualizar(&detector, 2500, 0));
+
+    // Ruído de ±0,5 °C: nunca aceito
+    for (uint32_t agora_ms = 500; agora_ms < 20000; agora_ms += 500) {
+        assert(!detector_mudanca_atualizar(&detector, agora_ms % 1000 ? 2550 : 2450, agora_ms));
+    }
+
+    // Subida real às 20 s: aceita após 2 s de debounce (permanência já cumprida)
+    uint32_t agora_ms = 20000;
+    for (; !detector_mudanca_atualizar(&detector, 2600, agora_ms); agora_ms += 500) {
+        assert(agora_ms < 30000);
+    }
+    assert(agora_ms == 22000);
+    assert(detector_mudanca_valor(&detector) == 2600);
+
+    // Nova subida logo em seguida: o debounce termina às 24,5 s, mas a permanência segura até 32 s
+    for (agora_ms = 22500; !detector_mudanca_atualizar(&detector, 2700, agora_ms); agora_ms += 500) {
+        assert(agora_ms < 40000);
+    }
+    assert(agora_ms == 32000);
+    assert(detector_mudanca_valor(&detector) == 2700);
+    printf("permanência mínima: OK\n");
+}
+
+/**
+ * @brief Botão: banda e debounce zero aceitam cada troca na mesma leitura.
+ */
+static void teste_botao(void) {
+    DetectorMudanca_t detector;
+    detector_mudanca_init(&detector, &CONFIG_BOTAO);
+    static const int32_t leituras[] = { 0, 1, 1, 0, 1, 0, 0 };
+    int ultima = -1;
+    assert(alimentar(&detector, leituras, 7, 0, &ultima) == 5);
+    assert(ultima == 5);
+    assert(detector.suprimidas == 0);
+    printf("botão: OK\n");
+}
+
+/**
+ * @brief O relógio de ms dá a volta em 2^32 (49,7 dias) no meio do debounce.
+ */
+static void teste_volta_do_relogio(void) {
+    DetectorMudanca_t detector;
+    detector_mudanca_init(&detector, &CONFIG_EIXO);
+    uint32_t inicio_ms = UINT32_MAX - 2 * PERIODO_MS + 1;
+    detector_mudanca_atualizar(&detector, 50, inicio_ms - PERIODO_MS);
+
+    static const int32_t leituras[] = { 60, 60, 60, 60 };
+    int ultima = -1;
+    assert(alimentar(&detector, leituras, 4, inicio_ms, &ultima) == 1);
+    assert(ultima == 2);
+    printf("volta do relógio: OK\n");
+}
+
+int main(void) {
+    teste_ruido_e_degrau();
+    teste_volta_para_banda();
+    teste_permanencia_minima();
+    teste_botao();
+    teste_volta_do_relogio();
+    printf("OK\n");
+    return 0;
+}
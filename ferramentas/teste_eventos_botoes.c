@@ -0,0 +1,491 @@
+/**
+ * @file teste_eventos_botoes.c
+ * @brief Teste no host do caminho de eventos do driver de botões do butoes
+ *
+ * Compila o próprio buttons.c do firmware contra os substitutos de
+ * ferramentas/host e faz o papel do PIO, do DMA e do FreeRTOS: cada mudança
+ * confirmada vira as duas palavras (estado dos pinos e contador de amostras)
+ * escritas no anel do DMA, seguidas da IRQ do PIO, que notifica a task.
+ * Quem interpreta o programa PIO em si é ferramentas/modelo_amostrador_pio.py.
+ *
+ *     gcc -std=c11 -Wall -Iferramentas/host -Ibutoes/lib/buttons_driver \
+ *         ferramentas/teste_eventos_botoes.c butoes/lib/buttons_driver/buttons.c \
+ *         -o /tmp/teste_eventos_botoes
+ *     /tmp/teste_eventos_botoes
+ *
+ * Os cenários rodam em sequência sobre o mesmo driver, como na placa:
+ * partida, um evento por pino com o instante da borda, nenhuma espera
+ * quando a mudança já está no anel, acordar com uma mudança que chega
+ * durante a espera, tempo esgotado, o anel sobrescrito antes da leitura e
+ * durante a cópia, e o contador de amostras dando a volta em 2^32.
+ */
+
+#undef NDEBUG
+
+#include <assert.h>
+#include <stdio.h>
+#include "buttons.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "hardware/pio.h"
+#include "amostrador_entradas.pio.h"
+
+/** @brief Instante em que a amostragem começa, em µs desde o boot */
+#define INICIO_US 1234567ull
+
+/** @brief Palavras do anel do DMA, como em buttons.c */
+#define PALAVRAS_ANEL (BUTTONS_CAPACIDADE_EVENTOS * 2)
+
+/** @brief Pinos do bloco no nível alto (soltos) */
+#define TODOS_SOLTOS ((1u << BUTTONS_NUM_PINOS) - 1u)
+
+// ---------------------------------------------------------------------------
+// GPIO e clocks
+
+static bool pino_entrada_com_pull_up[32];
+
+void gpio_init(uint gpio) {
+    pino_entrada_com_pull_up[gpio] = false;
+}
+
+void gpio_set_dir(uint gpio, bool out) {
+    assert(out == GPIO_IN);
+}
+
+void gpio_pull_up(uint gpio) {
+    pino_entrada_com_pull_up[gpio] = true;
+}
+
+uint32_t clock_get_hz(enum clock_index clk_index) {
+    assert(clk_index == clk_sys);
+    return 125000000u;
+}
+
+uint64_t time_us_64(void) {
+    return INICIO_US;
+}
+
+// ---------------------------------------------------------------------------
+// PIO simulado: o pio0 está cheio (o CYW43 usa um), o amostrador fica no pio1
+
+static pio_hw_t registradores_pio[2];
+pio_hw_t *pio0 = &registradores_pio[0];
+pio_hw_t *pio1 = &registradores_pio[1];
+
+#define SM_LIVRE 2
+#define OFFSET_PROGRAMA 2
+
+static uint16_t instrucoes_carregadas[32];
+static pio_sm_config config_sm;
+static uint pino_base_entrada;
+static uint limiar_deslocamento_saida;
+static enum pio_fifo_join juncao_fifo;
+static float divisor_sm;
+static bool pindirs_entrada;
+static bool sm_iniciada, sm_ligada;
+static bool irq_fonte_habilitada;
+static bool irq_pio_pendente;
+
+bool pio_can_add_program(PIO pio, const pio_program_t *program) {
+    return pio == pio1;
+}
+
+uint pio_add_program(PIO pio, const pio_program_t *program) {
+    assert(pio == pio1 && program->length == amostrador_entradas_program.length);
+    for (uint i = 0; i < program->length; i++) {
+        instrucoes_carregadas[i] = program->instructions[i];
+    }
+    return OFFSET_PROGRAMA;
+}
+
+int pio_claim_unused_sm(PIO pio, bool required) {
+    assert(pio == pio1);
+    return SM_LIVRE;
+}
+
+uint pio_encode_in(enum pio_src_dest src, uint count) {
+    return 0x4000u | (src << 5) | (count & 31u);
+}
+
+uint pio_encode_set(enum pio_src_dest dest, uint value) {
+    return 0xE000u | (dest << 5) | value;
+}
+
+uint pio_encode_mov_not(enum pio_src_dest dest, enum pio_src_dest src) {
+    return 0xA008u | (dest << 5) | src;
+}
+
+void sm_config_set_in_pins(pio_sm_config *c, uint in_base) {
+    pino_base_entrada = in_base;
+}
+
+void sm_config_set_in_shift(pio_sm_config *c, bool shift_right, bool autopush, uint push_threshold) {
+    assert(!shift_right && !autopush);
+}
+
+void sm_config_set_out_shift(pio_sm_config *c, bool shift_right, bool autopull, uint pull_threshold) {
+    assert(shift_right && !autopull);
+    limiar_deslocamento_saida = pull_threshold;
+}
+
+void sm_config_set_fifo_join(pio_sm_config *c, enum pio_fifo_join join) {
+    juncao_fifo = join;
+}
+
+void sm_config_set_clkdiv(pio_sm_config *c, float div) {
+    divisor_sm = div;
+}
+
+int pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin_base, uint pin_count, bool is_out) {
+    pindirs_entrada = pin_base == BUTTONS_PINO_BASE && pin_count == BUTTONS_NUM_PINOS && !is_out;
+    return 0;
+}
+
+int pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config) {
+    assert(pio == pio1 && sm == SM_LIVRE && initial_pc == OFFSET_PROGRAMA);
+    config_sm = *config;
+    sm_iniciada = true;
+    return 0;
+}
+
+void pio_sm_exec(PIO pio, uint sm, uint instr) {
+    assert(sm_iniciada && !sm_ligada); // X e Y são acertados antes de ligar
+}
+
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled) {
+    sm_ligada = enabled;
+}
+
+uint pio_get_dreq(PIO pio, uint sm, bool is_tx) {
+    assert(pio == pio1 && !is_tx);
+    return 12 + sm; // DREQ_PIO1_RX0 + sm
+}
+
+void pio_set_irq0_source_enabled(PIO pio, enum pio_interrupt_source source, bool enabled) {
+    irq_fonte_habilitada = source == pis_interrupt0 + SM_LIVRE && enabled;
+}
+
+bool pio_interrupt_get(PIO pio, uint pio_interrupt_num) {
+    assert(pio_interrupt_num == SM_LIVRE);
+    return irq_pio_pendente;
+}
+
+void pio_interrupt_clear(PIO pio, uint pio_interrupt_num) {
+    irq_pio_pendente = false;
+}
+
+// ---------------------------------------------------------------------------
+// DMA e IRQ simulados
+
+#define CANAL_DMA 3
+
+static dma_channel_hw_t registradores_dma;
+static volatile uint32_t *anel;
+static uint32_t palavras_escritas;
+static dma_channel_config config_dma;
+
+/** @brief Leituras de transfer_count até a rajada simulada (0 = nenhuma armada) */
+static int leituras_ate_rajada;
+static void (*rajada)(void);
+
+static irq_handler_t tratador_irq;
+static uint numero_irq;
+static bool irq_ligada;
+
+int dma_claim_unused_channel(bool required) {
+    return CANAL_DMA;
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel) {
+    return (dma_channel_config){ .tamanho = DMA_SIZE_32, .incrementa_leitura = true };
+}
+
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) {
+    c->tamanho = size;
+}
+
+void channel_config_set_read_increment(dma_channel_config *c, bool incr) {
+    c->incrementa_leitura = incr;
+}
+
+void channel_config_set_write_increment(dma_channel_config *c, bool incr) {
+    c->incrementa_escrita = incr;
+}
+
+void channel_config_set_ring(dma_channel_config *c, bool write, uint size_bits) {
+    assert(write);
+    c->anel_bits = size_bits;
+}
+
+void channel_config_set_dreq(dma_channel_config *c, uint dreq) {
+    c->dreq = dreq;
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger) {
+    assert(channel == CANAL_DMA && trigger);
+    assert(read_addr == &pio1->rxf[SM_LIVRE]);
+    assert(((uintptr_t)write_addr & ((1u << config->anel_bits) - 1u)) == 0); // Anel alinhado ao tamanho
+    config_dma = *config;
+    anel = write_addr;
+    registradores_dma.transfer_count = transfer_count;
+}
+
+dma_channel_hw_t *dma_channel_hw_addr(uint channel) {
+    assert(channel == CANAL_DMA);
+    if (leituras_ate_rajada > 0 && --leituras_ate_rajada == 0) {
+        rajada();
+    }
+    return &registradores_dma;
+}
+
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority) {
+    numero_irq = num;
+    tratador_irq = handler;
+}
+
+void irq_set_enabled(uint num, bool enabled) {
+    irq_ligada = num == numero_irq && enabled;
+}
+
+// ---------------------------------------------------------------------------
+// FreeRTOS simulado: a task consumidora e o seu contador de notificações
+
+static int task_consumidora;
+static uint32_t notificacoes;
+static uint32_t esperas;
+static TickType_t ultima_espera;
+
+/** @brief O que acontece enquanto a task está bloqueada (NULL = nada, o tempo acaba) */
+static void (*durante_espera)(void);
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+    return &task_consumidora;
+}
+
+BaseType_t xTaskNotifyFromISR(TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction,
+                              BaseType_t *pxHigherPriorityTaskWoken) {
+    assert(xTaskToNotify == &task_consumidora && eAction == eIncrement);
+    notificacoes++;
+    *pxHigherPriorityTaskWoken = pdTRUE;
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait) {
+    assert(xClearCountOnExit == pdTRUE);
+    esperas++;
+    ultima_espera = xTicksToWait;
+    if (notificacoes == 0 && durante_espera) {
+        durante_espera();
+    }
+    uint32_t valor = notificacoes;
+    notificacoes = 0;
+    return valor;
+}
+
+// ---------------------------------------------------------------------------
+// O PIO empurrando mudanças
+
+/** @brief Uma mudança confirmada: nível dos pinos (bit = nível) e amostra dos pushes */
+typedef struct {
+    uint32_t niveis;
+    uint64_t amostra;
+} Mudanca;
+
+/**
+ * @brief Empurra as duas palavras de uma mudança para o anel e dispara a IRQ do PIO.
+ *
+ * Os bits acima do bloco levam o nível de outros GPIOs, que o driver precisa ignorar.
+ */
+static void empurrar(Mudanca mudanca) {
+    uint32_t palavras[2] = { mudanca.niveis | 0x5A5A0000u, 0xFFFFFFFFu - (uint32_t)mudanca.amostra };
+    for (int i = 0; i < 2; i++) {
+        anel[palavras_escritas++ % PALAVRAS_ANEL] = palavras[i];
+        registradores_dma.transfer_count--;
+    }
+    irq_pio_pendente = true;
+    tratador_irq();
+}
+
+/** @brief Instante da borda de uma mudança: a primeira leitura diferente, 21 amostras antes dos pushes */
+static uint64_t borda_us(uint64_t amostra) {
+    return INICIO_US + (amostra - (BUTTONS_DEBOUNCE_AMOSTRAS + 1)) * BUTTONS_PERIODO_AMOSTRA_US;
+}
+
+/** @brief Estado dos pinos já entregue pelo driver, do ponto de vista do teste */
+static uint32_t niveis_entregues = 0;
+
+/**
+ * @brief Confere que o driver entrega, em ordem, um evento por pino que mudou em cada mudança.
+ *
+ * Depois das mudanças, confere que não sobra evento; essa última chamada
+ * pode esperar uma vez (uma notificação pendente ou o tempo acabando).
+ */
+static void conferir_eventos(const Mudanca *mudancas, int quantidade) {
+    EventoBotao_t evento;
+    for (int m = 0; m < quantidade; m++) {
+        for (uint bit = 0; bit < BUTTONS_NUM_PINOS; bit++) {
+            if (!((mudancas[m].niveis ^ niveis_entregues) & (1u << bit))) {
+                continue;
+            }
+            assert(buttons_aguardar_evento(&evento, 10));
+            assert(evento.pino == BUTTONS_PINO_BASE + bit);
+            assert(evento.pressionado == !(mudancas[m].niveis & (1u << bit)));
+            assert(evento.borda_us == borda_us(mudancas[m].amostra));
+            niveis_entregues ^= 1u << bit;
+        }
+    }
+    assert(!buttons_aguardar_evento(&evento, 10));
+    assert(notificacoes == 0);
+}
+
+// ---------------------------------------------------------------------------
+// Cenários
+
+static void teste_inicio(void) {
+    EventoBotao_t evento;
+    assert(!buttons_aguardar_evento(&evento, 10)); // Sem amostrador ainda: não bloqueia
+    assert(esperas == 0);
+
+    buttons_init();
+    assert(pino_entrada_com_pull_up[BUTTON_A_PIN] && pino_entrada_com_pull_up[BUTTON_B_PIN]);
+    assert(buttons_iniciar_eventos());
+
+    assert(instrucoes_carregadas[amostrador_entradas_offset_leitura] == pio_encode_in(pio_pins, BUTTONS_NUM_PINOS));
+    assert(instrucoes_carregadas[amostrador_entradas_offset_confirmacao] == pio_encode_in(pio_pins, BUTTONS_NUM_PINOS));
+    assert(pino_base_entrada == BUTTONS_PINO_BASE && pindirs_entrada);
+    assert(limiar_deslocamento_saida == BUTTONS_DEBOUNCE_AMOSTRAS);
+    assert(juncao_fifo == PIO_FIFO_JOIN_RX);
+    assert(divisor_sm > 4464.0f && divisor_sm < 4464.5f); // 125 MHz, 7 ciclos por amostra de 250 µs
+    assert(config_dma.tamanho == DMA_SIZE_32 && !config_dma.incrementa_leitura && config_dma.incrementa_escrita);
+    assert((1u << config_dma.anel_bits) == PALAVRAS_ANEL * sizeof(uint32_t));
+    assert(config_dma.dreq == pio_get_dreq(pio1, SM_LIVRE, false));
+    assert(numero_irq == PIO1_IRQ_0 && irq_ligada && irq_fonte_habilitada);
+    assert(sm_ligada);
+    printf("início: OK\n");
+}
+
+static void teste_partida(void) {
+    // O PIO começa com todos "pressionados"; soltos, os dois pinos mudam na amostra 21
+    Mudanca partida = { TODOS_SOLTOS, BUTTONS_DEBOUNCE_AMOSTRAS + 1 };
+    empurrar(partida);
+    uint32_t esperas_antes = esperas;
+    EventoBotao_t evento;
+    assert(buttons_aguardar_evento(&evento, 10) && evento.pino == BUTTON_A_PIN && !evento.pressionado);
+    assert(evento.borda_us == INICIO_US);
+    assert(buttons_aguardar_evento(&evento, 10) && evento.pino == BUTTON_B_PIN && !evento.pressionado);
+    assert(evento.borda_us == INICIO_US);
+    assert(esperas == esperas_antes); // Mudança já no anel: nenhuma espera
+    niveis_entregues = TODOS_SOLTOS;
+
+    // A notificação que sobrou libera a próxima espera na hora, sem evento
+    assert(!buttons_aguardar_evento(&evento, 10));
+    assert(esperas == esperas_antes + 1 && notificacoes == 0);
+    printf("partida: OK\n");
+}
+
+static void teste_pressionar_e_soltar(void) {
+    Mudanca mudancas[] = {
+        { TODOS_SOLTOS & ~1u, 4000 },        // A pressionado
+        { 0, 4100 },                         // B também
+        { TODOS_SOLTOS, 9000 },              // Os dois soltos na mesma amostra
+    };
+    for (int i = 0; i < 3; i++) {
+        empurrar(mudancas[i]);
+    }
+    conferir_eventos(mudancas, 3);
+    printf("pressionar e soltar: OK\n");
+}
+
+static Mudanca mudanca_durante_espera = { TODOS_SOLTOS & ~2u, 20000 };
+
+static void empurrar_durante_espera(void) {
+    empurrar(mudanca_durante_espera);
+}
+
+static void teste_espera(void) {
+    EventoBotao_t evento;
+
+    // Sem mudança: bloqueia uma vez pelo tempo pedido e volta sem evento
+    uint32_t esperas_antes = esperas;
+    assert(!buttons_aguardar_evento(&evento, 123));
+    assert(esperas == esperas_antes + 1 && ultima_espera == 123);
+
+    // A mudança chega com a task bloqueada: a notificação a acorda com o evento
+    durante_espera = empurrar_durante_espera;
+    assert(buttons_aguardar_evento(&evento, portMAX_DELAY));
+    durante_espera = NULL;
+    assert(esperas == esperas_antes + 2 && ultima_espera == portMAX_DELAY);
+    assert(evento.pino == BUTTON_B_PIN && evento.pressionado);
+    assert(evento.borda_us == borda_us(mudanca_durante_espera.amostra));
+    niveis_entregues = mudanca_durante_espera.niveis;
+    conferir_eventos(NULL, 0);
+    printf("espera: OK\n");
+}
+
+static void teste_estouro(void) {
+    // 12 mudanças sem leitura em um anel de 8: as 8 mais antigas se perdem
+    Mudanca mudancas[12];
+    for (int i = 0; i < 12; i++) {
+        mudancas[i] = (Mudanca){ (i & 1) ? TODOS_SOLTOS & ~2u : TODOS_SOLTOS, 30000 + 100 * (uint64_t)i };
+        empurrar(mudancas[i]);
+    }
+    uint32_t perdidos_antes = buttons_eventos_perdidos();
+    conferir_eventos(&mudancas[8], 4);
+    assert(buttons_eventos_perdidos() == perdidos_antes + 8);
+    printf("estouro do anel: OK\n");
+}
+
+static Mudanca mudancas_rajada[8];
+
+static void empurrar_rajada(void) {
+    for (int i = 0; i < 8; i++) {
+        empurrar(mudancas_rajada[i]);
+    }
+}
+
+static void teste_sobrescrita_durante_copia(void) {
+    // Uma mudança no anel; enquanto o driver a copia, o DMA dá a volta por cima dela
+    Mudanca copiada = { 0, 40000 };
+    empurrar(copiada);
+    for (int i = 0; i < 8; i++) {
+        mudancas_rajada[i] = (Mudanca){ (i & 1) ? 0 : TODOS_SOLTOS, 40100 + 100 * (uint64_t)i };
+    }
+    rajada = empurrar_rajada;
+    leituras_ate_rajada = 2; // A segunda leitura de transfer_count é a que confere a cópia
+
+    uint32_t perdidos_antes = buttons_eventos_perdidos();
+    conferir_eventos(&mudancas_rajada[4], 4);
+    assert(leituras_ate_rajada == 0);
+    assert(buttons_eventos_perdidos() == perdidos_antes + 5); // A copiada e as 4 primeiras da rajada
+    printf("sobrescrita durante a cópia: OK\n");
+}
+
+static void teste_volta_do_contador(void) {
+    // O contador de 32 bits do PIO dá a volta a cada 2^32 amostras (~12 dias a 250 µs)
+    Mudanca mudancas[] = {
+        { TODOS_SOLTOS, 0xFFFFFFF0ull },
+        { TODOS_SOLTOS & ~1u, (1ull << 32) + 0x10 },
+        { TODOS_SOLTOS, (1ull << 32) + 0x100 },
+    };
+    for (int i = 0; i < 3; i++) {
+        empurrar(mudancas[i]);
+    }
+    conferir_eventos(mudancas, 3);
+    printf("volta do contador: OK\n");
+}
+
+int main(void) {
+    teste_inicio();
+    teste_partida();
+    teste_pressionar_e_soltar();
+    teste_espera();
+    teste_estouro();
+    teste_sobrescrita_durante_copia();
+    teste_volta_do_contador();
+    assert(buttons_eventos_perdidos() == 8 + 5);
+    printf("OK\n");
+    return 0;
+}
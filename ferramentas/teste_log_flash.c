@@ -0,0 +1,323 @@
+/**
+ * @file teste_log_flash.c
+ * @brief Teste do log de amostras em flash no host, sobre uma flash simulada na RAM
+ *
+ * Compila o próprio log_flash.c do firmware com uma MemoriaFlash_t que
+ * imita uma flash NOR: o apagamento deixa o setor em 0xFF e a programação
+ * só leva bits de 1 para 0, o que a marcação das páginas repostas exige.
+ * A região tem só quatro setores, para que a volta do log aconteça cedo.
+ *
+ *     gcc -std=c11 -Wall -Iferramentas/host -Irosa_dos_ventos/lib/log_flash \
+ *         -Irosa_dos_ventos/lib/buffer_amostras -Irosa_dos_ventos/lib/joystick_driver \
+ *         ferramentas/teste_log_flash.c rosa_dos_ventos/lib/log_flash/log_flash.c \
+ *         rosa_dos_ventos/lib/buffer_amostras/buffer_amostras.c -o /tmp/teste_log_flash
+ *     /tmp/teste_log_flash
+ *
+ * Cobre o acréscimo e a reposição em ordem, a volta com apagamento do setor
+ * mais antigo, a remontagem depois de um reinício simulado e as páginas
+ * corrompidas ou que falharam na programação.
+ */
+
+#undef NDEBUG
+
+#include <assert.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include "log_flash.h"
+
+/** @brief Setores da flash simulada */
+#define SETORES_TESTE 4
+
+/** @brief Tamanho da flash simulada, em bytes */
+#define TAMANHO_TESTE (SETORES_TESTE * LOG_FLASH_TAMANHO_SETOR)
+
+/** @brief Páginas da flash simulada */
+#define PAGINAS_TESTE (TAMANHO_TESTE / LOG_FLASH_TAMANHO_PAGINA)
+
+/** @brief Atalho para o número de amostras por página */
+#define POR_PAGINA LOG_FLASH_AMOSTRAS_POR_PAGINA
+
+static uint8_t flash_simulada[TAMANHO_TESTE];
+static uint32_t apagamentos[SETORES_TESTE];
+static bool falhar_programacao = false;
+
+static void ler_ram(uint32_t endereco, void *destino, size_t tamanho) {
+    assert(endereco + tamanho <= TAMANHO_TESTE);
+    memcpy(destino, flash_simulada + endereco, tamanho);
+}
+
+static bool apagar_setor_ram(uint32_t endereco) {
+    assert(endereco % LOG_FLASH_TAMANHO_SETOR == 0 && endereco < TAMANHO_TESTE);
+    memset(flash_simulada + endereco, 0xFF, LOG_FLASH_TAMANHO_SETOR);
+    apagamentos[endereco / LOG_FLASH_TAMANHO_SETOR]++;
+    return true;
+}
+
+static bool programar_pagina_ram(uint32_t endereco, const uint8_t *dados) {
+    assert(endereco % LOG_FLASH_TAMANHO_PAGINA == 0 && endereco < TAMANHO_TESTE);
+    if (falhar_programacao) {
+        return false;
+    }
+    for (uint32_t i = 0; i < LOG_FLASH_TAMANHO_PAGINA; i++) {
+        // Na flash NOR um bit em 0 só volta a 1 apagando o setor
+        flash_simulada[endereco + i] &= dados[i];
+    }
+    return true;
+}
+
+static const MemoriaFlash_t memoria_ram = {
+    .tamanho_regiao = TAMANHO_TESTE,
+    .ler = ler_ram,
+    .apagar_setor = apagar_setor_ram,
+    .programar_pagina = programar_pagina_ram,
+};
+
+static LogFlash_t log_teste;
+static BufferAmostras_t buffer;
+
+/** @brief Relógio simulado, em ms desde o boot */
+static uint32_t agora_ms = 1000;
+
+/**
+ * @brief Deixa a flash simulada como saída de fábrica (toda apagada).
+ */
+static void apagar_tudo(void) {
+    memset(flash_simulada, 0xFF, sizeof(flash_simulada));
+    memset(apagamentos, 0, sizeof(apagamentos));
+    falhar_programacao = false;
+}
+
+/**
+ * @brief Grava as amostras de sequência [inicio, fim) no log.
+ */
+static void gravar(uint32_t inicio, uint32_t fim) {
+    for (uint32_t sequencia = inicio; sequencia < fim; sequencia++) {
+        Amostra_t amostra;
+        memset(&amostra, 0, sizeof(amostra)); // O preenchimento também entra na soma
+        amostra.sequencia = sequencia;
+        amostra.timestamp_ms = sequencia * 10;
+        amostra.estado.x_position = (int)(sequencia % 101);
+        amostra.estado.y_position = (int)(100 - sequencia % 101);
+        amostra.estado.button_pressed = (uint8_t)(sequencia & 1);
+        log_flash_gravar(&log_teste, &amostra);
+    }
+}
+
+/**
+ * @brief Repõe uma leva, avançando o relógio o suficiente para ela sair.
+ * @return Amostras repostas
+ */
+static uint16_t repor(void) {
+    agora_ms += LOG_FLASH_INTERVALO_REPOSICAO_MS;
+    return log_flash_repor(&log_teste, &buffer, agora_ms);
+}
+
+/**
+ * @brief Retira do buffer as amostras repostas e confere a sequência e o conteúdo.
+ */
+static void conferir_buffer(uint32_t inicio, uint32_t fim) {
+    Amostra_t amostra;
+    for (uint32_t sequencia = inicio; sequencia < fim; sequencia++) {
+        assert(buffer_amostras_remover(&buffer, &amostra));
+        assert(amostra.sequencia == sequencia);
+        assert(amostra.timestamp_ms == sequencia * 10);
+        assert(amostra.estado.x_position == (int)(sequencia % 101));
+        assert(amostra.estado.button_pressed == (sequencia & 1));
+    }
+    assert(buffer_amostras_tamanho(&buffer) == 0);
+}
+
+/**
+ * @brief Repõe tudo o que falta e confere que sai a faixa [inicio, fim) em ordem.
+ */
+static void conferir_reposicao_completa(uint32_t inicio, uint32_t fim) {
+    uint32_t esperado = inicio;
+    while (log_flash_tem_pendentes(&log_teste)) {
+        uint16_t repostas = repor();
+        conferir_buffer(esperado, esperado + repostas);
+        esperado += repostas;
+    }
+    assert(esperado == fim);
+}
+
+/**
+ * @brief Acréscimo, reposição em ordem e respeito ao intervalo e ao espaço no buffer.
+ */
+static void teste_acrescimo(void) {
+    apagar_tudo();
+    log_flash_init(&log_teste, &memoria_ram);
+    buffer_amostras_init(&buffer);
+    assert(log_teste.num_paginas == PAGINAS_TESTE);
+    assert(!log_flash_tem_pendentes(&log_teste));
+
+    gravar(0, 2 * POR_PAGINA + 3);
+    assert(log_teste.paginas_pendentes == 2);
+    assert(log_teste.quantidade_ram == 3);
+    assert(log_teste.gravadas == 2 * POR_PAGINA + 3);
+    assert(apagamentos[0] == 1);
+
+    // Repor logo depois de outra reposição não faz nada
+    assert(repor() == POR_PAGINA);
+    assert(log_flash_repor(&log_teste, &buffer, agora_ms + LOG_FLASH_INTERVALO_REPOSICAO_MS - 1) == 0);
+
+    // Uma amostra ao vivo não toma o lugar da última reposta, só da ao vivo seguinte
+    Amostra_t ao_vivo = { .sequencia = 9000 };
+    assert(!buffer_amostras_coalescer(&buffer, &ao_vivo, 1));
+    ao_vivo.sequencia = 9001;
+    assert(buffer_amostras_coalescer(&buffer, &ao_vivo, 1));
+    assert(buffer_amostras_tamanho(&buffer) == POR_PAGINA + 1);
+    Amostra_t amostra;
+    for (uint32_t sequencia = 0; sequencia < POR_PAGINA; sequencia++) {
+        assert(buffer_amostras_remover(&buffer, &amostra) && amostra.sequencia == sequencia);
+    }
+    assert(buffer_amostras_remover(&buffer, &amostra) && amostra.sequencia == 9001);
+
+    // Sem espaço para uma página inteira no buffer, espera
+    Amostra_t ocupante = { 0 };
+    for (uint16_t i = 0; i < BUFFER_AMOSTRAS_CAPACIDADE - POR_PAGINA + 1; i++) {
+        buffer_amostras_inserir(&buffer, &ocupante);
+    }
+    assert(repor() == 0);
+    buffer_amostras_init(&buffer);
+
+    // Depois da flash, a página em montagem sai direto da RAM
+    conferir_reposicao_completa(POR_PAGINA, 2 * POR_PAGINA + 3);
+    assert(log_teste.repostas == 2 * POR_PAGINA + 3);
+    assert(log_teste.perdidas == 0);
+    printf("acréscimo: OK\n");
+}
+
+/**
+ * @brief Volta completa: o setor mais antigo é apagado e suas páginas pendentes se perdem.
+ */
+static void teste_volta(void) {
+    apagar_tudo();
+    log_flash_init(&log_teste, &memoria_ram);
+    buffer_amostras_init(&buffer);
+
+    // Uma página além da capacidade obriga a apagar o setor 0 com 16 páginas pendentes
+    uint32_t paginas = PAGINAS_TESTE + 1;
+    gravar(0, paginas * POR_PAGINA);
+    uint32_t paginas_por_setor = LOG_FLASH_TAMANHO_SETOR / LOG_FLASH_TAMANHO_PAGINA;
+    assert(log_teste.perdidas == paginas_por_setor * POR_PAGINA);
+    assert(log_teste.paginas_pendentes == PAGINAS_TESTE - paginas_por_setor + 1);
+    assert(log_teste.pagina_escrita == 1);
+    assert(apagamentos[0] == 2 && apagamentos[1] == 1 && apagamentos[SETORES_TESTE - 1] == 1);
+
+    conferir_reposicao_completa(paginas_por_setor * POR_PAGINA, paginas * POR_PAGINA);
+
+    // Mais uma volta inteira: todos os setores são apagados o mesmo número de vezes
+    gravar(paginas * POR_PAGINA, (paginas + PAGINAS_TESTE) * POR_PAGINA);
+    for (int setor = 0; setor < SETORES_TESTE; setor++) {
+        assert(apagamentos[setor] == (setor == 0 ? 3u : 2u));
+    }
+    gravar((paginas + PAGINAS_TESTE) * POR_PAGINA, (paginas + 2 * PAGINAS_TESTE - 1) * POR_PAGINA);
+    for (int setor = 0; setor < SETORES_TESTE; setor++) {
+        assert(apagamentos[setor] == 3);
+    }
+    printf("volta com apagamento: OK\n");
+}
+
+/**
+ * @brief Reinício simulado: um log novo montado sobre a mesma memória continua de onde parou.
+ */
+static void teste_reinicio(void) {
+    apagar_tudo();
+    log_flash_init(&log_teste, &memoria_ram);
+    buffer_amostras_init(&buffer);
+
+    gravar(0, 5 * POR_PAGINA + 2);
+    assert(repor() == POR_PAGINA);
+    assert(repor() == POR_PAGINA);
+    conferir_buffer(0, 2 * POR_PAGINA);
+
+    // A página em montagem fica só na RAM e se perde no reinício
+    log_flash_init(&log_teste, &memoria_ram);
+    assert(log_teste.paginas_pendentes == 3);
+    assert(log_teste.pagina_leitura == 2);
+    assert(log_teste.pagina_escrita == 5);
+    assert(log_teste.proxima_sequencia == 5);
+
+    // As novas páginas entram depois das antigas e a reposição segue a ordem de gravação
+    gravar(1000, 1000 + POR_PAGINA);
+    assert(log_teste.paginas_pendentes == 4);
+    for (uint32_t pagina = 2; pagina < 5; pagina++) {
+        assert(repor() == POR_PAGINA);
+        conferir_buffer(pagina * POR_PAGINA, (pagina + 1) * POR_PAGINA);
+    }
+    conferir_reposicao_completa(1000, 1000 + POR_PAGINA);
+
+    // Depois de uma volta, o fim do log é achado pela sequência e não pela posição
+    buffer_amostras_init(&buffer);
+    apagar_tudo();
+    log_flash_init(&log_teste, &memoria_ram);
+    gravar(0, (PAGINAS_TESTE + 3) * POR_PAGINA);
+    assert(repor() == POR_PAGINA);
+    buffer_amostras_init(&buffer);
+    LogFlash_t antes = log_teste;
+    log_flash_init(&log_teste, &memoria_ram);
+    assert(log_teste.pagina_escrita == antes.pagina_escrita);
+    assert(log_teste.pagina_leitura == antes.pagina_leitura);
+    assert(log_teste.paginas_pendentes == antes.paginas_pendentes);
+    assert(log_teste.proxima_sequencia == antes.proxima_sequencia);
+    uint32_t primeira = (LOG_FLASH_TAMANHO_SETOR / LOG_FLASH_TAMANHO_PAGINA + 1) * POR_PAGINA;
+    conferir_reposicao_completa(primeira, (PAGINAS_TESTE + 3) * POR_PAGINA);
+    printf("reinício: OK\n");
+}
+
+/**
+ * @brief Páginas corrompidas são descartadas e contadas; a falha de programação não trava o log.
+ */
+static void teste_pagina_corrompida(void) {
+    apagar_tudo();
+    log_flash_init(&log_teste, &memoria_ram);
+    buffer_amostras_init(&buffer);
+
+    gravar(0, 3 * POR_PAGINA);
+    // Um bit a menos no meio da página 1, como numa programação interrompida
+    flash_simulada[LOG_FLASH_TAMANHO_PAGINA + LOG_FLASH_TAMANHO_CABECALHO + 5] ^= 0x10;
+
+    assert(repor() == POR_PAGINA);
+    conferir_buffer(0, POR_PAGINA);
+    assert(repor() == 0);
+    assert(log_teste.perdidas == POR_PAGINA);
+    assert(repor() == POR_PAGINA);
+    conferir_buffer(2 * POR_PAGINA, 3 * POR_PAGINA);
+
+    // A página corrompida também foi marcada e não volta depois de um reinício
+    log_flash_init(&log_teste, &memoria_ram);
+    assert(log_teste.paginas_pendentes == 0);
+
+    // Falha ao programar: a página se perde, mas a posição é reaproveitada
+    falhar_programacao = true;
+    gravar(100, 100 + POR_PAGINA);
+    assert(log_teste.perdidas == POR_PAGINA);
+    assert(log_teste.paginas_pendentes == 0);
+    assert(log_teste.pagina_escrita == 3);
+    falhar_programacao = false;
+    gravar(200, 200 + POR_PAGINA);
+    assert(log_teste.paginas_pendentes == 1);
+    conferir_reposicao_completa(200, 200 + POR_PAGINA);
+
+    // Página com cabeçalho incompleto (mágico errado) é ignorada na montagem
+    uint8_t lixo[LOG_FLASH_TAMANHO_PAGINA];
+    memset(lixo, 0xFF, sizeof(lixo));
+    lixo[0] = 0x00;
+    programar_pagina_ram(4 * LOG_FLASH_TAMANHO_PAGINA, lixo);
+    log_flash_init(&log_teste, &memoria_ram);
+    assert(log_teste.paginas_pendentes == 0);
+    assert(log_teste.pagina_escrita == 4);
+    printf("página corrompida: OK\n");
+}
+
+int main(void) {
+    printf("%u amostras de %zu bytes por página, %d páginas\n",
+           (unsigned)POR_PAGINA, sizeof(Amostra_t), PAGINAS_TESTE);
+    teste_acrescimo();
+    teste_volta();
+    teste_reinicio();
+    teste_pagina_corrompida();
+    printf("OK\n");
+    return 0;
+}
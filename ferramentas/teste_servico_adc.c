@@ -0,0 +1,439 @@
+/**
+ * @file teste_servico_adc.c
+ * @brief Teste do serviço de ADC no host, com o ADC e o DMA simulados
+ *
+ * Compila o próprio servico_adc.c do firmware contra os cabeçalhos de
+ * ferramentas/host/hardware, que só declaram as funções do SDK; este
+ * programa as implementa como um ADC em round-robin alimentando dois
+ * canais de DMA encadeados. Cada conversão tem um valor conhecido, função
+ * do canal e do número da conversão, então o teste sabe exatamente que
+ * soma cada publicação deveria trazer.
+ *
+ *     gcc -std=c11 -Wall -Iferramentas/host -Irosa_dos_ventos/lib/servico_adc \
+ *         ferramentas/teste_servico_adc.c rosa_dos_ventos/lib/servico_adc/servico_adc.c \
+ *         -o /tmp/teste_servico_adc
+ *     /tmp/teste_servico_adc
+ *
+ * Confere, para as configurações dos dois firmwares e para uma em que o
+ * ADC limita a taxa: a taxa de publicação de cada canal, as somas e somas
+ * dos quadrados de cada publicação, que o DMA nunca escreve fora dos dois
+ * blocos (o rearme do ping-pong) e as recusas de registro. Cada cenário
+ * roda em um processo próprio, porque o serviço só inicia uma vez.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#undef NDEBUG
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "servico_adc.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+
+/** @brief Frequência do clock do ADC, em Hz */
+#define CLOCK_ADC_HZ 48000000.0
+
+/** @brief Canais de DMA do RP2040 */
+#define NUM_CANAIS_DMA 12
+
+// ---------------------------------------------------------------------------
+// ADC simulado
+
+static adc_hw_t registradores_adc;
+adc_hw_t *adc_hw = &registradores_adc;
+
+static uint canal_selecionado;
+static uint mascara_round_robin;
+static bool sensor_temperatura_ligado;
+static bool fifo_com_dreq;
+static float divisor_adc = -1.0f;
+static bool adc_rodando;
+
+/** @brief Conversões já feitas em cada canal (também o índice da próxima) */
+static uint64_t conversoes_canal[SERVICO_ADC_NUM_CANAIS];
+static uint64_t total_conversoes;
+
+void adc_init(void) {}
+
+void adc_gpio_init(uint gpio) {
+    assert(gpio >= 26 && gpio <= 29);
+}
+
+void adc_select_input(uint input) {
+    assert(input < SERVICO_ADC_NUM_CANAIS);
+    canal_selecionado = input;
+}
+
+void adc_set_round_robin(uint input_mask) {
+    mascara_round_robin = input_mask;
+}
+
+void adc_set_temp_sensor_enabled(bool enable) {
+    sensor_temperatura_ligado = enable;
+}
+
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift) {
+    fifo_com_dreq = en && dreq_en && dreq_thresh == 1 && !err_in_fifo && !byte_shift;
+}
+
+void adc_set_clkdiv(float clkdiv) {
+    divisor_adc = clkdiv;
+}
+
+void adc_run(bool run) {
+    adc_rodando = run;
+}
+
+/**
+ * @brief Valor da n-ésima conversão de um canal: conhecido e diferente a cada conversão.
+ */
+static uint16_t valor_conversao(uint canal, uint64_t n) {
+    return (uint16_t)((canal * 811u + n * 37u + (n * n) % 53u) & 0xFFFu);
+}
+
+/**
+ * @brief Faz uma conversão no canal selecionado e avança o round-robin.
+ */
+static uint16_t converter(void) {
+    uint canal = canal_selecionado;
+    uint16_t valor = valor_conversao(canal, conversoes_canal[canal]++);
+    total_conversoes++;
+    if (mascara_round_robin) {
+        do {
+            canal_selecionado = (canal_selecionado + 1) % SERVICO_ADC_NUM_CANAIS;
+        } while (!(mascara_round_robin & (1u << canal_selecionado)));
+    }
+    return valor;
+}
+
+/**
+ * @brief Conversões por segundo que o divisor programado produz.
+ */
+static double taxa_conversoes(void) {
+    return CLOCK_ADC_HZ / (divisor_adc + 1.0);
+}
+
+absolute_time_t get_absolute_time(void) {
+    return (absolute_time_t)(total_conversoes * 1e6 / taxa_conversoes());
+}
+
+uint32_t to_ms_since_boot(absolute_time_t t) {
+    return (uint32_t)(t / 1000);
+}
+
+// ---------------------------------------------------------------------------
+// DMA simulado
+
+typedef struct {
+    bool reservado;
+    dma_channel_config config;
+    uint16_t *bloco;       /**< Endereço da primeira configuração: o bloco do canal */
+    uint32_t contagem;     /**< Transferências por disparo */
+    uint16_t *escrita;     /**< Endereço de escrita atual (avança com as transferências) */
+    uint32_t restantes;
+    bool ativo;
+    bool irq_habilitada;
+    bool irq_pendente;
+} CanalDmaSimulado;
+
+static CanalDmaSimulado dma[NUM_CANAIS_DMA];
+static irq_handler_t tratador_dma;
+static bool irq_dma_habilitada;
+
+/** @brief Conversões entregues em blocos completos (as que a interrupção já viu) */
+static uint64_t conversoes_processadas;
+
+int dma_claim_unused_channel(bool required) {
+    for (int k = 0; k < NUM_CANAIS_DMA; k++) {
+        if (!dma[k].reservado) {
+            dma[k].reservado = true;
+            return k;
+        }
+    }
+    assert(!required);
+    return -1;
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel) {
+    dma_channel_config config = {
+        .tamanho = DMA_SIZE_32, .incrementa_leitura = true, .incrementa_escrita = false,
+        .dreq = 0x3F, .encadear_em = channel,
+    };
+    return config;
+}
+
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) {
+    c->tamanho = size;
+}
+
+void channel_config_set_read_increment(dma_channel_config *c, bool incr) {
+    c->incrementa_leitura = incr;
+}
+
+void channel_config_set_write_increment(dma_channel_config *c, bool incr) {
+    c->incrementa_escrita = incr;
+}
+
+void channel_config_set_dreq(dma_channel_config *c, uint dreq) {
+    c->dreq = dreq;
+}
+
+void channel_config_set_chain_to(dma_channel_config *c, uint chain_to) {
+    c->encadear_em = chain_to;
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger) {
+    CanalDmaSimulado *k = &dma[channel];
+    assert(k->reservado);
+    assert(read_addr == &adc_hw->fifo);
+    assert(config->tamanho == DMA_SIZE_16 && !config->incrementa_leitura && config->incrementa_escrita);
+    assert(config->dreq == DREQ_ADC);
+    k->config = *config;
+    k->bloco = k->escrita = (uint16_t *)write_addr;
+    k->contagem = k->restantes = transfer_count;
+    k->ativo = trigger;
+}
+
+void dma_channel_set_irq0_enabled(uint channel, bool enabled) {
+    dma[channel].irq_habilitada = enabled;
+}
+
+bool dma_channel_get_irq0_status(uint channel) {
+    return dma[channel].irq_pendente;
+}
+
+void dma_channel_acknowledge_irq0(uint channel) {
+    dma[channel].irq_pendente = false;
+}
+
+void dma_channel_set_write_addr(uint channel, volatile void *write_addr, bool trigger) {
+    dma[channel].escrita = (uint16_t *)write_addr;
+    if (trigger) {
+        dma_channel_start(channel);
+    }
+}
+
+void dma_channel_start(uint channel) {
+    dma[channel].ativo = true;
+    dma[channel].restantes = dma[channel].contagem;
+}
+
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority) {
+    assert(num == DMA_IRQ_0);
+    tratador_dma = handler;
+}
+
+void irq_set_enabled(uint num, bool enabled) {
+    assert(num == DMA_IRQ_0);
+    irq_dma_habilitada = enabled;
+}
+
+/**
+ * @brief Uma conversão do ADC vai pela FIFO para o canal de DMA ativo.
+ *
+ * No fim do bloco o canal dispara o encadeado (que recomeça a contagem,
+ * mas continua do endereço onde estava) e a interrupção roda na hora.
+ */
+static void passo_dma(void) {
+    int ativo = -1;
+    for (int k = 0; k < NUM_CANAIS_DMA; k++) {
+        if (dma[k].ativo) {
+            assert(ativo < 0); // Nunca dois canais disputando a FIFO
+            ativo = k;
+        }
+    }
+    assert(ativo >= 0);
+    CanalDmaSimulado *k = &dma[ativo];
+    // Sem o rearme na interrupção o canal escreveria depois do fim do bloco
+    assert(k->escrita >= k->bloco && k->escrita < k->bloco + k->contagem);
+    *k->escrita++ = converter();
+    if (--k->restantes > 0) {
+        return;
+    }
+
+    k->ativo = false;
+    conversoes_processadas += k->contagem;
+    if (k->config.encadear_em != (uint32_t)ativo) {
+        dma_channel_start(k->config.encadear_em);
+    }
+    if (k->irq_habilitada) {
+        k->irq_pendente = true;
+        assert(irq_dma_habilitada && tratador_dma != NULL);
+        tratador_dma();
+        assert(!k->irq_pendente);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Cenários
+
+/**
+ * @brief Um canal registrado no cenário e o que se espera dele
+ */
+typedef struct {
+    uint8_t canal;
+    uint32_t periodo_ms;
+    uint16_t conversoes;
+    uint32_t periodo_quadros; /**< Preenchido pelo cenário */
+    uint32_t publicacoes;     /**< Publicações recebidas pelo callback */
+} CanalTeste;
+
+static CanalTeste *canais_teste;
+static int num_canais_teste;
+
+/**
+ * @brief Callback do serviço: lê a publicação e confere a soma com as conversões esperadas.
+ */
+static void conferir_publicacao(uint8_t canal, void *arg) {
+    CanalTeste *c = (CanalTeste *)arg;
+    assert(c->canal == canal);
+    LeituraAdc_t leitura;
+    assert(servico_adc_ler(canal, &leitura));
+    assert(leitura.sequencia == c->publicacoes + 1);
+    assert(leitura.conversoes == c->conversoes);
+
+    // A publicação j soma as primeiras conversões do período j do canal
+    uint64_t inicio = (uint64_t)c->publicacoes * c->periodo_quadros;
+    uint32_t soma = 0;
+    uint64_t soma_quadrados = 0;
+    for (uint64_t n = inicio; n < inicio + c->conversoes; n++) {
+        uint32_t valor = valor_conversao(canal, n);
+        soma += valor;
+        soma_quadrados += (uint64_t)valor * valor;
+    }
+    assert(leitura.soma == soma);
+    assert(leitura.soma_quadrados == soma_quadrados);
+    assert(leitura.publicado_em_ms == to_ms_since_boot(get_absolute_time()));
+    c->publicacoes++;
+}
+
+/**
+ * @brief Registra os canais, roda o ADC por algum tempo simulado e confere tudo.
+ */
+static void rodar_cenario(CanalTeste *canais, int num_canais, double segundos) {
+    canais_teste = canais;
+    num_canais_teste = num_canais;
+
+    uint32_t mascara = 0;
+    uint32_t taxa_quadros = SERVICO_ADC_TAXA_MINIMA_QUADROS_HZ;
+    for (int i = 0; i < num_canais; i++) {
+        CanalTeste *c = &canais[i];
+        assert(servico_adc_registrar(c->canal, c->periodo_ms, c->conversoes, conferir_publicacao, c));
+        assert(!servico_adc_registrar(c->canal, c->periodo_ms, c->conversoes, NULL, NULL));
+        mascara |= 1u << c->canal;
+        uint32_t necessaria = (uint32_t)(((uint64_t)c->conversoes * 1000 + c->periodo_ms - 1) / c->periodo_ms);
+        if (necessaria > taxa_quadros) {
+            taxa_quadros = necessaria;
+        }
+    }
+    uint8_t livre = canais[0].canal == 3 ? 2 : 3;
+    assert(!servico_adc_registrar(SERVICO_ADC_NUM_CANAIS, 100, 1, NULL, NULL));
+    assert(!servico_adc_registrar(livre, 0, 1, NULL, NULL));
+    assert(!servico_adc_registrar(livre, SERVICO_ADC_PERIODO_MAXIMO_MS + 1, 1, NULL, NULL));
+    assert(!servico_adc_registrar(livre, 100, 0, NULL, NULL));
+    LeituraAdc_t leitura;
+    assert(!servico_adc_ler(canais[0].canal, &leitura));
+
+    // Taxa de quadros documentada: a maior pedida, com piso e limitada pelo ADC
+    if (taxa_quadros > 500000u / num_canais) {
+        taxa_quadros = 500000u / num_canais;
+    }
+    for (int i = 0; i < num_canais; i++) {
+        uint32_t periodo = (uint32_t)((uint64_t)taxa_quadros * canais[i].periodo_ms / 1000);
+        canais[i].periodo_quadros = periodo < canais[i].conversoes ? canais[i].conversoes : periodo;
+    }
+
+    assert(servico_adc_iniciar());
+    assert(!servico_adc_iniciar());
+    assert(!servico_adc_registrar(livre, 100, 1, NULL, NULL));
+    assert(adc_rodando && fifo_com_dreq);
+    assert(mascara_round_robin == (num_canais > 1 ? mascara : 0));
+    assert(sensor_temperatura_ligado == ((mascara >> SERVICO_ADC_CANAL_TEMPERATURA) & 1u));
+    double esperada = (double)taxa_quadros * num_canais;
+    assert(taxa_conversoes() > esperada * 0.99 && taxa_conversoes() < esperada * 1.01);
+
+    // Dois canais encadeados um no outro, com blocos de quadros inteiros
+    int dma_a = -1, dma_b = -1;
+    for (int k = 0; k < NUM_CANAIS_DMA; k++) {
+        if (dma[k].reservado) {
+            *(dma_a < 0 ? &dma_a : &dma_b) = k;
+        }
+    }
+    assert(dma_b >= 0);
+    assert(dma[dma_a].config.encadear_em == (uint32_t)dma_b && dma[dma_b].config.encadear_em == (uint32_t)dma_a);
+    assert(dma[dma_a].contagem == dma[dma_b].contagem && dma[dma_a].bloco != dma[dma_b].bloco);
+    assert(dma[dma_a].contagem % num_canais == 0 && dma[dma_a].contagem <= SERVICO_ADC_AMOSTRAS_POR_BLOCO);
+
+    while (total_conversoes < segundos * taxa_conversoes()) {
+        passo_dma();
+    }
+
+    uint64_t quadros = conversoes_processadas / num_canais;
+    for (int i = 0; i < num_canais; i++) {
+        CanalTeste *c = &canais[i];
+        // Publica toda vez que um período completa as suas conversões
+        uint64_t completos = quadros / c->periodo_quadros + (quadros % c->periodo_quadros >= c->conversoes);
+        assert(c->publicacoes == completos);
+        printf("    canal %u: %u publicações de %u conversões em %.1f s (pedido a cada %u ms)\n", c->canal,
+               c->publicacoes, c->conversoes, segundos, c->periodo_ms);
+        double pedidas = segundos * 1000.0 / c->periodo_ms;
+        if (c->periodo_quadros == (uint64_t)taxa_quadros * c->periodo_ms / 1000) {
+            assert(c->publicacoes + 1 >= pedidas * 0.99 && c->publicacoes <= pedidas + 1);
+        } else {
+            assert(c->publicacoes < pedidas); // Limitado pelo ADC
+        }
+    }
+}
+
+/**
+ * @brief Roda um cenário num processo filho e informa se passou.
+ */
+static bool cenario(const char *nome, CanalTeste *canais, int num_canais, double segundos) {
+    fflush(stdout);
+    pid_t filho = fork();
+    if (filho == 0) {
+        printf("%s\n", nome);
+        rodar_cenario(canais, num_canais, segundos);
+        fflush(stdout);
+        _exit(0);
+    }
+    int status;
+    waitpid(filho, &status, 0);
+    bool passou = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    printf("%s: %s\n", nome, passou ? "OK" : "FALHOU");
+    return passou;
+}
+
+int main(void) {
+    bool passou = true;
+
+    // rosa_dos_ventos: eixos a cada 10 ms, 16 conversões cada
+    CanalTeste joystick[] = {
+        { .canal = 0, .periodo_ms = 10, .conversoes = 16 },
+        { .canal = 1, .periodo_ms = 10, .conversoes = 16 },
+    };
+    passou &= cenario("joystick", joystick, 2, 1.0);
+
+    // butoes: só a temperatura, uma medida por segundo sobreamostrada 256 vezes
+    CanalTeste temperatura[] = { { .canal = 4, .periodo_ms = 1000, .conversoes = 256 } };
+    passou &= cenario("temperatura", temperatura, 1, 3.0);
+
+    // butoes com SENSOR_TEMP_PERIODO_SAIDA_MS acima de 1 s (e que não divide 1000)
+    CanalTeste temperatura_lenta[] = { { .canal = 4, .periodo_ms = 2500, .conversoes = 256 } };
+    passou &= cenario("temperatura a cada 2,5 s", temperatura_lenta, 1, 8.0);
+
+    // Taxa pedida acima do que o ADC converte: o canal publica mais devagar, mas completo
+    CanalTeste limitado[] = {
+        { .canal = 2, .periodo_ms = 1, .conversoes = 256 },
+        { .canal = 3, .periodo_ms = 1000, .conversoes = 4 },
+    };
+    passou &= cenario("taxa limitada pelo ADC", limitado, 2, 0.2);
+
+    printf(passou ? "OK\n" : "FALHOU\n");
+    return passou ? 0 : 1;
+}
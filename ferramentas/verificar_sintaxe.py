@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+"""Verifica a sintaxe dos dois firmwares no host, sem o Pico SDK.
+
+Compila cada .c de src/ e lib/ dos projetos com o gcc (-c, sem gerar
+objeto), usando os substitutos do SDK, do FreeRTOS e do lwIP em ferramentas/host
+(que só declaram o que os firmwares usam) e o config/ de cada projeto.
+Cada projeto é verificado em todas as variantes de compilação que mudam o
+código compilado; o script termina com erro se algum arquivo não compilar
+ou gerar aviso em alguma delas.
+
+    python3 ferramentas/verificar_sintaxe.py [butoes|rosa_dos_ventos ...]
+
+Não substitui a compilação de verdade: não liga nada, e uma função do SDK
+usada com a assinatura errada só aparece se o substituto declarar a certa.
+"""
+
+import glob
+import os
+import subprocess
+import sys
+
+RAIZ = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SUBSTITUTOS = os.path.join(RAIZ, "ferramentas", "host")
+
+# O firmware usa %lu para uint32_t, que no ARM é unsigned long; no host é
+# unsigned int e o -Wformat reclamaria de todo printf. O -Wcomment é pelo
+# comentário de PROXY_HOST em cliente_http.h, aberto duas vezes.
+# Compila de fato (-c) em vez de -fsyntax-only: avisos como -Wunused-function
+# só saem depois da análise que o -fsyntax-only pula.
+OPCOES = ["-std=c11", "-c", "-o", os.devnull, "-Wall", "-Wextra", "-Wno-unused-parameter", "-Wno-format",
+          "-Wno-comment"]
+
+VARIANTES = {
+    "butoes": {
+        "padrão (SMP)": ["-DFREE_RTOS_KERNEL_SMP=1"],
+        "formato binário": ["-DFREE_RTOS_KERNEL_SMP=1", "-DTELEMETRIA_FORMATO=1"],
+        "baixo consumo": ["-DBAIXO_CONSUMO=1"],
+    },
+    "rosa_dos_ventos": {
+        f"{transporte}, formato {formato}{', um núcleo' if not smp else ''}":
+            [f"-DTRANSPORTE_TELEMETRIA={valor}", f"-DTELEMETRIA_FORMATO={formato}"]
+            + (["-DFREE_RTOS_KERNEL_SMP=1"] if smp else [])
+        for transporte, valor in (("HTTP", 0), ("UDP", 1))
+        for formato in (0, 1, 2)
+        for smp in ((True, False) if formato == 0 else (True,))
+    },
+}
+
+
+def verificar(projeto, nome, definicoes):
+    """Verifica os fontes de um projeto em uma variante; retorna o número de falhas."""
+    diretorio = os.path.join(RAIZ, projeto)
+    inclusoes = ["-I" + SUBSTITUTOS, "-I" + os.path.join(diretorio, "config")]
+    inclusoes += ["-I" + d for d in sorted(glob.glob(os.path.join(diretorio, "lib", "*")))]
+    fontes = sorted(glob.glob(os.path.join(diretorio, "src", "*.c")) +
+                    glob.glob(os.path.join(diretorio, "lib", "*", "*.c")))
+    falhas = 0
+    for fonte in fontes:
+        resultado = subprocess.run(["gcc"] + OPCOES + inclusoes + definicoes + [fonte],
+                                   capture_output=True, text=True)
+        if resultado.returncode != 0 or resultado.stderr:
+            print(f"FALHOU {projeto} [{nome}] {os.path.relpath(fonte, RAIZ)}")
+            print(resultado.stderr, end="")
+            falhas += 1
+    print(f"{projeto} [{nome}]: {'OK' if falhas == 0 else f'{falhas} arquivos com erro'} ({len(fontes)} arquivos)")
+    return falhas
+
+
+def main():
+    projetos = sys.argv[1:] or list(VARIANTES)
+    falhas = 0
+    for projeto in projetos:
+        if projeto not in VARIANTES:
+            print(f"projeto desconhecido: {projeto}")
+            return 2
+        for nome, definicoes in VARIANTES[projeto].items():
+            falhas += verificar(projeto, nome, definicoes)
+    return 1 if falhas else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,80 @@
+/**
+ * @file anel_spsc.c
+ * @brief Implementação do anel sem trava de um produtor e um consumidor
+ *
+ * Só há leituras e escritas atômicas de 32 bits, sem read-modify-write,
+ * que o Cortex-M0+ não tem; no RP2040 elas viram ldr/str com barreiras.
+ */
+
+#include <string.h>
+#include "anel_spsc.h"
+
+/**
+ * @brief Inicializa o anel vazio sobre um armazenamento do chamador.
+ */
+bool anel_spsc_init(AnelSpsc_t *anel, void *elementos, uint32_t tamanho_elemento, uint32_t capacidade,
+                    AvisoAnelSpsc_t aviso) {
+    if (capacidade == 0 || (capacidade & (capacidade - 1)) != 0) {
+        return false;
+    }
+    anel->elementos = (uint8_t *)elementos;
+    anel->tamanho_elemento = tamanho_elemento;
+    anel->mascara = capacidade - 1;
+    anel->aviso = aviso;
+    anel->descartados = 0;
+    atomic_init(&anel->escrita, 0);
+    atomic_init(&anel->leitura, 0);
+    return true;
+}
+
+/**
+ * @brief Copia um elemento para o anel.
+ *
+ * A cópia termina antes da publicação do índice (release), então o
+ * consumidor que vê o índice novo vê o elemento inteiro. A publicação e a
+ * releitura do índice de leitura são sequencialmente consistentes, do
+ * mesmo jeito que a retirada e o teste de vazio em anel_spsc_remover():
+ * ou o produtor vê o anel esvaziado e avisa, ou o consumidor vê o
+ * elemento novo antes de dormir. Sem isso um aviso poderia se perder.
+ */
+bool anel_spsc_inserir(AnelSpsc_t *anel, const void *elemento) {
+    uint32_t escrita = atomic_load_explicit(&anel->escrita, memory_order_relaxed);
+    uint32_t leitura = atomic_load_explicit(&anel->leitura, memory_order_acquire);
+    if (escrita - leitura > anel->mascara) {
+        anel->descartados++;
+        return false;
+    }
+
+    memcpy(anel->elementos + (escrita & anel->mascara) * anel->tamanho_elemento, elemento,
+           anel->tamanho_elemento);
+    atomic_store_explicit(&anel->escrita, escrita + 1, memory_order_seq_cst);
+
+    if (atomic_load_explicit(&anel->leitura, memory_order_seq_cst) == escrita && anel->aviso != NULL) {
+        anel->aviso();
+    }
+    return true;
+}
+
+/**
+ * @brief Copia e retira o elemento mais antigo do anel.
+ */
+bool anel_spsc_remover(AnelSpsc_t *anel, void *elemento) {
+    uint32_t leitura = atomic_load_explicit(&anel->leitura, memory_order_relaxed);
+    if (atomic_load_explicit(&anel->escrita, memory_order_seq_cst) == leitura) {
+        return false;
+    }
+
+    memcpy(elemento, anel->elementos + (leitura & anel->mascara) * anel->tamanho_elemento,
+           anel->tamanho_elemento);
+    // A posição só volta ao produtor depois da cópia
+    atomic_store_explicit(&anel->leitura, leitura + 1, memory_order_seq_cst);
+    return true;
+}
+
+/**
+ * @brief Número de elementos guardados.
+ */
+uint32_t anel_spsc_tamanho(AnelSpsc_t *anel) {
+    uint32_t leitura = atomic_load_explicit(&anel->leitura, memory_order_acquire);
+    return atomic_load_explicit(&anel->escrita, memory_order_acquire) - leitura;
+}
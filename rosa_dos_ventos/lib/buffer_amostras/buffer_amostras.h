@@ -0,0 +1,117 @@
+/**
+ * @file buffer_amostras.h
+ * @brief Interface do buffer circular de amostras com timestamp
+ *
+ * Este arquivo define um buffer circular de capacidade fixa que guarda as
+ * amostras do joystick até que o cliente HTTP as envie em lote.
+ */
+
+#ifndef BUFFER_AMOSTRAS_H
+#define BUFFER_AMOSTRAS_H
+
+#include "pico/stdlib.h"
+#include "joystick.h"
+
+/**
+ * @defgroup BUFFER_AMOSTRAS Buffer de Amostras
+ * @{
+ */
+
+/**
+ * @brief Número máximo de amostras guardadas no buffer
+ *
+ * Quando o buffer está cheio, a amostra mais antiga é sobrescrita.
+ */
+#define BUFFER_AMOSTRAS_CAPACIDADE 64
+
+/**
+ * @brief Amostra do joystick com o instante da aquisição
+ */
+typedef struct {
+    uint32_t sequencia;      /**< Número da amostra, crescente desde o boot */
+    uint32_t timestamp_ms;   /**< Instante da leitura, em ms desde o boot */
+    Joystick estado;         /**< Posição e botão do joystick lidos */
+} Amostra_t;
+
+/**
+ * @brief Buffer circular de amostras
+ */
+typedef struct {
+    Amostra_t amostras[BUFFER_AMOSTRAS_CAPACIDADE]; /**< Armazenamento das amostras */
+    uint16_t inicio;                                /**< Índice da amostra mais antiga */
+    uint16_t quantidade;                            /**< Número de amostras armazenadas */
+    uint32_t descartadas;                           /**< Amostras sobrescritas por falta de espaço */
+    uint32_t coalescidas;                           /**< Amostras substituídas pela seguinte antes do envio */
+    bool ultima_ao_vivo;                            /**< A mais recente pode ser coalescida (não foi reposta do log) */
+} BufferAmostras_t;
+
+/**
+ * @brief Esvazia o buffer e zera os contadores.
+ * @param buffer Ponteiro para o buffer a ser inicializado
+ */
+void buffer_amostras_init(BufferAmostras_t *buffer);
+
+/**
+ * @brief Insere uma amostra no fim do buffer.
+ *
+ * Se o buffer estiver cheio, a amostra mais antiga é descartada.
+ *
+ * @param buffer Ponteiro para o buffer
+ * @param amostra Amostra a ser copiada para o buffer
+ */
+void buffer_amostras_inserir(BufferAmostras_t *buffer, const Amostra_t *amostra);
+
+/**
+ * @brief Insere uma amostra reposta do log no fim do buffer.
+ *
+ * Igual a buffer_amostras_inserir(), mas a amostra é histórica e nunca é
+ * substituída por buffer_amostras_coalescer().
+ *
+ * @param buffer Ponteiro para o buffer
+ * @param amostra Amostra a ser copiada para o buffer
+ */
+void buffer_amostras_inserir_reposta(BufferAmostras_t *buffer, const Amostra_t *amostra);
+
+/**
+ * @brief Insere uma amostra, coalescendo-a com a mais recente se o buffer já tem amostras suficientes.
+ *
+ * Com menos de @p limite amostras, equivale a buffer_amostras_inserir().
+ * A partir daí a amostra substitui a mais recente, que ainda não foi
+ * enviada: o buffer guarda apenas o último estado pendente em vez de
+ * acumular estados intermediários que o envio não consegue acompanhar.
+ * Se a mais recente foi reposta do log, ela é preservada e a amostra é
+ * inserida depois dela.
+ *
+ * @param buffer Ponteiro para o buffer
+ * @param amostra Amostra a ser copiada para o buffer
+ * @param limite Quantidade de amostras a partir da qual a coalescência começa (maior que zero)
+ * @return true se a amostra substituiu a mais recente, false se foi inserida
+ */
+bool buffer_amostras_coalescer(BufferAmostras_t *buffer, const Amostra_t *amostra, uint16_t limite);
+
+/**
+ * @brief Consulta a amostra mais antiga sem removê-la.
+ * @param buffer Ponteiro para o buffer
+ * @param amostra Destino da cópia da amostra
+ * @return true se havia amostra, false se o buffer está vazio
+ */
+bool buffer_amostras_espiar(const BufferAmostras_t *buffer, Amostra_t *amostra);
+
+/**
+ * @brief Remove a amostra mais antiga do buffer.
+ * @param buffer Ponteiro para o buffer
+ * @param amostra Destino da cópia da amostra removida (pode ser NULL)
+ * @return true se havia amostra, false se o buffer está vazio
+ */
+bool buffer_amostras_remover(BufferAmostras_t *buffer, Amostra_t *amostra);
+
+/**
+ * @brief Retorna o número de amostras armazenadas.
+ * @param buffer Ponteiro para o buffer
+ * @return Quantidade de amostras no buffer
+ */
+uint16_t buffer_amostras_tamanho(const BufferAmostras_t *buffer);
+
+/** @} */ // Fim do grupo BUFFER_AMOSTRAS
+
+#endif // BUFFER_AMOSTRAS_H
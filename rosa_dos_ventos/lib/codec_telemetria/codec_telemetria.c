@@ -0,0 +1,180 @@
+/**
+ * @file codec_telemetria.c
+ * @brief Implementação do codificador de lotes de telemetria
+ *
+ * No formato binário os campos são escritos byte a byte em little-endian,
+ * sem depender do layout das structs em memória. Cada eixo cabe em um
+ * byte, já que as posições são normalizadas para 0-100.
+ *
+ * No formato diferencial cada diferença passa pelo zig-zag (0, -1, 1, -2,
+ * ... viram 0, 1, 2, 3, ...) para que valores pequenos, positivos ou
+ * negativos, caibam em um único byte de varint.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "codec_telemetria.h"
+
+#if TELEMETRIA_FORMATO == TELEMETRIA_FORMATO_BINARIO || TELEMETRIA_FORMATO == TELEMETRIA_FORMATO_DELTA
+/**
+ * @brief Escreve um inteiro de 16 bits em little-endian.
+ */
+static void escrever_u16_le(uint8_t *destino, uint16_t valor) {
+    destino[0] = (uint8_t)(valor & 0xFF);
+    destino[1] = (uint8_t)(valor >> 8);
+}
+
+/**
+ * @brief Escreve um inteiro de 32 bits em little-endian.
+ */
+static void escrever_u32_le(uint8_t *destino, uint32_t valor) {
+    destino[0] = (uint8_t)(valor & 0xFF);
+    destino[1] = (uint8_t)((valor >> 8) & 0xFF);
+    destino[2] = (uint8_t)((valor >> 16) & 0xFF);
+    destino[3] = (uint8_t)(valor >> 24);
+}
+#endif
+
+#if TELEMETRIA_FORMATO == TELEMETRIA_FORMATO_DELTA
+/**
+ * @brief Mapeia um inteiro com sinal para sem sinal intercalando os sinais.
+ */
+static uint32_t zigzag(int32_t valor) {
+    return ((uint32_t)valor << 1) ^ (uint32_t)(valor >> 31);
+}
+
+/**
+ * @brief Escreve um inteiro como varint (7 bits por byte, bit 7 indica continuação).
+ * @return Número de bytes escritos (1 a 5)
+ */
+static size_t escrever_varint(uint8_t *destino, uint32_t valor) {
+    size_t tamanho = 0;
+    while (valor >= 0x80) {
+        destino[tamanho++] = (uint8_t)(valor | 0x80);
+        valor >>= 7;
+    }
+    destino[tamanho++] = (uint8_t)valor;
+    return tamanho;
+}
+#endif
+
+/**
+ * @brief Retorna o valor do cabeçalho Content-Type do formato selecionado.
+ */
+const char *codec_telemetria_content_type(void) {
+#if TELEMETRIA_FORMATO == TELEMETRIA_FORMATO_BINARIO
+    return "application/vnd.embarcatech.telemetria; esquema=2";
+#elif TELEMETRIA_FORMATO == TELEMETRIA_FORMATO_DELTA
+    return "application/vnd.embarcatech.telemetria; esquema=3";
+#else
+    return "application/json";
+#endif
+}
+
+/**
+ * @brief Começa um novo lote no buffer de saída.
+ *
+ * No formato JSON abre o array; no binário reserva o cabeçalho, cuja
+ * quantidade só é conhecida no fechamento.
+ */
+void codec_telemetria_iniciar_lote(CodificadorLote_t *codificador, uint8_t *destino, size_t capacidade) {
+    codificador->destino = destino;
+    codificador->capacidade = capacidade;
+    codificador->quantidade = 0;
+#if TELEMETRIA_FORMATO == TELEMETRIA_FORMATO_BINARIO
+    destino[0] = TELEMETRIA_ESQUEMA_JOYSTICK;
+    codificador->usado = TELEMETRIA_TAMANHO_CABECALHO;
+#elif TELEMETRIA_FORMATO == TELEMETRIA_FORMATO_DELTA
+    destino[0] = TELEMETRIA_ESQUEMA_JOYSTICK_DELTA;
+    codificador->usado = TELEMETRIA_TAMANHO_CABECALHO;
+#else
+    destino[0] = '[';
+    codificador->usado = 1;
+#endif
+}
+
+/**
+ * @brief Acrescenta uma amostra ao lote.
+ */
+bool codec_telemetria_adicionar(CodificadorLote_t *codificador, const Amostra_t *amostra) {
+    uint8_t *cursor = codificador->destino + codificador->usado;
+
+#if TELEMETRIA_FORMATO == TELEMETRIA_FORMATO_BINARIO
+    if (codificador->usado + TELEMETRIA_TAMANHO_REGISTRO > codificador->capacidade) {
+        return false;
+    }
+    escrever_u32_le(cursor, amostra->sequencia);
+    escrever_u32_le(cursor + 4, amostra->timestamp_ms);
+    cursor[8] = (uint8_t)amostra->estado.x_position;
+    cursor[9] = (uint8_t)amostra->estado.y_position;
+    cursor[10] = amostra->estado.button_pressed;
+    codificador->usado += TELEMETRIA_TAMANHO_REGISTRO;
+#elif TELEMETRIA_FORMATO == TELEMETRIA_FORMATO_DELTA
+    if (codificador->quantidade == 0) {
+        if (codificador->usado + TELEMETRIA_TAMANHO_REGISTRO > codificador->capacidade) {
+            return false;
+        }
+        escrever_u32_le(cursor, amostra->sequencia);
+        escrever_u32_le(cursor + 4, amostra->timestamp_ms);
+        cursor[8] = (uint8_t)amostra->estado.x_position;
+        cursor[9] = (uint8_t)amostra->estado.y_position;
+        cursor[10] = amostra->estado.button_pressed;
+        codificador->usado += TELEMETRIA_TAMANHO_REGISTRO;
+    } else {
+        // Codifica em um rascunho para só escrever se a amostra couber inteira
+        uint8_t rascunho[TELEMETRIA_TAMANHO_MAX_DELTA];
+        const Amostra_t *anterior = &codificador->anterior;
+        size_t tamanho = 0;
+        tamanho += escrever_varint(rascunho + tamanho,
+                                   zigzag((int32_t)(amostra->sequencia - anterior->sequencia)));
+        tamanho += escrever_varint(rascunho + tamanho,
+                                   zigzag((int32_t)(amostra->timestamp_ms - anterior->timestamp_ms)));
+        tamanho += escrever_varint(rascunho + tamanho,
+                                   zigzag(amostra->estado.x_position - anterior->estado.x_position));
+        tamanho += escrever_varint(rascunho + tamanho,
+                                   zigzag(amostra->estado.y_position - anterior->estado.y_position));
+        tamanho += escrever_varint(rascunho + tamanho,
+                                   zigzag((int32_t)amostra->estado.button_pressed - anterior->estado.button_pressed));
+        if (codificador->usado + tamanho > codificador->capacidade) {
+            return false;
+        }
+        memcpy(cursor, rascunho, tamanho);
+        codificador->usado += tamanho;
+    }
+    codificador->anterior = *amostra;
+#else
+    // Reserva o separador, o ']' de fechamento e o terminador do snprintf
+    size_t separador = (codificador->quantidade > 0) ? 1 : 0;
+    if (codificador->usado + separador + 2 > codificador->capacidade) {
+        return false;
+    }
+    size_t livre = codificador->capacidade - codificador->usado - separador - 2;
+    int escrito = snprintf((char *)cursor + separador, livre + 1,
+                           "{\"seq\": %lu, \"t\": %lu, \"x\": %d, \"y\": %d, \"button\": %d}",
+                           (unsigned long)amostra->sequencia, (unsigned long)amostra->timestamp_ms,
+                           amostra->estado.x_position, amostra->estado.y_position,
+                           amostra->estado.button_pressed);
+    if (escrito < 0 || (size_t)escrito > livre) {
+        return false;
+    }
+    if (separador) {
+        cursor[0] = ',';
+    }
+    codificador->usado += separador + (size_t)escrito;
+#endif
+
+    codificador->quantidade++;
+    return true;
+}
+
+/**
+ * @brief Fecha o lote.
+ */
+size_t codec_telemetria_finalizar_lote(CodificadorLote_t *codificador) {
+#if TELEMETRIA_FORMATO == TELEMETRIA_FORMATO_BINARIO || TELEMETRIA_FORMATO == TELEMETRIA_FORMATO_DELTA
+    escrever_u16_le(codificador->destino + 1, codificador->quantidade);
+#else
+    codificador->destino[codificador->usado++] = ']';
+#endif
+    return codificador->usado;
+}
@@ -0,0 +1,137 @@
+/**
+ * @file codec_telemetria.h
+ * @brief Interface do codificador de lotes de telemetria
+ *
+ * Este arquivo define o codificador usado pelo cliente HTTP para serializar
+ * um lote de amostras do joystick. Há três formatos: JSON
+ * (texto, compatível com o servidor original), um registro binário
+ * compacto de tamanho fixo em little-endian e um formato diferencial com
+ * varints, os dois últimos identificados por um ID de esquema. O formato é escolhido em tempo de compilação e anunciado no
+ * cabeçalho Content-Type.
+ */
+
+#ifndef CODEC_TELEMETRIA_H
+#define CODEC_TELEMETRIA_H
+
+#include <stddef.h>
+#include "pico/stdlib.h"
+#include "buffer_amostras.h"
+
+/**
+ * @defgroup CODEC_TELEMETRIA Codificador de Telemetria
+ * @{
+ */
+
+/**
+ * @brief Formato texto: array JSON de objetos
+ */
+#define TELEMETRIA_FORMATO_JSON 0
+
+/**
+ * @brief Formato binário compacto: cabeçalho + registros little-endian de tamanho fixo
+ */
+#define TELEMETRIA_FORMATO_BINARIO 1
+
+/**
+ * @brief Formato diferencial: primeira amostra completa, demais como deltas em varint
+ */
+#define TELEMETRIA_FORMATO_DELTA 2
+
+/**
+ * @brief Formato usado nos envios (pode ser sobrescrito na linha de compilação)
+ */
+#ifndef TELEMETRIA_FORMATO
+#define TELEMETRIA_FORMATO TELEMETRIA_FORMATO_JSON
+#endif
+
+/**
+ * @brief ID de esquema dos registros binários do joystick
+ *
+ * Layout do lote binário:
+ * - byte 0: ID de esquema (TELEMETRIA_ESQUEMA_JOYSTICK)
+ * - bytes 1-2: quantidade de registros (uint16 little-endian)
+ * - registros de TELEMETRIA_TAMANHO_REGISTRO bytes cada:
+ *   - uint32 número de sequência da amostra
+ *   - uint32 timestamp em ms desde o boot
+ *   - uint8 posição X (0-100)
+ *   - uint8 posição Y (0-100)
+ *   - uint8 botão (0 = solto, 1 = pressionado)
+ */
+#define TELEMETRIA_ESQUEMA_JOYSTICK 0x02
+
+/**
+ * @brief ID de esquema dos lotes diferenciais do joystick
+ *
+ * Layout do lote diferencial:
+ * - bytes 0-2: mesmo cabeçalho do lote binário, com TELEMETRIA_ESQUEMA_JOYSTICK_DELTA
+ * - primeira amostra completa, no layout de TELEMETRIA_ESQUEMA_JOYSTICK
+ * - cada amostra seguinte como cinco varints (LEB128, 7 bits por byte) com
+ *   a diferença zig-zag para a amostra anterior, nesta ordem: sequência,
+ *   timestamp, X, Y e botão
+ *
+ * Como a sequência avança de um em um e X e Y variam poucas unidades entre
+ * leituras, uma amostra típica ocupa 5 bytes em vez de 11.
+ */
+#define TELEMETRIA_ESQUEMA_JOYSTICK_DELTA 0x03
+
+/**
+ * @brief Maior tamanho possível, em bytes, de uma amostra diferencial
+ */
+#define TELEMETRIA_TAMANHO_MAX_DELTA 16
+
+/**
+ * @brief Tamanho, em bytes, do cabeçalho de um lote binário
+ */
+#define TELEMETRIA_TAMANHO_CABECALHO 3
+
+/**
+ * @brief Tamanho, em bytes, de cada registro binário
+ */
+#define TELEMETRIA_TAMANHO_REGISTRO 11
+
+/**
+ * @brief Estado de um lote em codificação
+ */
+typedef struct {
+    uint8_t *destino;    /**< Início do buffer de saída */
+    size_t capacidade;   /**< Tamanho do buffer de saída */
+    size_t usado;        /**< Bytes já escritos */
+    uint16_t quantidade; /**< Amostras já adicionadas */
+    Amostra_t anterior;  /**< Última amostra adicionada (base do próximo delta) */
+} CodificadorLote_t;
+
+/**
+ * @brief Retorna o valor do cabeçalho Content-Type do formato selecionado.
+ * @return String constante com o tipo de mídia
+ */
+const char *codec_telemetria_content_type(void);
+
+/**
+ * @brief Começa um novo lote no buffer de saída.
+ * @param codificador Estado do lote
+ * @param destino Buffer de saída
+ * @param capacidade Tamanho do buffer de saída
+ */
+void codec_telemetria_iniciar_lote(CodificadorLote_t *codificador, uint8_t *destino, size_t capacidade);
+
+/**
+ * @brief Acrescenta uma amostra ao lote.
+ *
+ * Nada é escrito se a amostra não couber junto com o fechamento do lote.
+ *
+ * @param codificador Estado do lote
+ * @param amostra Amostra a ser codificada
+ * @return true se a amostra foi adicionada, false se não havia espaço
+ */
+bool codec_telemetria_adicionar(CodificadorLote_t *codificador, const Amostra_t *amostra);
+
+/**
+ * @brief Fecha o lote.
+ * @param codificador Estado do lote
+ * @return Tamanho final do lote, em bytes
+ */
+size_t codec_telemetria_finalizar_lote(CodificadorLote_t *codificador);
+
+/** @} */ // Fim do grupo CODEC_TELEMETRIA
+
+#endif // CODEC_TELEMETRIA_H
@@ -0,0 +1,51 @@
+/**
+ * @file detector_mudanca.c
+ * @brief Implementação do detector de mudança com histerese
+ */
+
+#include <string.h>
+#include "detector_mudanca.h"
+
+/**
+ * @brief Inicializa o detector de um campo.
+ */
+void detector_mudanca_init(DetectorMudanca_t *detector, const ConfigDetector_t *config) {
+    memset(detector, 0, sizeof(DetectorMudanca_t));
+    detector->config = *config;
+}
+
+/**
+ * @brief Entrega uma nova leitura do campo ao detector.
+ */
+bool detector_mudanca_atualizar(DetectorMudanca_t *detector, int32_t valor, uint32_t agora_ms) {
+    if (!detector->iniciado) {
+        detector->iniciado = true;
+        detector->valor_aceito = valor;
+        detector->aceito_em_ms = agora_ms;
+        return true;
+    }
+
+    int32_t diferenca = valor - detector->valor_aceito;
+    if (diferenca < 0) {
+        diferenca = -diferenca;
+    }
+    if (diferenca <= detector->config.banda) {
+        detector->candidato = false;
+        return false;
+    }
+
+    if (!detector->candidato) {
+        detector->candidato = true;
+        detector->candidato_desde_ms = agora_ms;
+    }
+    if (agora_ms - detector->candidato_desde_ms < detector->config.debounce_ms ||
+        agora_ms - detector->aceito_em_ms < detector->config.permanencia_minima_ms) {
+        detector->suprimidas++;
+        return false;
+    }
+
+    detector->valor_aceito = valor;
+    detector->aceito_em_ms = agora_ms;
+    detector->candidato = false;
+    return true;
+}
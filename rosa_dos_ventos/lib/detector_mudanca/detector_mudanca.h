@@ -0,0 +1,78 @@
+/**
+ * @file detector_mudanca.h
+ * @brief Interface do detector de mudança com histerese para campos amostrados
+ *
+ * Cada campo monitorado (um eixo do joystick, a temperatura, um botão) tem
+ * o seu detector. Um valor novo só é aceito como mudança quando:
+ * - se afasta do último valor aceito por mais que a banda morta (histerese);
+ * - fica fora da banda de forma contínua durante a janela de debounce;
+ * - já passou a permanência mínima desde a última mudança aceita.
+ *
+ * Assim o ruído do ADC com o sensor parado não gera amostras, logs nem
+ * envios, e uma variação real aparece uma única vez, já estabilizada.
+ */
+
+#ifndef DETECTOR_MUDANCA_H
+#define DETECTOR_MUDANCA_H
+
+#include "pico/stdlib.h"
+
+/**
+ * @defgroup DETECTOR_MUDANCA Detector de Mudança
+ * @{
+ */
+
+/**
+ * @brief Parâmetros de um campo
+ */
+typedef struct {
+    int32_t banda;                 /**< Maior diferença, nas unidades do campo, tratada como ruído */
+    uint32_t debounce_ms;          /**< Tempo contínuo fora da banda antes de aceitar a mudança */
+    uint32_t permanencia_minima_ms; /**< Intervalo mínimo entre duas mudanças aceitas */
+} ConfigDetector_t;
+
+/**
+ * @brief Estado do detector de um campo
+ */
+typedef struct {
+    ConfigDetector_t config;       /**< Parâmetros do campo */
+    int32_t valor_aceito;          /**< Último valor aceito como mudança */
+    bool iniciado;                 /**< Já recebeu o primeiro valor */
+    bool candidato;                /**< O valor atual está fora da banda */
+    uint32_t candidato_desde_ms;   /**< Desde quando o valor está fora da banda */
+    uint32_t aceito_em_ms;         /**< Instante da última mudança aceita */
+    uint32_t suprimidas;           /**< Leituras fora da banda descartadas pelo debounce ou pela permanência */
+} DetectorMudanca_t;
+
+/**
+ * @brief Inicializa o detector de um campo.
+ * @param detector Detector a inicializar
+ * @param config Parâmetros do campo
+ */
+void detector_mudanca_init(DetectorMudanca_t *detector, const ConfigDetector_t *config);
+
+/**
+ * @brief Entrega uma nova leitura do campo ao detector.
+ *
+ * A primeira leitura é sempre aceita. Uma leitura que volta para dentro da
+ * banda cancela a mudança em andamento e reinicia o debounce.
+ *
+ * @param detector Detector do campo
+ * @param valor Leitura atual
+ * @param agora_ms Instante da leitura, em ms desde o boot
+ * @return true se a leitura foi aceita como mudança (passa a ser o valor aceito)
+ */
+bool detector_mudanca_atualizar(DetectorMudanca_t *detector, int32_t valor, uint32_t agora_ms);
+
+/**
+ * @brief Retorna o último valor aceito.
+ * @param detector Detector do campo
+ * @return Valor aceito mais recente
+ */
+static inline int32_t detector_mudanca_valor(const DetectorMudanca_t *detector) {
+    return detector->valor_aceito;
+}
+
+/** @} */ // Fim do grupo DETECTOR_MUDANCA
+
+#endif // DETECTOR_MUDANCA_H
@@ -0,0 +1,150 @@
+/**
+ * @file calibracao_joystick.c
+ * @brief Captura da calibração do joystick e armazenamento na flash
+ *
+ * A calibração ocupa o primeiro registro de um setor reservado logo antes
+ * da região do log de amostras. A leitura é feita direto pela janela XIP;
+ * o apagamento e a programação rodam dentro de flash_safe_execute(), como
+ * no log.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "hardware/flash.h"
+#include "pico/flash.h"
+#include "direcao_joystick.h"
+#include "joystick.h"
+#include "log_flash.h"
+
+/** @brief Deslocamento do setor da calibração a partir do início da flash */
+#define CALIBRACAO_DESLOCAMENTO (PICO_FLASH_SIZE_BYTES - LOG_FLASH_TAMANHO_REGIAO - FLASH_SECTOR_SIZE)
+
+/** @brief Tempo máximo, em ms, para suspender o outro núcleo antes de desistir */
+#define CALIBRACAO_TIMEOUT_BLOQUEIO_MS 100
+
+/** @brief Identifica um registro de calibração ("CJ") */
+#define MAGICO_CALIBRACAO 0x434A
+
+/** @brief Intervalo, em ms, entre as leituras da captura */
+#define CALIBRACAO_INTERVALO_LEITURA_MS 5
+
+/**
+ * @brief Registro gravado na flash
+ */
+typedef struct {
+    uint16_t magico;                  /**< MAGICO_CALIBRACAO */
+    uint16_t verificacao;             /**< Complemento da soma das palavras da calibração */
+    CalibracaoJoystick_t calibracao;  /**< Calibração guardada */
+} RegistroCalibracao;
+
+_Static_assert(sizeof(RegistroCalibracao) <= FLASH_PAGE_SIZE, "registro de calibração maior que uma página");
+
+/**
+ * @brief Calcula a palavra de verificação de uma calibração.
+ */
+static uint16_t calcular_verificacao(const CalibracaoJoystick_t *calibracao) {
+    const uint16_t *palavras = (const uint16_t *)calibracao;
+    uint16_t soma = MAGICO_CALIBRACAO;
+    for (size_t i = 0; i < sizeof(CalibracaoJoystick_t) / sizeof(uint16_t); i++) {
+        soma += palavras[i];
+    }
+    return (uint16_t)~soma;
+}
+
+/**
+ * @brief Preenche uma calibração nominal: centro em 2048 e extremos em 0 e 4095.
+ */
+void calibracao_joystick_padrao(CalibracaoJoystick_t *calibracao) {
+    calibracao->centro_x = 2048;
+    calibracao->minimo_x = 0;
+    calibracao->maximo_x = 4095;
+    calibracao->centro_y = 2048;
+    calibracao->minimo_y = 0;
+    calibracao->maximo_y = 4095;
+}
+
+/**
+ * @brief Indica se a calibração é coerente (centro entre os extremos, com folga).
+ */
+bool calibracao_joystick_valida(const CalibracaoJoystick_t *calibracao) {
+    return calibracao->maximo_x <= 4095 && calibracao->maximo_y <= 4095 &&
+           calibracao->centro_x >= calibracao->minimo_x + CALIBRACAO_EXCURSAO_MINIMA &&
+           calibracao->maximo_x >= calibracao->centro_x + CALIBRACAO_EXCURSAO_MINIMA &&
+           calibracao->centro_y >= calibracao->minimo_y + CALIBRACAO_EXCURSAO_MINIMA &&
+           calibracao->maximo_y >= calibracao->centro_y + CALIBRACAO_EXCURSAO_MINIMA;
+}
+
+/**
+ * @brief Captura a calibração do joystick, bloqueando por alguns segundos.
+ */
+bool calibracao_joystick_capturar(CalibracaoJoystick_t *calibracao) {
+    Joystick leitura;
+
+    printf("Calibração: solte o joystick no centro...\n");
+    sleep_ms(1000);
+    uint32_t soma_x = 0, soma_y = 0;
+    for (uint16_t i = 0; i < CALIBRACAO_AMOSTRAS_CENTRO; i++) {
+        read_joystick(&leitura);
+        soma_x += leitura.x_bruto;
+        soma_y += leitura.y_bruto;
+        sleep_ms(CALIBRACAO_INTERVALO_LEITURA_MS);
+    }
+    calibracao->centro_x = (uint16_t)(soma_x / CALIBRACAO_AMOSTRAS_CENTRO);
+    calibracao->centro_y = (uint16_t)(soma_y / CALIBRACAO_AMOSTRAS_CENTRO);
+    calibracao->minimo_x = calibracao->maximo_x = calibracao->centro_x;
+    calibracao->minimo_y = calibracao->maximo_y = calibracao->centro_y;
+
+    printf("Calibração: gire o joystick até os limites por %u s...\n", CALIBRACAO_DURACAO_EXTREMOS_MS / 1000);
+    absolute_time_t fim = make_timeout_time_ms(CALIBRACAO_DURACAO_EXTREMOS_MS);
+    while (absolute_time_diff_us(get_absolute_time(), fim) > 0) {
+        read_joystick(&leitura);
+        if (leitura.x_bruto < calibracao->minimo_x) calibracao->minimo_x = leitura.x_bruto;
+        if (leitura.x_bruto > calibracao->maximo_x) calibracao->maximo_x = leitura.x_bruto;
+        if (leitura.y_bruto < calibracao->minimo_y) calibracao->minimo_y = leitura.y_bruto;
+        if (leitura.y_bruto > calibracao->maximo_y) calibracao->maximo_y = leitura.y_bruto;
+        sleep_ms(CALIBRACAO_INTERVALO_LEITURA_MS);
+    }
+
+    printf("Calibração: X %u/%u/%u, Y %u/%u/%u (mínimo/centro/máximo)\n",
+           calibracao->minimo_x, calibracao->centro_x, calibracao->maximo_x,
+           calibracao->minimo_y, calibracao->centro_y, calibracao->maximo_y);
+    return calibracao_joystick_valida(calibracao);
+}
+
+/**
+ * @brief Lê a calibração guardada na flash.
+ */
+bool calibracao_joystick_carregar(CalibracaoJoystick_t *calibracao) {
+    RegistroCalibracao registro;
+    memcpy(&registro, (const void *)(XIP_BASE + CALIBRACAO_DESLOCAMENTO), sizeof(registro));
+    if (registro.magico != MAGICO_CALIBRACAO ||
+        registro.verificacao != calcular_verificacao(&registro.calibracao) ||
+        !calibracao_joystick_valida(&registro.calibracao)) {
+        return false;
+    }
+    *calibracao = registro.calibracao;
+    return true;
+}
+
+/**
+ * @brief Apaga o setor da calibração e programa a página com o registro (chamada por flash_safe_execute()).
+ */
+static void gravar_setor(void *param) {
+    flash_range_erase(CALIBRACAO_DESLOCAMENTO, FLASH_SECTOR_SIZE);
+    flash_range_program(CALIBRACAO_DESLOCAMENTO, (const uint8_t *)param, FLASH_PAGE_SIZE);
+}
+
+/**
+ * @brief Grava a calibração na flash, apagando a anterior.
+ */
+bool calibracao_joystick_salvar(const CalibracaoJoystick_t *calibracao) {
+    static uint8_t pagina[FLASH_PAGE_SIZE];
+    RegistroCalibracao registro = {
+        .magico = MAGICO_CALIBRACAO,
+        .verificacao = calcular_verificacao(calibracao),
+        .calibracao = *calibracao
+    };
+    memset(pagina, 0xFF, sizeof(pagina));
+    memcpy(pagina, &registro, sizeof(registro));
+    return flash_safe_execute(gravar_setor, pagina, CALIBRACAO_TIMEOUT_BLOQUEIO_MS) == PICO_OK;
+}
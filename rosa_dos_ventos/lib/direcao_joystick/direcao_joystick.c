@@ -0,0 +1,111 @@
+/**
+ * @file direcao_joystick.c
+ * @brief Decodificação de direção e magnitude do joystick por tabelas
+ *
+ * Cada leitura é levada a -127..127 com uma subtração e uma multiplicação
+ * por um fator Q16 calculado ao aplicar a calibração. O valor absoluto dos
+ * dois eixos indexa as tabelas do primeiro quadrante (ângulo e magnitude);
+ * os sinais levam o ângulo ao quadrante certo e a tabela de setores dá a
+ * direção.
+ */
+
+#include "direcao_joystick.h"
+#include "tabela_direcoes.h"
+
+/** @brief Maior valor absoluto de um eixo calibrado */
+#define EIXO_MAXIMO 127
+
+#if DIRECAO_JOYSTICK_SETORES == 8
+#define TABELA_SETOR TABELA_SETOR_8
+/** @brief Direção de cada setor, a partir do leste no sentido anti-horário */
+static const JoystickDirection DIRECAO_DO_SETOR[8] = {
+    LESTE, NORDESTE, NORTE, NOROESTE, OESTE, SUDOESTE, SUL, SUDESTE
+};
+#elif DIRECAO_JOYSTICK_SETORES == 16
+#define TABELA_SETOR TABELA_SETOR_16
+/** @brief Direção de cada setor, a partir do leste no sentido anti-horário */
+static const JoystickDirection DIRECAO_DO_SETOR[16] = {
+    LESTE, LES_NORDESTE, NORDESTE, NOR_NORDESTE, NORTE, NOR_NOROESTE, NOROESTE, OES_NOROESTE,
+    OESTE, OES_SUDOESTE, SUDOESTE, SUL_SUDOESTE, SUL, SUL_SUDESTE, SUDESTE, LES_SUDESTE
+};
+#else
+#error "DIRECAO_JOYSTICK_SETORES deve ser 8 ou 16"
+#endif
+
+/**
+ * @brief Parâmetros de um eixo já prontos para a decodificação
+ */
+typedef struct {
+    int32_t centro;            /**< Leitura bruta no centro */
+    int32_t escala_positiva;   /**< EIXO_MAXIMO / (máximo - centro), em Q16 */
+    int32_t escala_negativa;   /**< EIXO_MAXIMO / (centro - mínimo), em Q16 */
+} EixoCalibrado;
+
+/** @brief Eixos em uso na decodificação */
+static EixoCalibrado eixo_x, eixo_y;
+
+/** @brief Indica se já há uma calibração aplicada */
+static bool calibracao_aplicada = false;
+
+/**
+ * @brief Calcula os fatores de escala de um eixo.
+ */
+static void preparar_eixo(EixoCalibrado *eixo, uint16_t centro, uint16_t minimo, uint16_t maximo) {
+    eixo->centro = centro;
+    eixo->escala_positiva = (EIXO_MAXIMO << 16) / (maximo - centro);
+    eixo->escala_negativa = (EIXO_MAXIMO << 16) / (centro - minimo);
+}
+
+/**
+ * @brief Leva uma leitura bruta a -EIXO_MAXIMO..EIXO_MAXIMO.
+ */
+static int32_t normalizar_eixo(const EixoCalibrado *eixo, uint16_t bruto) {
+    int32_t desvio = (int32_t)bruto - eixo->centro;
+    int32_t valor = desvio >= 0 ? (desvio * eixo->escala_positiva) >> 16
+                                : -((-desvio * eixo->escala_negativa) >> 16);
+    if (valor > EIXO_MAXIMO) return EIXO_MAXIMO;
+    if (valor < -EIXO_MAXIMO) return -EIXO_MAXIMO;
+    return valor;
+}
+
+/**
+ * @brief Passa a usar a calibração na decodificação.
+ */
+void direcao_joystick_aplicar_calibracao(const CalibracaoJoystick_t *calibracao) {
+    preparar_eixo(&eixo_x, calibracao->centro_x, calibracao->minimo_x, calibracao->maximo_x);
+    preparar_eixo(&eixo_y, calibracao->centro_y, calibracao->minimo_y, calibracao->maximo_y);
+    calibracao_aplicada = true;
+}
+
+/**
+ * @brief Decodifica direção e magnitude a partir das leituras brutas.
+ */
+JoystickDirection direcao_joystick_decodificar(uint16_t x_bruto, uint16_t y_bruto, uint8_t *magnitude) {
+    if (!calibracao_aplicada) {
+        CalibracaoJoystick_t padrao;
+        calibracao_joystick_padrao(&padrao);
+        direcao_joystick_aplicar_calibracao(&padrao);
+    }
+
+    int32_t x = normalizar_eixo(&eixo_x, x_bruto);
+    int32_t y = normalizar_eixo(&eixo_y, y_bruto);
+    uint32_t i = (uint32_t)(x < 0 ? -x : x) >> TABELA_DIRECOES_DESLOCAMENTO;
+    uint32_t j = (uint32_t)(y < 0 ? -y : y) >> TABELA_DIRECOES_DESLOCAMENTO;
+
+    uint8_t deflexao = TABELA_MAGNITUDE_QUADRANTE[i][j];
+    if (magnitude) {
+        *magnitude = deflexao;
+    }
+    if (deflexao < DIRECAO_JOYSTICK_ZONA_MORTA) {
+        return CENTRO;
+    }
+
+    // Ângulo do primeiro quadrante refletido para o quadrante dos sinais (volta de 256 passos)
+    uint8_t angulo = TABELA_ANGULO_QUADRANTE[i][j];
+    if (x < 0) {
+        angulo = (uint8_t)(y < 0 ? 128 + angulo : 128 - angulo);
+    } else if (y < 0) {
+        angulo = (uint8_t)(256 - angulo);
+    }
+    return DIRECAO_DO_SETOR[TABELA_SETOR[angulo]];
+}
@@ -0,0 +1,160 @@
+/**
+ * @file direcao_joystick.h
+ * @brief Interface da calibração e da decodificação de direção do joystick
+ *
+ * A calibração guarda, para cada eixo, a leitura bruta no centro e nos dois
+ * extremos. Com ela as leituras são levadas a -127..127 com o zero no centro
+ * real do joystick, e a direção e a magnitude saem de tabelas geradas em
+ * tempo de compilação (tabela_direcoes.h), com zona morta radial.
+ *
+ * A calibração é capturada ao ligar a placa com o botão do joystick
+ * pressionado e fica em um setor próprio da flash, logo antes da região do
+ * log de amostras.
+ */
+
+#ifndef DIRECAO_JOYSTICK_H
+#define DIRECAO_JOYSTICK_H
+
+#include "pico/stdlib.h"
+
+/**
+ * @defgroup DIRECAO_JOYSTICK Calibração e Direção do Joystick
+ * @{
+ */
+
+/**
+ * @brief Número de direções decodificadas: 8 ou 16 (pode ser sobrescrito na linha de compilação)
+ */
+#ifndef DIRECAO_JOYSTICK_SETORES
+#define DIRECAO_JOYSTICK_SETORES 8
+#endif
+
+/**
+ * @brief Raio da zona morta, em % da deflexão total
+ *
+ * Abaixo dele a direção é CENTRO. O padrão equivale à antiga zona morta
+ * de 35 a 65 em cada eixo, mas é um círculo em vez de um quadrado.
+ */
+#ifndef DIRECAO_JOYSTICK_ZONA_MORTA
+#define DIRECAO_JOYSTICK_ZONA_MORTA 30
+#endif
+
+/**
+ * @brief Duração, em ms, da etapa em que os eixos são levados aos extremos
+ */
+#define CALIBRACAO_DURACAO_EXTREMOS_MS 5000
+
+/**
+ * @brief Leituras somadas para estimar o centro de cada eixo
+ */
+#define CALIBRACAO_AMOSTRAS_CENTRO 64
+
+/**
+ * @brief Menor distância aceita, em unidades do ADC, entre o centro e cada extremo
+ */
+#define CALIBRACAO_EXCURSAO_MINIMA 512
+
+/**
+ * @brief Direções possíveis do joystick.
+ *
+ * As oito primeiras direções são as da rosa dos ventos de 8 pontas; as
+ * intermediárias só aparecem com DIRECAO_JOYSTICK_SETORES igual a 16.
+ */
+typedef enum {
+    CENTRO,     /**< Posição central/neutra do joystick */
+    LESTE,      /**< Joystick movido para a direita */
+    OESTE,      /**< Joystick movido para a esquerda */
+    NORTE,      /**< Joystick movido para cima */
+    SUL,        /**< Joystick movido para baixo */
+    NORDESTE,   /**< Joystick movido na diagonal superior direita */
+    NOROESTE,   /**< Joystick movido na diagonal superior esquerda */
+    SUDESTE,    /**< Joystick movido na diagonal inferior direita */
+    SUDOESTE,   /**< Joystick movido na diagonal inferior esquerda */
+    LES_NORDESTE,  /**< Entre leste e nordeste */
+    NOR_NORDESTE,  /**< Entre nordeste e norte */
+    NOR_NOROESTE,  /**< Entre norte e noroeste */
+    OES_NOROESTE,  /**< Entre noroeste e oeste */
+    OES_SUDOESTE,  /**< Entre oeste e sudoeste */
+    SUL_SUDOESTE,  /**< Entre sudoeste e sul */
+    SUL_SUDESTE,   /**< Entre sul e sudeste */
+    LES_SUDESTE,   /**< Entre sudeste e leste */
+    DIRECAO_DESCONHECIDA /**< Estado não reconhecido do joystick */
+} JoystickDirection;
+
+/**
+ * @brief Leituras brutas (0-4095) que definem a faixa de cada eixo
+ */
+typedef struct {
+    uint16_t centro_x; /**< Leitura do eixo X com o joystick solto */
+    uint16_t minimo_x; /**< Menor leitura do eixo X */
+    uint16_t maximo_x; /**< Maior leitura do eixo X */
+    uint16_t centro_y; /**< Leitura do eixo Y com o joystick solto */
+    uint16_t minimo_y; /**< Menor leitura do eixo Y */
+    uint16_t maximo_y; /**< Maior leitura do eixo Y */
+} CalibracaoJoystick_t;
+
+/**
+ * @brief Preenche uma calibração nominal: centro em 2048 e extremos em 0 e 4095.
+ * @param calibracao Calibração a preencher
+ */
+void calibracao_joystick_padrao(CalibracaoJoystick_t *calibracao);
+
+/**
+ * @brief Indica se a calibração é coerente (centro entre os extremos, com folga).
+ * @param calibracao Calibração a verificar
+ * @return true se a calibração pode ser usada
+ */
+bool calibracao_joystick_valida(const CalibracaoJoystick_t *calibracao);
+
+/**
+ * @brief Captura a calibração do joystick, bloqueando por alguns segundos.
+ *
+ * Primeiro mede o centro com o joystick solto; depois acompanha os
+ * extremos por CALIBRACAO_DURACAO_EXTREMOS_MS enquanto o usuário gira o
+ * joystick até os limites. As instruções saem pelo printf.
+ *
+ * @param calibracao Calibração capturada
+ * @return true se a calibração capturada é válida
+ */
+bool calibracao_joystick_capturar(CalibracaoJoystick_t *calibracao);
+
+/**
+ * @brief Lê a calibração guardada na flash.
+ * @param calibracao Calibração lida (inalterada se não houver uma válida)
+ * @return true se havia uma calibração válida na flash
+ */
+bool calibracao_joystick_carregar(CalibracaoJoystick_t *calibracao);
+
+/**
+ * @brief Grava a calibração na flash, apagando a anterior.
+ * @param calibracao Calibração a gravar
+ * @return true se a gravação foi concluída
+ */
+bool calibracao_joystick_salvar(const CalibracaoJoystick_t *calibracao);
+
+/**
+ * @brief Passa a usar a calibração na decodificação.
+ *
+ * Calcula uma vez os fatores de escala de cada meio eixo, para que a
+ * decodificação não faça divisões.
+ *
+ * @param calibracao Calibração a usar (deve ser válida)
+ */
+void direcao_joystick_aplicar_calibracao(const CalibracaoJoystick_t *calibracao);
+
+/**
+ * @brief Decodifica direção e magnitude a partir das leituras brutas.
+ *
+ * Usa a calibração aplicada por direcao_joystick_aplicar_calibracao() ou,
+ * se nenhuma foi aplicada, a calibração nominal.
+ *
+ * @param x_bruto Leitura do eixo X (0-4095)
+ * @param y_bruto Leitura do eixo Y (0-4095)
+ * @param magnitude Recebe a deflexão em % (0-100); pode ser NULL
+ * @return A direção decodificada, ou CENTRO dentro da zona morta
+ */
+JoystickDirection direcao_joystick_decodificar(uint16_t x_bruto, uint16_t y_bruto, uint8_t *magnitude);
+
+/** @} */ // Fim do grupo DIRECAO_JOYSTICK
+
+#endif // DIRECAO_JOYSTICK_H
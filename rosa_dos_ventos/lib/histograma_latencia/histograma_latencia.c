@@ -0,0 +1,74 @@
+/**
+ * @file histograma_latencia.c
+ * @brief Implementação do histograma de latências com faixas fixas
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "histograma_latencia.h"
+
+/** @brief Limite superior, em ms, de cada faixa exceto a última */
+static const uint32_t limites_ms[HISTOGRAMA_LATENCIA_NUM_FAIXAS - 1] = {
+    1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000
+};
+
+/**
+ * @brief Zera o histograma.
+ */
+void histograma_latencia_init(HistogramaLatencia_t *histograma) {
+    memset(histograma, 0, sizeof(*histograma));
+}
+
+/**
+ * @brief Registra uma latência.
+ */
+void histograma_latencia_registrar(HistogramaLatencia_t *histograma, uint32_t latencia_ms) {
+    uint8_t faixa = 0;
+    while (faixa < HISTOGRAMA_LATENCIA_NUM_FAIXAS - 1 && latencia_ms > limites_ms[faixa]) {
+        faixa++;
+    }
+    histograma->contagens[faixa]++;
+    histograma->total++;
+    histograma->soma_ms += latencia_ms;
+    if (latencia_ms > histograma->maximo_ms) {
+        histograma->maximo_ms = latencia_ms;
+    }
+}
+
+/**
+ * @brief Estima um percentil pelo limite superior da faixa onde ele cai.
+ */
+uint32_t histograma_latencia_percentil(const HistogramaLatencia_t *histograma, uint8_t percentual) {
+    if (histograma->total == 0) {
+        return 0;
+    }
+    // Posição do percentil arredondada para cima, sem ponto flutuante
+    uint32_t alvo = (uint32_t)(((uint64_t)histograma->total * percentual + 99) / 100);
+    uint32_t acumulado = 0;
+    for (uint8_t faixa = 0; faixa < HISTOGRAMA_LATENCIA_NUM_FAIXAS - 1; faixa++) {
+        acumulado += histograma->contagens[faixa];
+        if (acumulado >= alvo) {
+            return limites_ms[faixa];
+        }
+    }
+    return histograma->maximo_ms;
+}
+
+/**
+ * @brief Imprime o histograma na saída padrão (USB/UART).
+ *
+ * Formato: "<nome>: n=<total> media=<ms> p50<=<ms> p95<=<ms> max=<ms> |
+ * <contagens das faixas>".
+ */
+void histograma_latencia_imprimir(const HistogramaLatencia_t *histograma, const char *nome) {
+    uint32_t media = histograma->total ? (uint32_t)(histograma->soma_ms / histograma->total) : 0;
+    printf("%s: n=%lu media=%lu p50<=%lu p95<=%lu max=%lu |", nome,
+           (unsigned long)histograma->total, (unsigned long)media,
+           (unsigned long)histograma_latencia_percentil(histograma, 50),
+           (unsigned long)histograma_latencia_percentil(histograma, 95),
+           (unsigned long)histograma->maximo_ms);
+    for (uint8_t faixa = 0; faixa < HISTOGRAMA_LATENCIA_NUM_FAIXAS; faixa++) {
+        printf(" %lu", (unsigned long)histograma->contagens[faixa]);
+    }
+    printf("\n");
+}
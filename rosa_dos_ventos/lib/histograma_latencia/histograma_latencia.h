@@ -0,0 +1,69 @@
+/**
+ * @file histograma_latencia.h
+ * @brief Interface do histograma de latências com faixas fixas
+ *
+ * Cada registro só incrementa um contador, sem alocação nem ponto
+ * flutuante, então pode ser feito dentro dos callbacks do lwIP. As faixas
+ * crescem em passos 1-2-5 de 1 ms a 5 s; a última faixa acumula tudo o que
+ * passar disso.
+ */
+
+#ifndef HISTOGRAMA_LATENCIA_H
+#define HISTOGRAMA_LATENCIA_H
+
+#include <stdint.h>
+
+/**
+ * @defgroup HISTOGRAMA_LATENCIA Histograma de Latências
+ * @{
+ */
+
+/**
+ * @brief Número de faixas do histograma
+ *
+ * Limites superiores, em ms: 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000,
+ * 2000, 5000 e acima de 5000.
+ */
+#define HISTOGRAMA_LATENCIA_NUM_FAIXAS 13
+
+/**
+ * @brief Histograma de latências
+ */
+typedef struct {
+    uint32_t contagens[HISTOGRAMA_LATENCIA_NUM_FAIXAS]; /**< Registros em cada faixa */
+    uint32_t total;                                     /**< Número de registros */
+    uint32_t maximo_ms;                                 /**< Maior latência registrada */
+    uint64_t soma_ms;                                   /**< Soma das latências (para a média) */
+} HistogramaLatencia_t;
+
+/**
+ * @brief Zera o histograma.
+ * @param histograma Ponteiro para o histograma
+ */
+void histograma_latencia_init(HistogramaLatencia_t *histograma);
+
+/**
+ * @brief Registra uma latência.
+ * @param histograma Ponteiro para o histograma
+ * @param latencia_ms Latência medida, em ms
+ */
+void histograma_latencia_registrar(HistogramaLatencia_t *histograma, uint32_t latencia_ms);
+
+/**
+ * @brief Estima um percentil pelo limite superior da faixa onde ele cai.
+ * @param histograma Ponteiro para o histograma
+ * @param percentual Percentil desejado (1 a 100)
+ * @return Limite superior da faixa, em ms (o máximo registrado na última faixa), ou 0 se vazio
+ */
+uint32_t histograma_latencia_percentil(const HistogramaLatencia_t *histograma, uint8_t percentual);
+
+/**
+ * @brief Imprime o histograma na saída padrão (USB/UART).
+ * @param histograma Ponteiro para o histograma
+ * @param nome Nome da medida, usado como prefixo da linha
+ */
+void histograma_latencia_imprimir(const HistogramaLatencia_t *histograma, const char *nome);
+
+/** @} */ // Fim do grupo HISTOGRAMA_LATENCIA
+
+#endif // HISTOGRAMA_LATENCIA_H
@@ -17,6 +17,12 @@
 #include "lwip/ip_addr.h"
 #include "lwip/tcp.h"
 #include "joystick.h"
+#include "buffer_amostras.h"
+#include "codec_telemetria.h"
+#include "resposta_http.h"
+#include "resolvedor_dns.h"
+#include "limitador_envio.h"
+#include "histograma_latencia.h"
 
 /**
  * @def PROXY_HOST
@@ -29,15 +35,256 @@
  * @brief Porta do proxy para conexão com o servidor
  */
 #define PROXY_PORT 80
-                        
+
 /**
- * @brief Envia os dados do joystick para o servidor na nuvem
- * 
- * Esta função envia os dados do joystick para o servidor configurado
- * usando uma requisição HTTP POST.
- * 
- * @param dados_a_enviar Ponteiro para a estrutura com os dados do joystick a serem enviados
+ * @brief Número máximo de amostras enviadas em um único POST
+ */
+#define HTTP_TAMANHO_LOTE 16
+
+/**
+ * @brief Tempo máximo, em ms, que uma amostra espera no buffer antes de o lote ser enviado
+ */
+#define HTTP_PRAZO_LOTE_MS 2000
+
+/**
+ * @brief Valor de http_client_ms_ate_proximo_lote() quando nenhum prazo está correndo
+ */
+#define HTTP_SEM_PRAZO UINT32_MAX
+
+/**
+ * @brief Taxa sustentada de lotes enviados ao servidor, em lotes por minuto
+ */
+#define HTTP_LOTES_POR_MINUTO 30
+
+/**
+ * @brief Número de lotes que podem sair seguidos depois de um período sem envios
+ */
+#define HTTP_RAJADA_LOTES 3
+
+/**
+ * @brief Tamanho máximo, em bytes, do corpo de uma requisição (lote codificado)
+ */
+#define HTTP_TAMANHO_MAX_CORPO 1280
+
+/**
+ * @brief Tamanho máximo, em bytes, da parte constante do cabeçalho HTTP
+ */
+#define HTTP_TAMANHO_MAX_CABECALHO 160
+
+/**
+ * @brief Número máximo de reconexões consecutivas antes de falhar as requisições na fila
+ */
+#define HTTP_MAX_TENTATIVAS_RECONEXAO 3
+
+/**
+ * @brief Número de contextos de requisição do pool estático
+ */
+#define HTTP_NUM_REQUISICOES 4
+
+/**
+ * @brief Número máximo de requisições em voo (pipelining) na conexão keep-alive
+ *
+ * Com 1 o cliente volta a esperar cada resposta antes do próximo envio. Não
+ * deve passar de HTTP_NUM_REQUISICOES.
+ */
+#define HTTP_JANELA_PIPELINE 3
+
+/**
+ * @brief Prazo, em ms, para a conclusão de cada lote enviado
+ */
+#define HTTP_TIMEOUT_REQUISICAO_MS 10000
+
+/**
+ * @brief Número máximo de vezes que uma requisição é escrita na conexão
+ *
+ * Uma requisição sem resposta é reenviada quando a conexão cai e é reaberta.
+ */
+#define HTTP_MAX_TENTATIVAS_REQUISICAO 2
+
+/**
+ * @brief Tempo, em ms, além do prazo, que um contexto concluído pode ficar
+ *        aguardando ACK antes de ser considerado vazado e recuperado
+ */
+#define HTTP_TOLERANCIA_VAZAMENTO_MS 5000
+
+/**
+ * @brief Instantes (ms desde o boot) das etapas da entrega de uma requisição
+ *
+ * Uma etapa que não aconteceu fica com 0. Se a requisição foi reescrita
+ * após uma reconexão, os instantes de escrita e ACK são os da última
+ * tentativa.
+ */
+typedef struct {
+    uint32_t enfileirada_em_ms; /**< Entrada na fila do motor de requisições */
+    uint32_t escrita_em_ms;     /**< Entrega dos bytes ao TCP (tcp_write) */
+    uint32_t confirmada_em_ms;  /**< ACK do último byte da requisição pelo servidor */
+    uint32_t respondida_em_ms;  /**< Leitura completa da resposta HTTP */
+} EntregaHttp_t;
+
+/**
+ * @brief Callback de conclusão de uma requisição
+ *
+ * Chamado uma única vez por requisição, no contexto do lwIP, portanto deve
+ * ser curto e não pode bloquear.
+ *
+ * @param id Identificador devolvido no envio
+ * @param sucesso true se o servidor respondeu com status 2xx
+ * @param status_http Código de status HTTP recebido (0 se não houve resposta)
+ * @param entrega Instantes das etapas da entrega (válido apenas durante a chamada)
+ * @param arg Argumento informado no envio
+ */
+typedef void (*CallbackRequisicaoHttp)(uint32_t id, bool sucesso, int status_http,
+                                       const EntregaHttp_t *entrega, void *arg);
+
+/**
+ * @brief Função chamada sempre que um contexto do pool é liberado
+ *
+ * Roda no contexto do lwIP (em interrupção, na arquitetura
+ * threadsafe_background) e serve para acordar quem espera o pool ou o fim
+ * da contrapressão para enviar o próximo lote.
+ */
+typedef void (*AvisoClienteHttp)(void);
+
+/**
+ * @brief Contadores do motor de requisições HTTP
+ */
+typedef struct {
+    uint16_t em_andamento;  /**< Contextos do pool ocupados no momento */
+    uint32_t concluidas;    /**< Requisições respondidas com status 2xx */
+    uint32_t falhas;        /**< Requisições finalizadas sem sucesso (inclui as expiradas) */
+    uint32_t expiradas;     /**< Requisições que estouraram o prazo */
+    uint32_t rejeitadas;    /**< Envios recusados por falta de contexto livre */
+    uint32_t vazamentos;    /**< Contextos recuperados à força por ficarem presos após o prazo */
+    uint32_t esperas_envio; /**< Vezes que a fila esperou um ACK por falta de espaço no buffer de envio TCP */
+    uint32_t amostras_devolvidas; /**< Amostras de lotes que falharam, devolvidas para o log */
+    uint32_t amostras_perdidas;   /**< Amostras de lotes que falharam sem espaço para voltar ao log */
+} EstatisticasHttp_t;
+
+/**
+ * @brief Histogramas das etapas de entrega, em ms
+ */
+typedef struct {
+    HistogramaLatencia_t espera_buffer; /**< Da leitura da amostra até entrar em um lote (inclui as repostas da flash) */
+    HistogramaLatencia_t fila;          /**< Da entrada do lote na fila até a escrita na conexão */
+    HistogramaLatencia_t dns;           /**< Resolução do endereço do servidor (0 quando vem do cache) */
+    HistogramaLatencia_t conexao;       /**< Handshake TCP com o servidor */
+    HistogramaLatencia_t envio;         /**< Da escrita até o ACK do último byte da requisição */
+    HistogramaLatencia_t resposta;      /**< Da escrita até a resposta HTTP completa */
+} LatenciasHttp_t;
+
+/**
+ * @brief Inicializa o cliente HTTP
+ *
+ * Monta uma única vez a parte constante do cabeçalho das requisições.
+ * Deve ser chamada antes de enviar_lote_para_nuvem().
+ */
+void http_client_init(void);
+
+/**
+ * @brief Enfileira uma requisição POST /dados com cópia do corpo
+ *
+ * @param corpo Corpo da requisição (copiado antes do retorno)
+ * @param tamanho Tamanho do corpo, em bytes (até HTTP_TAMANHO_MAX_CORPO)
+ * @param timeout_ms Prazo para a conclusão, em ms
+ * @param callback Callback de conclusão (pode ser NULL)
+ * @param arg Argumento repassado ao callback
+ * @return Identificador da requisição, ou -1 se o corpo é grande demais ou o pool está cheio
+ */
+int32_t http_client_enviar_requisicao(const char *corpo, uint16_t tamanho, uint32_t timeout_ms,
+                                      CallbackRequisicaoHttp callback, void *arg);
+
+/**
+ * @brief Copia os contadores do motor de requisições
+ * @param destino Estrutura que recebe a cópia dos contadores
+ */
+void http_client_obter_estatisticas(EstatisticasHttp_t *destino);
+
+/**
+ * @brief Retira uma amostra de um lote que não foi entregue
+ *
+ * Quem envia os lotes deve chamá-la até retornar false e gravar as amostras
+ * no log em flash, de onde voltam ao buffer de envio como as gravadas sem
+ * Wi-Fi.
+ *
+ * @param amostra Recebe a amostra
+ * @return true se havia amostra devolvida
+ */
+bool http_client_retirar_devolvida(Amostra_t *amostra);
+
+/**
+ * @brief Copia os histogramas de latência das etapas de entrega
+ * @param destino Estrutura que recebe a cópia dos histogramas
+ */
+void http_client_obter_latencias(LatenciasHttp_t *destino);
+
+/**
+ * @brief Imprime os histogramas de latência na saída padrão (USB/UART)
+ *
+ * Uma linha por etapa, no formato de histograma_latencia_imprimir(), e uma
+ * com as amostras de lotes que falharam (devolvidas ao log e perdidas).
+ */
+void http_client_imprimir_latencias(void);
+
+/**
+ * @brief Informa se o motor de requisições está pedindo para os produtores desacelerarem
+ *
+ * Sinal de contrapressão: com o pool quase cheio ou o buffer de envio TCP
+ * sem espaço para mais uma requisição, novos envios só esperariam na fila.
+ * Enquanto retorna true, enviar_lote_para_nuvem() só envia lotes completos
+ * e quem produz as amostras deve agrupá-las ou coalescê-las.
+ *
+ * @return true se há contrapressão
+ */
+bool http_client_sob_pressao(void);
+
+/**
+ * @brief Informa se o limite de taxa está segurando o próximo lote
+ *
+ * Enquanto retorna true, quem produz as amostras pode coalescê-las (ver
+ * buffer_amostras_coalescer()) em vez de acumular estados que só sairiam
+ * bem depois.
+ *
+ * @return true se não há ficha para um novo lote agora
+ */
+bool http_client_envio_limitado(void);
+
+/**
+ * @brief Calcula quanto falta para enviar_lote_para_nuvem() ter um lote para enviar
+ *
+ * Junta o prazo da amostra mais antiga (HTTP_PRAZO_LOTE_MS) e o limite de
+ * taxa, para que quem chama enviar_lote_para_nuvem() durma até lá em vez de
+ * chamá-la periodicamente. Com o buffer vazio, ou com o lote esperando o
+ * pool ou o fim da contrapressão, não há prazo: o próximo passo depende de
+ * uma nova amostra ou do aviso de http_client_definir_aviso().
+ *
+ * @param buffer Buffer de onde os lotes são retirados
+ * @return Tempo em ms (0 se já há lote pronto), ou HTTP_SEM_PRAZO
+ */
+uint32_t http_client_ms_ate_proximo_lote(const BufferAmostras_t *buffer);
+
+/**
+ * @brief Define a função chamada sempre que um contexto do pool é liberado
+ * @param aviso Função de aviso (NULL para desligar)
+ */
+void http_client_definir_aviso(AvisoClienteHttp aviso);
+
+/**
+ * @brief Envia um lote de amostras do buffer para o servidor na nuvem
+ *
+ * As amostras são retiradas do buffer e enviadas em um único POST, no
+ * formato definido por TELEMETRIA_FORMATO, quando há HTTP_TAMANHO_LOTE
+ * delas ou quando a mais antiga já esperou HTTP_PRAZO_LOTE_MS, respeitando
+ * o limite de HTTP_LOTES_POR_MINUTO (com rajadas de até HTTP_RAJADA_LOTES).
+ * Deve ser chamada periodicamente.
+ *
+ * @param buffer Buffer de onde as amostras são retiradas
+ * @return Número de amostras retiradas do buffer para envio
+ *
+ * @note O lote ocupa um contexto do pool até ser respondido; com o pool
+ *       cheio ou sem ficha no limitador, as amostras continuam no buffer. A
+ *       conexão TCP com o servidor é mantida aberta (HTTP/1.1 keep-alive) e
+ *       reutilizada entre chamadas.
  */
-void enviar_dados_para_nuvem(const Joystick* dados_a_enviar);
+uint16_t enviar_lote_para_nuvem(BufferAmostras_t *buffer);
 
 #endif
@@ -0,0 +1,101 @@
+/**
+ * @file resposta_http.h
+ * @brief Interface do leitor incremental de respostas HTTP/1.1
+ *
+ * O leitor consome a resposta em pedaços, na ordem em que chegam da rede,
+ * sem alocar memória e sem copiar o corpo: apenas a linha corrente do
+ * cabeçalho é guardada em um buffer fixo. Ele extrai o código de status e
+ * o tamanho do corpo (Content-Length ou chunked) para saber exatamente onde
+ * a resposta termina, o que permite reutilizar a conexão (keep-alive).
+ */
+
+#ifndef RESPOSTA_HTTP_H
+#define RESPOSTA_HTTP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @defgroup RESPOSTA_HTTP Leitor de Respostas HTTP
+ * @{
+ */
+
+/**
+ * @brief Tamanho do buffer da linha corrente do cabeçalho
+ *
+ * Linhas maiores são truncadas; só o início de cada linha é interpretado.
+ */
+#define RESPOSTA_HTTP_TAMANHO_LINHA 64
+
+/**
+ * @brief Etapas da leitura de uma resposta
+ */
+typedef enum {
+    RESPOSTA_LINHA_STATUS,   /**< Lendo "HTTP/1.x NNN ..." */
+    RESPOSTA_CABECALHOS,     /**< Lendo os campos do cabeçalho */
+    RESPOSTA_CORPO,          /**< Descartando um corpo de tamanho conhecido */
+    RESPOSTA_CORPO_ATE_FIM,  /**< Descartando um corpo delimitado pelo fechamento da conexão */
+    RESPOSTA_CHUNK_TAMANHO,  /**< Lendo a linha de tamanho de um chunk */
+    RESPOSTA_CHUNK_DADOS,    /**< Descartando os dados de um chunk */
+    RESPOSTA_CHUNK_FIM,      /**< Lendo o CRLF que encerra um chunk */
+    RESPOSTA_CHUNK_TRAILER,  /**< Lendo o trailer depois do último chunk */
+    RESPOSTA_COMPLETA        /**< Resposta lida por inteiro */
+} EtapaRespostaHttp;
+
+/**
+ * @brief Resultado de uma chamada a resposta_http_processar()
+ */
+typedef enum {
+    RESPOSTA_HTTP_INCOMPLETA, /**< Todos os bytes foram consumidos e a resposta ainda não terminou */
+    RESPOSTA_HTTP_CONCLUIDA,  /**< A resposta terminou; bytes restantes pertencem à próxima */
+    RESPOSTA_HTTP_INVALIDA    /**< Os dados não formam uma resposta HTTP/1.x válida */
+} ResultadoRespostaHttp;
+
+/**
+ * @brief Estado do leitor de uma resposta
+ */
+typedef struct {
+    EtapaRespostaHttp etapa;   /**< Etapa atual da leitura */
+    int status_http;           /**< Código de status (0 enquanto a linha de status não foi lida) */
+    int32_t content_length;    /**< Valor de Content-Length, ou -1 se ausente */
+    bool chunked;              /**< Transfer-Encoding: chunked */
+    bool fechar_conexao;       /**< O servidor pediu Connection: close */
+    uint32_t restante;         /**< Bytes ainda a descartar do corpo ou do chunk atual */
+    uint8_t tamanho_linha;     /**< Bytes válidos em linha */
+    char linha[RESPOSTA_HTTP_TAMANHO_LINHA]; /**< Linha corrente do cabeçalho */
+} LeitorRespostaHttp_t;
+
+/**
+ * @brief Prepara o leitor para uma nova resposta.
+ * @param leitor Estado do leitor
+ */
+void resposta_http_iniciar(LeitorRespostaHttp_t *leitor);
+
+/**
+ * @brief Consome um pedaço da resposta.
+ *
+ * Pode ser chamada com pedaços de qualquer tamanho, inclusive um byte por
+ * vez. Ao concluir uma resposta, para no último byte dela: o que sobrar do
+ * pedaço é o início da próxima resposta.
+ *
+ * @param leitor Estado do leitor
+ * @param dados Bytes recebidos
+ * @param tamanho Número de bytes em dados
+ * @param consumidos Recebe o número de bytes de dados que foram consumidos
+ * @return Situação da resposta após consumir os bytes
+ */
+ResultadoRespostaHttp resposta_http_processar(LeitorRespostaHttp_t *leitor, const uint8_t *dados,
+                                              uint16_t tamanho, uint16_t *consumidos);
+
+/**
+ * @brief Informa que o servidor fechou a conexão.
+ *
+ * @param leitor Estado do leitor
+ * @return true se o fechamento conclui a resposta (corpo sem tamanho
+ *         declarado), false se a resposta ficou truncada
+ */
+bool resposta_http_fim_da_conexao(LeitorRespostaHttp_t *leitor);
+
+/** @} */ // Fim do grupo RESPOSTA_HTTP
+
+#endif // RESPOSTA_HTTP_H
@@ -1,28 +1,60 @@
 /**
  * @file joystick.c
  * @brief Implementação das funções do driver do joystick
+ *
+ * O driver não toca no ADC: registra os canais X e Y no serviço de ADC, que converte em segundo plano e publica a soma de cada
+ * janela. read_joystick() só lê a publicação mais recente e faz a média.
  */
 #include "pico/stdlib.h"
-#include "hardware/adc.h"
+#include "servico_adc.h"
 #include "joystick.h" 
 #include <stdio.h>   
 #include <stdlib.h>
 
+/**
+ * @brief Fator Q21 que leva uma leitura de 12 bits para a faixa 0-100
+ *
+ * (x * ESCALA_EIXO_Q21) >> 21 é igual a (x * 100) / 4095 para todo x de
+ * 0 a 4095, trocando a divisão por uma multiplicação de 32 bits.
+ */
+#define ESCALA_EIXO_Q21 ((100u << 21) / 4095u + 1u)
+
+/**
+ * @brief Média da publicação mais recente de um canal.
+ *
+ * Antes da primeira publicação devolve o meio da escala, para que o
+ * joystick apareça centrado em vez de encostado em um canto.
+ *
+ * @param canal Canal do ADC registrado pelo driver
+ * @return Média das leituras brutas do canal
+ */
+static uint32_t media_canal(uint8_t canal) {
+    LeituraAdc_t leitura;
+    if (!servico_adc_ler(canal, &leitura)) {
+        return 2048;
+    }
+    return leitura.soma / JOYSTICK_JANELA_MEDIA;
+}
+
+/** @brief Intervalo entre duas médias de cada eixo, em ms */
+#define PERIODO_LEITURA_MS (1000 / JOYSTICK_TAXA_LEITURA_HZ)
+_Static_assert(1000 % JOYSTICK_TAXA_LEITURA_HZ == 0, "JOYSTICK_TAXA_LEITURA_HZ precisa dividir 1000");
+
 /**
  * @brief Inicializa o joystick
  * 
- * Configura o ADC e os pinos GPIO necessários para o joystick:
- * - Inicializa o ADC
- * - Configura os pinos analógicos X e Y
+ * Prepara o joystick:
+ * - Registra X e Y no serviço de ADC
  * - Configura o pino do botão com pull-up interno
  */
-void joystick_init(void){
-    adc_init();                   // Inicializa o conversor analógico-digital
-    adc_gpio_init(PINO_JOY_X);    // Configura pino X como entrada analógica
-    adc_gpio_init(PINO_JOY_Y);    // Configura pino Y como entrada analógica
+bool joystick_init(void){
+    // Os pinos analógicos são configurados pelo serviço de ADC
+    bool registrados = servico_adc_registrar(ADC_CHANNEL_X, PERIODO_LEITURA_MS, JOYSTICK_JANELA_MEDIA, NULL, NULL);
+    registrados &= servico_adc_registrar(ADC_CHANNEL_Y, PERIODO_LEITURA_MS, JOYSTICK_JANELA_MEDIA, NULL, NULL);
     gpio_init(PINO_BUTTON);       // Inicializa o pino do botão
     gpio_set_dir(PINO_BUTTON, GPIO_IN); // Define como entrada
     gpio_pull_up(PINO_BUTTON);    // Habilita o resistor de pull-up interno
+    return registrados;
 }
 
 /**
@@ -35,17 +67,16 @@ void joystick_init(void){
  * @param joystick Ponteiro para a estrutura onde serão armazenados os valores lidos
  */
 void read_joystick(Joystick *joystick){
-    // Lê os valores analógicos do eixo X
-    adc_select_input(ADC_CHANNEL_X); 
-    uint16_t x_value = adc_read();
+    // Médias já publicadas pelo serviço de ADC, sem esperar conversões
+    uint32_t x_value = media_canal(ADC_CHANNEL_X);
+    uint32_t y_value = media_canal(ADC_CHANNEL_Y);
 
-    // Lê os valores analógicos do eixo Y
-    adc_select_input(ADC_CHANNEL_Y); 
-    uint16_t y_value = adc_read();
+    joystick->x_bruto = (uint16_t)x_value;
+    joystick->y_bruto = (uint16_t)y_value;
 
-    // Normaliza os valores para a faixa de 0-100
-    joystick->x_position = (x_value * 100) / 4095;
-    joystick->y_position = (y_value * 100) / 4095;
+    // Normaliza os valores para a faixa de 0-100 (multiplicação e deslocamento, sem divisão)
+    joystick->x_position = ((uint32_t)x_value * ESCALA_EIXO_Q21) >> 21;
+    joystick->y_position = ((uint32_t)y_value * ESCALA_EIXO_Q21) >> 21;
 
     // Lê o estado do botão (ativo em nível baixo devido ao pull-up)
     if(gpio_get(PINO_BUTTON) == 0){ 
@@ -53,4 +84,4 @@ void read_joystick(Joystick *joystick){
     } else {
         joystick->button_pressed = 0; // Botão não pressionado
     }
-}
\ No newline at end of file
+}
@@ -38,28 +38,50 @@
  */
 #define PINO_BUTTON 22 
 
+/**
+ * @def JOYSTICK_TAXA_LEITURA_HZ
+ * @brief Novas médias de cada eixo por segundo, publicadas pelo serviço de ADC (divisor de 1000)
+ */
+#ifndef JOYSTICK_TAXA_LEITURA_HZ
+#define JOYSTICK_TAXA_LEITURA_HZ 100
+#endif
+
+/**
+ * @def JOYSTICK_JANELA_MEDIA
+ * @brief Número de conversões de cada eixo somadas em cada média
+ */
+#define JOYSTICK_JANELA_MEDIA 16
+
 /**
  * @brief Estrutura para representar um joystick
  */
 typedef struct {
     int x_position;         /**< Posição no eixo X (0-100) */
     int y_position;         /**< Posição no eixo Y (0-100) */
+    uint16_t x_bruto;       /**< Leitura do eixo X sem normalizar (0-4095), usada pela calibração */
+    uint16_t y_bruto;       /**< Leitura do eixo Y sem normalizar (0-4095), usada pela calibração */
     uint8_t button_pressed; /**< 1 se o botão estiver pressionado, 0 caso contrário */
 } Joystick;
 
 /**
  * @brief Inicializa o joystick
  * 
- * Configura os pinos GPIO e inicializa o ADC para leitura do joystick.
- * Deve ser chamada antes de qualquer outra função do joystick.
+ * Configura o pino do botão e registra os eixos X e Y no serviço de
+ * ADC. As leituras analógicas só começam com
+ * servico_adc_iniciar(). Deve ser chamada antes de qualquer outra função
+ * do joystick.
+ *
+ * @return true se todos os canais foram registrados no serviço de ADC
  */
-void joystick_init(void);
+bool joystick_init(void);
 
 /**
  * @brief Lê os valores do joystick
  * 
  * Captura os valores atuais de posição X, Y e o estado do botão.
- * Os valores X e Y são normalizados para o intervalo de 0-100.
+ * Os valores X e Y são normalizados para o intervalo de 0-100. A chamada
+ * não espera o ADC: X e Y são a média de JOYSTICK_JANELA_MEDIA conversões
+ * publicada mais recentemente pelo serviço de ADC.
  * 
  * @param joystick Ponteiro para a estrutura onde serão armazenados os valores lidos
  */
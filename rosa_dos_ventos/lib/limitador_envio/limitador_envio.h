@@ -0,0 +1,74 @@
+/**
+ * @file limitador_envio.h
+ * @brief Interface do limitador de taxa de envios (token bucket)
+ *
+ * Cada envio consome uma ficha; as fichas voltam a uma taxa constante até o
+ * limite da rajada. Assim o servidor recebe no máximo a taxa configurada,
+ * e depois de um período ocioso o dispositivo ainda pode enviar uma rajada
+ * curta sem esperar.
+ */
+
+#ifndef LIMITADOR_ENVIO_H
+#define LIMITADOR_ENVIO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @defgroup LIMITADOR_ENVIO Limitador de Taxa de Envios
+ * @{
+ */
+
+/**
+ * @brief Estado de um limitador
+ *
+ * As fichas são guardadas em frações de 1/60000 (uma ficha por minuto
+ * corresponde a uma fração por ms), o que evita ponto flutuante no cálculo
+ * da reposição.
+ */
+typedef struct {
+    uint32_t envios_por_minuto; /**< Taxa de reposição das fichas */
+    uint32_t capacidade;        /**< Máximo de frações acumuladas (rajada) */
+    uint32_t fracoes;           /**< Frações de ficha disponíveis */
+    uint32_t atualizado_em_ms;  /**< Instante da última reposição */
+} LimitadorEnvio_t;
+
+/**
+ * @brief Inicializa o limitador com a rajada completa
+ * @param limitador Ponteiro para o limitador
+ * @param envios_por_minuto Taxa sustentada de envios (maior que zero)
+ * @param rajada Número de envios que podem sair seguidos depois de um período ocioso
+ */
+void limitador_envio_init(LimitadorEnvio_t *limitador, uint32_t envios_por_minuto, uint16_t rajada);
+
+/**
+ * @brief Repõe as fichas e informa se um envio é permitido agora
+ * @param limitador Ponteiro para o limitador
+ * @return true se há ao menos uma ficha inteira
+ */
+bool limitador_envio_disponivel(LimitadorEnvio_t *limitador);
+
+/**
+ * @brief Consome a ficha de um envio realizado
+ *
+ * Deve ser chamada apenas depois de limitador_envio_disponivel() ter
+ * retornado true.
+ *
+ * @param limitador Ponteiro para o limitador
+ */
+void limitador_envio_consumir(LimitadorEnvio_t *limitador);
+
+/**
+ * @brief Calcula quanto falta para a próxima ficha inteira
+ *
+ * Serve para quem dorme até poder enviar, em vez de consultar o limitador
+ * periodicamente.
+ *
+ * @param limitador Ponteiro para o limitador
+ * @return Tempo em ms até haver uma ficha (0 se já há)
+ */
+uint32_t limitador_envio_ms_ate_ficha(LimitadorEnvio_t *limitador);
+
+/** @} */ // Fim do grupo LIMITADOR_ENVIO
+
+#endif // LIMITADOR_ENVIO_H
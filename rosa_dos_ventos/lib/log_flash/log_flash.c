@@ -0,0 +1,242 @@
+/**
+ * @file log_flash.c
+ * @brief Implementação do log de amostras em flash
+ *
+ * Cada página do log começa com um cabeçalho (CabecalhoPaginaLog_t) seguido
+ * de até LOG_FLASH_AMOSTRAS_POR_PAGINA amostras copiadas byte a byte. Uma
+ * página reposta é marcada programando-a de novo com todos os bytes em
+ * 0xFF, exceto o campo pendente, que vai a zero: como a programação da
+ * flash só leva bits de 1 para 0, o resto da página não se altera e não é
+ * preciso apagar o setor.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "log_flash.h"
+
+/**
+ * @brief Identifica uma página escrita pelo log (0xFFFF indica página apagada)
+ *
+ * Muda sempre que o layout de Amostra_t muda, para que páginas gravadas
+ * por uma versão anterior do firmware sejam ignoradas.
+ */
+#define MAGICO_PAGINA_LOG 0x4C48
+
+/** @brief Valor do campo pendente de uma página ainda não reposta */
+#define PAGINA_PENDENTE 0xFFFFFFFFu
+
+/** @brief Número de páginas em cada setor */
+#define PAGINAS_POR_SETOR (LOG_FLASH_TAMANHO_SETOR / LOG_FLASH_TAMANHO_PAGINA)
+
+/**
+ * @brief Cabeçalho gravado no início de cada página do log
+ */
+typedef struct {
+    uint16_t magico;     /**< MAGICO_PAGINA_LOG */
+    uint16_t quantidade; /**< Amostras na página */
+    uint32_t sequencia;  /**< Ordem de gravação da página */
+    uint16_t soma;       /**< Fletcher-16 das amostras */
+    uint16_t reservado;  /**< Mantido em 0xFFFF */
+    uint32_t pendente;   /**< PAGINA_PENDENTE até a página ser reposta, depois 0 */
+} CabecalhoPaginaLog_t;
+
+_Static_assert(sizeof(CabecalhoPaginaLog_t) == LOG_FLASH_TAMANHO_CABECALHO,
+               "LOG_FLASH_TAMANHO_CABECALHO não corresponde ao cabeçalho");
+
+/**
+ * @brief Calcula o Fletcher-16 de um bloco de bytes.
+ */
+static uint16_t calcular_soma(const uint8_t *dados, size_t tamanho) {
+    uint16_t soma1 = 0;
+    uint16_t soma2 = 0;
+    for (size_t i = 0; i < tamanho; i++) {
+        soma1 = (uint16_t)((soma1 + dados[i]) % 255);
+        soma2 = (uint16_t)((soma2 + soma1) % 255);
+    }
+    return (uint16_t)((soma2 << 8) | soma1);
+}
+
+/**
+ * @brief Lê o cabeçalho de uma página do log.
+ */
+static void ler_cabecalho(const LogFlash_t *log, uint32_t pagina, CabecalhoPaginaLog_t *cabecalho) {
+    log->memoria->ler(pagina * LOG_FLASH_TAMANHO_PAGINA, cabecalho, sizeof(CabecalhoPaginaLog_t));
+}
+
+/**
+ * @brief Descarta a página pendente mais antiga.
+ */
+static void avancar_leitura(LogFlash_t *log) {
+    log->pagina_leitura = (log->pagina_leitura + 1) % log->num_paginas;
+    log->paginas_pendentes--;
+}
+
+/**
+ * @brief Programa a página em montagem na próxima posição do log.
+ *
+ * Ao entrar em um setor novo ele é apagado antes; se o log deu a volta, as
+ * páginas pendentes desse setor são descartadas primeiro.
+ */
+static void gravar_pagina(LogFlash_t *log) {
+    uint32_t pagina = log->pagina_escrita;
+
+    if (pagina % PAGINAS_POR_SETOR == 0) {
+        uint32_t setor = pagina / PAGINAS_POR_SETOR;
+        while (log->paginas_pendentes > 0 && log->pagina_leitura / PAGINAS_POR_SETOR == setor) {
+            CabecalhoPaginaLog_t cabecalho;
+            ler_cabecalho(log, log->pagina_leitura, &cabecalho);
+            log->perdidas += cabecalho.quantidade;
+            avancar_leitura(log);
+        }
+        if (!log->memoria->apagar_setor(setor * LOG_FLASH_TAMANHO_SETOR)) {
+            log->perdidas += log->quantidade_ram;
+            log->quantidade_ram = 0;
+            return;
+        }
+    }
+
+    CabecalhoPaginaLog_t cabecalho = {
+        .magico = MAGICO_PAGINA_LOG,
+        .quantidade = log->quantidade_ram,
+        .sequencia = log->proxima_sequencia,
+        .soma = calcular_soma(log->pagina_ram + LOG_FLASH_TAMANHO_CABECALHO,
+                              log->quantidade_ram * sizeof(Amostra_t)),
+        .reservado = 0xFFFF,
+        .pendente = PAGINA_PENDENTE
+    };
+    memcpy(log->pagina_ram, &cabecalho, sizeof(cabecalho));
+    // Sobra no fim da página fica em 0xFF, como na flash apagada
+    size_t usado = LOG_FLASH_TAMANHO_CABECALHO + log->quantidade_ram * sizeof(Amostra_t);
+    memset(log->pagina_ram + usado, 0xFF, LOG_FLASH_TAMANHO_PAGINA - usado);
+
+    if (log->memoria->programar_pagina(pagina * LOG_FLASH_TAMANHO_PAGINA, log->pagina_ram)) {
+        if (log->paginas_pendentes == 0) {
+            log->pagina_leitura = pagina;
+        }
+        log->paginas_pendentes++;
+        log->proxima_sequencia++;
+        log->pagina_escrita = (pagina + 1) % log->num_paginas;
+    } else {
+        log->perdidas += log->quantidade_ram;
+    }
+    log->quantidade_ram = 0;
+}
+
+/**
+ * @brief Monta o log a partir do conteúdo atual da memória.
+ */
+void log_flash_init(LogFlash_t *log, const MemoriaFlash_t *memoria) {
+    memset(log, 0, sizeof(LogFlash_t));
+    log->memoria = memoria;
+    log->num_paginas = memoria->tamanho_regiao / LOG_FLASH_TAMANHO_PAGINA;
+
+    bool encontrou = false;
+    uint32_t maior_sequencia = 0;
+    uint32_t menor_pendente = 0;
+    for (uint32_t pagina = 0; pagina < log->num_paginas; pagina++) {
+        CabecalhoPaginaLog_t cabecalho;
+        ler_cabecalho(log, pagina, &cabecalho);
+        if (cabecalho.magico != MAGICO_PAGINA_LOG) {
+            continue;
+        }
+        if (!encontrou || cabecalho.sequencia > maior_sequencia) {
+            maior_sequencia = cabecalho.sequencia;
+            log->pagina_escrita = (pagina + 1) % log->num_paginas;
+            encontrou = true;
+        }
+        if (cabecalho.pendente == PAGINA_PENDENTE) {
+            if (log->paginas_pendentes == 0 || cabecalho.sequencia < menor_pendente) {
+                menor_pendente = cabecalho.sequencia;
+                log->pagina_leitura = pagina;
+            }
+            log->paginas_pendentes++;
+        }
+    }
+
+    if (encontrou) {
+        log->proxima_sequencia = maior_sequencia + 1;
+    }
+    if (log->paginas_pendentes == 0) {
+        log->pagina_leitura = log->pagina_escrita;
+    }
+    printf("Log em flash: %lu páginas pendentes de %lu\n",
+           (unsigned long)log->paginas_pendentes, (unsigned long)log->num_paginas);
+}
+
+/**
+ * @brief Acrescenta uma amostra ao log.
+ */
+void log_flash_gravar(LogFlash_t *log, const Amostra_t *amostra) {
+    memcpy(log->pagina_ram + LOG_FLASH_TAMANHO_CABECALHO + log->quantidade_ram * sizeof(Amostra_t),
+           amostra, sizeof(Amostra_t));
+    log->quantidade_ram++;
+    log->gravadas++;
+    if (log->quantidade_ram == LOG_FLASH_AMOSTRAS_POR_PAGINA) {
+        gravar_pagina(log);
+    }
+}
+
+/**
+ * @brief Devolve ao buffer de envio uma leva de amostras do log.
+ */
+uint16_t log_flash_repor(LogFlash_t *log, BufferAmostras_t *buffer, uint32_t agora_ms) {
+    if (!log_flash_tem_pendentes(log) || agora_ms - log->ultima_reposicao_ms < LOG_FLASH_INTERVALO_REPOSICAO_MS) {
+        return 0;
+    }
+    if (BUFFER_AMOSTRAS_CAPACIDADE - buffer_amostras_tamanho(buffer) < LOG_FLASH_AMOSTRAS_POR_PAGINA) {
+        return 0; // Buffer ocupado com amostras ao vivo: tenta de novo depois
+    }
+    log->ultima_reposicao_ms = agora_ms;
+
+    const uint8_t *origem;
+    uint16_t quantidade;
+    Amostra_t amostra;
+
+    if (log->paginas_pendentes > 0) {
+        uint32_t endereco = log->pagina_leitura * LOG_FLASH_TAMANHO_PAGINA;
+        CabecalhoPaginaLog_t cabecalho;
+        log->memoria->ler(endereco, log->pagina_aux, LOG_FLASH_TAMANHO_PAGINA);
+        memcpy(&cabecalho, log->pagina_aux, sizeof(cabecalho));
+
+        quantidade = cabecalho.quantidade;
+        origem = log->pagina_aux + LOG_FLASH_TAMANHO_CABECALHO;
+        if (quantidade > LOG_FLASH_AMOSTRAS_POR_PAGINA ||
+            calcular_soma(origem, quantidade * sizeof(Amostra_t)) != cabecalho.soma) {
+            // Página corrompida (ex.: queda de energia durante a programação)
+            if (quantidade > LOG_FLASH_AMOSTRAS_POR_PAGINA) {
+                quantidade = LOG_FLASH_AMOSTRAS_POR_PAGINA;
+            }
+            log->perdidas += quantidade;
+            quantidade = 0;
+        }
+        for (uint16_t i = 0; i < quantidade; i++) {
+            memcpy(&amostra, origem + i * sizeof(Amostra_t), sizeof(Amostra_t));
+            buffer_amostras_inserir_reposta(buffer, &amostra);
+        }
+
+        // Marca a página como reposta sem apagar o setor
+        memset(log->pagina_aux, 0xFF, LOG_FLASH_TAMANHO_PAGINA);
+        memset(log->pagina_aux + offsetof(CabecalhoPaginaLog_t, pendente), 0, sizeof(uint32_t));
+        log->memoria->programar_pagina(endereco, log->pagina_aux);
+        avancar_leitura(log);
+    } else {
+        // A página em montagem volta direto da RAM, sem passar pela flash
+        quantidade = log->quantidade_ram;
+        origem = log->pagina_ram + LOG_FLASH_TAMANHO_CABECALHO;
+        for (uint16_t i = 0; i < quantidade; i++) {
+            memcpy(&amostra, origem + i * sizeof(Amostra_t), sizeof(Amostra_t));
+            buffer_amostras_inserir_reposta(buffer, &amostra);
+        }
+        log->quantidade_ram = 0;
+    }
+
+    log->repostas += quantidade;
+    return quantidade;
+}
+
+/**
+ * @brief Indica se há amostras no log aguardando reposição.
+ */
+bool log_flash_tem_pendentes(const LogFlash_t *log) {
+    return log->paginas_pendentes > 0 || log->quantidade_ram > 0;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file memoria_flash_pico.c
+ * @brief Acesso à região do log na flash QSPI do Pico
+ *
+ * A leitura é feita direto pela janela XIP. O apagamento e a programação
+ * desligam a XIP, por isso rodam dentro de flash_safe_execute(), que
+ * suspende o outro núcleo e as interrupções enquanto a flash está ocupada.
+ */
+
+#include <string.h>
+#include "hardware/flash.h"
+#include "pico/flash.h"
+#include "log_flash.h"
+
+/** @brief Deslocamento da região do log a partir do início da flash */
+#define LOG_FLASH_DESLOCAMENTO (PICO_FLASH_SIZE_BYTES - LOG_FLASH_TAMANHO_REGIAO)
+
+/** @brief Tempo máximo, em ms, para suspender o outro núcleo antes de desistir */
+#define LOG_FLASH_TIMEOUT_BLOQUEIO_MS 100
+
+_Static_assert(LOG_FLASH_TAMANHO_PAGINA == FLASH_PAGE_SIZE, "página do log difere da página da flash");
+_Static_assert(LOG_FLASH_TAMANHO_SETOR == FLASH_SECTOR_SIZE, "setor do log difere do setor da flash");
+
+/**
+ * @brief Parâmetros de uma operação executada com a flash bloqueada
+ */
+typedef struct {
+    uint32_t endereco;    /**< Endereço relativo à região do log */
+    const uint8_t *dados; /**< Página a programar (NULL para apagar) */
+} OperacaoFlash;
+
+/**
+ * @brief Copia bytes da região do log pela janela XIP.
+ */
+static void ler_flash(uint32_t endereco, void *destino, size_t tamanho) {
+    memcpy(destino, (const void *)(XIP_BASE + LOG_FLASH_DESLOCAMENTO + endereco), tamanho);
+}
+
+/**
+ * @brief Executa a operação com a flash bloqueada (chamada por flash_safe_execute()).
+ */
+static void executar_operacao(void *param) {
+    const OperacaoFlash *operacao = (const OperacaoFlash *)param;
+    if (operacao->dados) {
+        flash_range_program(LOG_FLASH_DESLOCAMENTO + operacao->endereco, operacao->dados, FLASH_PAGE_SIZE);
+    } else {
+        flash_range_erase(LOG_FLASH_DESLOCAMENTO + operacao->endereco, FLASH_SECTOR_SIZE);
+    }
+}
+
+/**
+ * @brief Apaga um setor da região do log.
+ */
+static bool apagar_setor_flash(uint32_t endereco) {
+    OperacaoFlash operacao = { .endereco = endereco, .dados = NULL };
+    return flash_safe_execute(executar_operacao, &operacao, LOG_FLASH_TIMEOUT_BLOQUEIO_MS) == PICO_OK;
+}
+
+/**
+ * @brief Programa uma página da região do log.
+ */
+static bool programar_pagina_flash(uint32_t endereco, const uint8_t *dados) {
+    OperacaoFlash operacao = { .endereco = endereco, .dados = dados };
+    return flash_safe_execute(executar_operacao, &operacao, LOG_FLASH_TIMEOUT_BLOQUEIO_MS) == PICO_OK;
+}
+
+/** @brief Memória da flash QSPI entregue ao log */
+static const MemoriaFlash_t memoria_pico = {
+    .tamanho_regiao = LOG_FLASH_TAMANHO_REGIAO,
+    .ler = ler_flash,
+    .apagar_setor = apagar_setor_flash,
+    .programar_pagina = programar_pagina_flash
+};
+
+/**
+ * @brief Retorna a memória da flash QSPI do Pico.
+ */
+const MemoriaFlash_t *memoria_flash_pico(void) {
+    return &memoria_pico;
+}
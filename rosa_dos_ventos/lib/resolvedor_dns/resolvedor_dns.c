@@ -0,0 +1,227 @@
+/**
+ * @file resolvedor_dns.c
+ * @brief Implementação da camada de resolução de nomes com cache
+ *
+ * Cada nome ocupa uma entrada fixa do cache, que também guarda os pedidos
+ * à espera da consulta em andamento. Uma entrada nunca é liberada, então o
+ * ponteiro para ela pode ser usado com segurança como argumento do
+ * callback do lwIP.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "lwip/dns.h"
+#include "lwip/timeouts.h"
+#include "resolvedor_dns.h"
+
+/**
+ * @brief Estados de uma entrada do cache
+ */
+typedef enum {
+    ENTRADA_VAZIA,    /**< Entrada livre */
+    ENTRADA_LITERAL,  /**< IP literal, convertido uma vez e sem validade */
+    ENTRADA_PENDENTE, /**< Nome sem endereço válido (nunca resolvido ou expirado) */
+    ENTRADA_VALIDA    /**< Nome resolvido dentro da validade */
+} EstadoEntradaDns;
+
+/**
+ * @brief Pedido aguardando a consulta de um nome
+ */
+typedef struct {
+    CallbackResolucaoDns callback; /**< Callback de conclusão */
+    void *arg;                     /**< Argumento do callback */
+} PedidoDns;
+
+/**
+ * @brief Entrada do cache de nomes
+ */
+typedef struct {
+    EstadoEntradaDns estado;                 /**< Estado da entrada */
+    char nome[RESOLVEDOR_DNS_TAMANHO_NOME];  /**< Nome ou IP literal */
+    ip_addr_t endereco;                      /**< Último endereço obtido */
+    uint32_t resolvido_em_ms;                /**< Instante da última resolução bem-sucedida */
+    bool consultando;                        /**< Há uma consulta do lwIP em andamento */
+    uint8_t num_espera;                      /**< Pedidos em espera */
+    PedidoDns espera[RESOLVEDOR_DNS_MAX_ESPERA]; /**< Pedidos aguardando a consulta */
+} EntradaDns;
+
+/** @brief Cache de nomes */
+static EntradaDns cache_dns[RESOLVEDOR_DNS_NUM_ENTRADAS];
+
+/** @brief Indica se o timer de renovação está armado */
+static bool verificacao_agendada = false;
+
+static void verificar_renovacoes(void *arg);
+
+/**
+ * @brief Tempo, em ms, desde a última resolução da entrada.
+ */
+static uint32_t idade_ms(const EntradaDns *entrada) {
+    return to_ms_since_boot(get_absolute_time()) - entrada->resolvido_em_ms;
+}
+
+/**
+ * @brief Arma o timer de renovação, se ainda não estiver armado.
+ */
+static void agendar_verificacao(void) {
+    if (!verificacao_agendada) {
+        verificacao_agendada = true;
+        sys_timeout(RESOLVEDOR_DNS_INTERVALO_VERIFICACAO_MS, verificar_renovacoes, NULL);
+    }
+}
+
+/**
+ * @brief Procura a entrada de um nome, criando-a se necessário.
+ * @return Entrada do nome, ou NULL se o nome é longo demais ou o cache está cheio
+ */
+static EntradaDns *obter_entrada(const char *nome) {
+    if (strlen(nome) >= RESOLVEDOR_DNS_TAMANHO_NOME) {
+        return NULL;
+    }
+    EntradaDns *livre = NULL;
+    for (int i = 0; i < RESOLVEDOR_DNS_NUM_ENTRADAS; i++) {
+        EntradaDns *entrada = &cache_dns[i];
+        if (entrada->estado == ENTRADA_VAZIA) {
+            if (!livre) {
+                livre = entrada;
+            }
+        } else if (strcmp(entrada->nome, nome) == 0) {
+            return entrada;
+        }
+    }
+    if (!livre) {
+        return NULL;
+    }
+
+    strcpy(livre->nome, nome);
+    livre->num_espera = 0;
+    livre->consultando = false;
+    livre->estado = ipaddr_aton(nome, &livre->endereco) ? ENTRADA_LITERAL : ENTRADA_PENDENTE;
+    return livre;
+}
+
+/**
+ * @brief Guarda um endereço recém-resolvido na entrada.
+ */
+static void registrar_endereco(EntradaDns *entrada, const ip_addr_t *endereco) {
+    entrada->endereco = *endereco;
+    entrada->resolvido_em_ms = to_ms_since_boot(get_absolute_time());
+    entrada->estado = ENTRADA_VALIDA;
+    agendar_verificacao();
+}
+
+/**
+ * @brief Callback do DNS do lwIP: conclui a consulta e atende os pedidos em espera.
+ */
+static void callback_dns(const char *nome, const ip_addr_t *endereco, void *arg) {
+    EntradaDns *entrada = (EntradaDns *)arg;
+    entrada->consultando = false;
+
+    if (endereco) {
+        registrar_endereco(entrada, endereco);
+    } else {
+        printf("Resolução DNS falhou para %s\n", nome);
+        if (entrada->estado == ENTRADA_VALIDA && idade_ms(entrada) >= RESOLVEDOR_DNS_TTL_MS) {
+            entrada->estado = ENTRADA_PENDENTE;
+        }
+    }
+
+    // Copia a lista antes: um callback pode fazer um novo pedido para o mesmo nome
+    PedidoDns espera[RESOLVEDOR_DNS_MAX_ESPERA];
+    uint8_t num_espera = entrada->num_espera;
+    memcpy(espera, entrada->espera, num_espera * sizeof(PedidoDns));
+    entrada->num_espera = 0;
+    for (uint8_t i = 0; i < num_espera; i++) {
+        espera[i].callback(entrada->nome, endereco, espera[i].arg);
+    }
+}
+
+/**
+ * @brief Dispara uma consulta do lwIP para a entrada.
+ * @param entrada Entrada a consultar
+ * @param endereco Recebe o endereço quando o retorno é ERR_OK
+ * @return Resultado de dns_gethostbyname()
+ */
+static err_t consultar(EntradaDns *entrada, ip_addr_t *endereco) {
+    err_t resultado = dns_gethostbyname(entrada->nome, endereco, callback_dns, entrada);
+    if (resultado == ERR_OK) {
+        // Ainda válido no cache interno do lwIP
+        registrar_endereco(entrada, endereco);
+    }
+    entrada->consultando = (resultado == ERR_INPROGRESS);
+    return resultado;
+}
+
+/**
+ * @brief Renova em segundo plano os nomes próximos de expirar.
+ *
+ * Executa como timer do lwIP enquanto houver nomes resolvidos no cache.
+ *
+ * @param arg Argumento do timer (não utilizado)
+ */
+static void verificar_renovacoes(void *arg) {
+    const uint32_t limite_renovacao_ms = RESOLVEDOR_DNS_TTL_MS / 100 * RESOLVEDOR_DNS_RENOVACAO_PERCENTUAL;
+    bool ha_nomes = false;
+
+    verificacao_agendada = false;
+    for (int i = 0; i < RESOLVEDOR_DNS_NUM_ENTRADAS; i++) {
+        EntradaDns *entrada = &cache_dns[i];
+        if (entrada->estado != ENTRADA_VALIDA) {
+            continue;
+        }
+        ha_nomes = true;
+        if (!entrada->consultando && idade_ms(entrada) >= limite_renovacao_ms) {
+            ip_addr_t endereco;
+            consultar(entrada, &endereco);
+        }
+    }
+    if (ha_nomes) {
+        agendar_verificacao();
+    }
+}
+
+/**
+ * @brief Registra um nome no cache sem esperar pela resolução.
+ */
+bool resolvedor_dns_preparar(const char *nome) {
+    return obter_entrada(nome) != NULL;
+}
+
+/**
+ * @brief Obtém o endereço de um nome.
+ */
+err_t resolvedor_dns_obter(const char *nome, ip_addr_t *endereco, CallbackResolucaoDns callback, void *arg) {
+    EntradaDns *entrada = obter_entrada(nome);
+    if (!entrada) {
+        // Fora do cache: consulta direta, sem agrupamento
+        return dns_gethostbyname(nome, endereco, callback, arg);
+    }
+
+    if (entrada->estado == ENTRADA_LITERAL) {
+        *endereco = entrada->endereco;
+        return ERR_OK;
+    }
+
+    if (entrada->estado == ENTRADA_VALIDA) {
+        if (idade_ms(entrada) < RESOLVEDOR_DNS_TTL_MS) {
+            *endereco = entrada->endereco;
+            return ERR_OK;
+        }
+        entrada->estado = ENTRADA_PENDENTE;
+    }
+
+    if (!entrada->consultando) {
+        err_t resultado = consultar(entrada, endereco);
+        if (resultado != ERR_INPROGRESS) {
+            return resultado;
+        }
+    }
+    if (entrada->num_espera >= RESOLVEDOR_DNS_MAX_ESPERA) {
+        return ERR_MEM;
+    }
+    entrada->espera[entrada->num_espera].callback = callback;
+    entrada->espera[entrada->num_espera].arg = arg;
+    entrada->num_espera++;
+    return ERR_INPROGRESS;
+}
@@ -0,0 +1,261 @@
+/**
+ * @file servico_adc.c
+ * @brief Implementação do serviço que compartilha o ADC entre vários sensores
+ *
+ * O ADC converte em round-robin os canais registrados, em ordem crescente,
+ * e a FIFO alimenta dois canais de DMA encadeados um no outro (ping-pong):
+ * enquanto um preenche o seu bloco, a interrupção do outro processa o bloco
+ * cheio e rearma o endereço de destino. Como cada bloco tem um número
+ * inteiro de quadros, a posição i de um bloco sempre guarda o i-ésimo
+ * canal ativo módulo o número de canais.
+ *
+ * Cada canal conta quadros dentro do seu período: soma as primeiras
+ * conversões pedidas, publica assim que completa a soma e descarta o
+ * resto do período.
+ */
+
+#include "servico_adc.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+
+/** @brief Frequência do clock do ADC, em Hz */
+#define FREQUENCIA_CLOCK_ADC_HZ 48000000u
+
+/** @brief Taxa máxima de conversões do ADC, em amostras por segundo */
+#define TAXA_MAXIMA_ADC_SPS 500000u
+
+/** @brief GPIO do canal 0 do ADC; os canais 0 a 3 ocupam GPIOs consecutivos */
+#define GPIO_CANAL_0_ADC 26
+
+/**
+ * @brief Estado de um canal do ADC
+ */
+typedef struct {
+    bool registrado;               /**< Canal registrado por algum sensor */
+    uint8_t canal;                 /**< Número do canal */
+    uint32_t periodo_ms;           /**< Intervalo pedido entre publicações, em ms */
+    uint16_t conversoes;           /**< Conversões somadas por publicação */
+    ServicoAdcCallback_t callback; /**< Chamado a cada publicação */
+    void *arg;                     /**< Argumento do callback */
+    uint32_t periodo_quadros;      /**< Quadros entre duas publicações */
+    uint32_t quadro;               /**< Quadro atual dentro do período */
+    uint32_t soma;                 /**< Soma parcial do período */
+    uint64_t soma_quadrados;       /**< Soma parcial dos quadrados do período */
+    volatile uint32_t versao;      /**< Ímpar enquanto a publicação está sendo escrita */
+    LeituraAdc_t publicada;        /**< Última publicação */
+} CanalAdc;
+
+/** @brief Estado de todos os canais, indexado pelo número do canal */
+static CanalAdc canais[SERVICO_ADC_NUM_CANAIS];
+
+/** @brief Canais ativos na ordem do round-robin */
+static CanalAdc *ordem_canais[SERVICO_ADC_NUM_CANAIS];
+
+/** @brief Número de canais ativos */
+static uint8_t num_ativos = 0;
+
+/** @brief Quadros (uma conversão de cada canal ativo) em cada bloco */
+static uint32_t quadros_por_bloco;
+
+/** @brief Blocos preenchidos alternadamente pelos dois canais de DMA */
+static uint16_t blocos[2][SERVICO_ADC_AMOSTRAS_POR_BLOCO];
+
+/** @brief Canais de DMA de cada bloco */
+static int canais_dma[2];
+
+/** @brief Indica se o serviço já foi iniciado */
+static bool iniciado = false;
+
+/**
+ * @brief Registra um canal no serviço.
+ */
+bool servico_adc_registrar(uint8_t canal, uint32_t periodo_ms, uint16_t conversoes,
+                           ServicoAdcCallback_t callback, void *arg) {
+    if (iniciado || canal >= SERVICO_ADC_NUM_CANAIS || canais[canal].registrado ||
+        periodo_ms == 0 || periodo_ms > SERVICO_ADC_PERIODO_MAXIMO_MS || conversoes == 0) {
+        return false;
+    }
+    CanalAdc *c = &canais[canal];
+    c->registrado = true;
+    c->canal = canal;
+    c->periodo_ms = periodo_ms;
+    c->conversoes = conversoes;
+    c->callback = callback;
+    c->arg = arg;
+    return true;
+}
+
+/**
+ * @brief Publica a soma do período de um canal (chamada na interrupção).
+ */
+static void publicar(CanalAdc *c) {
+    c->versao++;
+    __dmb();
+    c->publicada.soma = c->soma;
+    c->publicada.soma_quadrados = c->soma_quadrados;
+    c->publicada.conversoes = c->conversoes;
+    c->publicada.sequencia++;
+    c->publicada.publicado_em_ms = to_ms_since_boot(get_absolute_time());
+    __dmb();
+    c->versao++;
+
+    c->soma = 0;
+    c->soma_quadrados = 0;
+    if (c->callback) {
+        c->callback(c->canal, c->arg);
+    }
+}
+
+/**
+ * @brief Acumula as conversões de um bloco cheio.
+ */
+static void processar_bloco(const uint16_t *bloco) {
+    for (uint32_t q = 0; q < quadros_por_bloco; q++) {
+        for (uint8_t i = 0; i < num_ativos; i++) {
+            CanalAdc *c = ordem_canais[i];
+            uint32_t valor = *bloco++;
+            if (c->quadro < c->conversoes) {
+                c->soma += valor;
+                c->soma_quadrados += valor * valor;
+                if (c->quadro + 1 == c->conversoes) {
+                    publicar(c);
+                }
+            }
+            if (++c->quadro >= c->periodo_quadros) {
+                c->quadro = 0;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Trata o fim de um bloco do DMA: rearma o canal e processa o bloco.
+ */
+static void tratar_irq_dma(void) {
+    for (int k = 0; k < 2; k++) {
+        if (dma_channel_get_irq0_status(canais_dma[k])) {
+            dma_channel_acknowledge_irq0(canais_dma[k]);
+            // Só volta a ser disparado quando o outro bloco encher
+            dma_channel_set_write_addr(canais_dma[k], blocos[k], false);
+            processar_bloco(blocos[k]);
+        }
+    }
+}
+
+/**
+ * @brief Configura os dois canais de DMA que alternam entre os blocos.
+ */
+static void configurar_dma(uint32_t amostras_por_bloco) {
+    canais_dma[0] = dma_claim_unused_channel(true);
+    canais_dma[1] = dma_claim_unused_channel(true);
+
+    for (int k = 0; k < 2; k++) {
+        dma_channel_config config = dma_channel_get_default_config(canais_dma[k]);
+        channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+        channel_config_set_read_increment(&config, false);
+        channel_config_set_write_increment(&config, true);
+        channel_config_set_dreq(&config, DREQ_ADC);
+        channel_config_set_chain_to(&config, canais_dma[1 - k]);
+        dma_channel_configure(canais_dma[k], &config, blocos[k], &adc_hw->fifo, amostras_por_bloco, false);
+        dma_channel_set_irq0_enabled(canais_dma[k], true);
+    }
+
+    irq_add_shared_handler(DMA_IRQ_0, tratar_irq_dma, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+}
+
+/**
+ * @brief Configura o ADC e o DMA para os canais registrados e começa a converter.
+ */
+bool servico_adc_iniciar(void) {
+    if (iniciado) {
+        return false;
+    }
+
+    uint32_t taxa_quadros = SERVICO_ADC_TAXA_MINIMA_QUADROS_HZ;
+    uint32_t mascara = 0;
+    num_ativos = 0;
+    for (uint8_t canal = 0; canal < SERVICO_ADC_NUM_CANAIS; canal++) {
+        CanalAdc *c = &canais[canal];
+        if (!c->registrado) {
+            continue;
+        }
+        ordem_canais[num_ativos++] = c;
+        mascara |= 1u << canal;
+        // Quadros por segundo para caber as conversões no período, arredondado para cima
+        uint32_t necessaria = (uint32_t)(((uint64_t)c->conversoes * 1000u + c->periodo_ms - 1) / c->periodo_ms);
+        if (necessaria > taxa_quadros) {
+            taxa_quadros = necessaria;
+        }
+    }
+    if (num_ativos == 0) {
+        return false;
+    }
+    if (taxa_quadros > TAXA_MAXIMA_ADC_SPS / num_ativos) {
+        taxa_quadros = TAXA_MAXIMA_ADC_SPS / num_ativos;
+    }
+
+    for (uint8_t i = 0; i < num_ativos; i++) {
+        CanalAdc *c = ordem_canais[i];
+        c->periodo_quadros = (uint32_t)((uint64_t)taxa_quadros * c->periodo_ms / 1000u);
+        // Com a taxa limitada pelo ADC o canal publica mais devagar, mas com todas as conversões
+        if (c->periodo_quadros < c->conversoes) {
+            c->periodo_quadros = c->conversoes;
+        }
+    }
+
+    quadros_por_bloco = taxa_quadros / SERVICO_ADC_BLOCOS_POR_SEGUNDO;
+    if (quadros_por_bloco > SERVICO_ADC_AMOSTRAS_POR_BLOCO / num_ativos) {
+        quadros_por_bloco = SERVICO_ADC_AMOSTRAS_POR_BLOCO / num_ativos;
+    }
+    if (quadros_por_bloco == 0) {
+        quadros_por_bloco = 1;
+    }
+
+    adc_init();
+    for (uint8_t i = 0; i < num_ativos; i++) {
+        if (ordem_canais[i]->canal == SERVICO_ADC_CANAL_TEMPERATURA) {
+            adc_set_temp_sensor_enabled(true);
+        } else {
+            adc_gpio_init(GPIO_CANAL_0_ADC + ordem_canais[i]->canal);
+        }
+    }
+
+    // O round-robin segue em ordem crescente a partir do canal selecionado
+    adc_select_input(ordem_canais[0]->canal);
+    adc_set_round_robin(num_ativos > 1 ? mascara : 0);
+    adc_fifo_setup(true,   // Resultados vão para a FIFO
+                   true,   // Pedido de DMA a cada resultado
+                   1,      // Limiar do pedido de DMA
+                   false,  // Sem bit de erro na amostra
+                   false); // Amostras de 12 bits em 16 bits, sem deslocamento
+    float divisor = (float)FREQUENCIA_CLOCK_ADC_HZ / (taxa_quadros * num_ativos) - 1.0f;
+    adc_set_clkdiv(divisor > 0.0f ? divisor : 0.0f);
+
+    configurar_dma(quadros_por_bloco * num_ativos);
+    iniciado = true;
+    dma_channel_start(canais_dma[0]);
+    adc_run(true);
+    return true;
+}
+
+/**
+ * @brief Copia a publicação mais recente de um canal, sem bloquear.
+ */
+bool servico_adc_ler(uint8_t canal, LeituraAdc_t *leitura) {
+    if (canal >= SERVICO_ADC_NUM_CANAIS || !canais[canal].registrado) {
+        return false;
+    }
+    const CanalAdc *c = &canais[canal];
+    uint32_t versao_antes, versao_depois;
+    do {
+        versao_antes = c->versao;
+        __dmb();
+        *leitura = c->publicada;
+        __dmb();
+        versao_depois = c->versao;
+    } while (versao_antes != versao_depois || (versao_antes & 1u));
+    return leitura->sequencia != 0;
+}
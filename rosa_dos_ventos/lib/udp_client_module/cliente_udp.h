@@ -0,0 +1,133 @@
+/**
+ * @file cliente_udp.h
+ * @brief Interface do transporte UDP de telemetria
+ *
+ * Este módulo é uma alternativa ao cliente HTTP para o envio das amostras
+ * do joystick em alta taxa: cada datagrama carrega várias amostras e um
+ * número de sequência, sem conexão nem confirmação ("dispara e esquece").
+ * Com a sequência o receptor consegue medir a perda de datagramas.
+ */
+#ifndef CLIENTE_UDP_H
+#define CLIENTE_UDP_H
+
+// -- INCLUDES --
+#include <stdio.h>
+#include <string.h>
+#include "pico/cyw43_arch.h"
+#include "lwip/dns.h"
+#include "lwip/ip_addr.h"
+#include "lwip/pbuf.h"
+#include "lwip/udp.h"
+#include "buffer_amostras.h"
+#include "codec_telemetria.h"
+#include "resolvedor_dns.h"
+#include "limitador_envio.h"
+
+/**
+ * @defgroup UDP_CLIENT_MODULE Transporte UDP de Telemetria
+ * @{
+ */
+
+/**
+ * @brief Endereço (nome ou IP literal) do receptor dos datagramas
+ */
+#define UDP_DESTINO_HOST "nuvem-jp.zapto.org"
+
+/**
+ * @brief Porta UDP do receptor
+ */
+#define UDP_DESTINO_PORTA 5005
+
+/**
+ * @brief Número máximo de amostras em um único datagrama
+ */
+#define UDP_AMOSTRAS_POR_DATAGRAMA 16
+
+/**
+ * @brief Tempo máximo, em ms, que uma amostra espera no buffer antes de o datagrama ser enviado
+ */
+#define UDP_PRAZO_DATAGRAMA_MS 100
+
+/**
+ * @brief Taxa sustentada de datagramas, em datagramas por minuto
+ */
+#define UDP_DATAGRAMAS_POR_MINUTO 600
+
+/**
+ * @brief Número de datagramas que podem sair seguidos depois de um período sem envios
+ */
+#define UDP_RAJADA_DATAGRAMAS 5
+
+/**
+ * @brief Tamanho máximo, em bytes, de um datagrama (abaixo do MTU, para não fragmentar)
+ */
+#define UDP_TAMANHO_MAX_DATAGRAMA 1024
+
+/**
+ * @brief Versão do formato do datagrama (primeiro byte)
+ */
+#define UDP_VERSAO_PROTOCOLO 1
+
+/**
+ * @brief Tamanho, em bytes, do cabeçalho do datagrama
+ *
+ * Layout do datagrama:
+ * - byte 0: UDP_VERSAO_PROTOCOLO
+ * - bytes 1-4: número de sequência (uint32 little-endian), incrementado a
+ *   cada datagrama montado
+ * - restante: lote de amostras no formato TELEMETRIA_FORMATO (ver
+ *   codec_telemetria.h)
+ */
+#define UDP_TAMANHO_CABECALHO 5
+
+/**
+ * @brief Contadores do transporte UDP
+ */
+typedef struct {
+    uint32_t datagramas_enviados; /**< Datagramas entregues ao lwIP */
+    uint32_t amostras_enviadas;   /**< Amostras contidas nos datagramas enviados */
+    uint32_t falhas_envio;        /**< Datagramas montados que o lwIP recusou (amostras perdidas) */
+    uint32_t sem_memoria;         /**< Envios adiados por falta de pbuf */
+} EstatisticasUdp_t;
+
+/**
+ * @brief Inicializa o transporte UDP
+ *
+ * Cria o PCB UDP e registra UDP_DESTINO_HOST no resolvedor DNS. Deve ser
+ * chamada depois que o Wi-Fi estiver conectado.
+ *
+ * @return true se o PCB foi criado, false caso contrário
+ */
+bool udp_client_init(void);
+
+/**
+ * @brief Informa se o limite de taxa está segurando o próximo datagrama
+ * @return true se não há ficha para um novo datagrama agora
+ */
+bool udp_client_envio_limitado(void);
+
+/**
+ * @brief Envia um datagrama com as amostras acumuladas no buffer
+ *
+ * O datagrama é montado quando há UDP_AMOSTRAS_POR_DATAGRAMA amostras ou
+ * quando a mais antiga já esperou UDP_PRAZO_DATAGRAMA_MS, respeitando o
+ * limite de UDP_DATAGRAMAS_POR_MINUTO. Deve ser chamada periodicamente.
+ *
+ * @param buffer Buffer de onde as amostras são retiradas
+ * @return Número de amostras retiradas do buffer e enviadas
+ *
+ * @note Não há retransmissão: uma amostra retirada do buffer e perdida na
+ *       rede não é reenviada. Enquanto o destino não foi resolvido, as
+ *       amostras continuam no buffer.
+ */
+uint16_t enviar_lote_udp(BufferAmostras_t *buffer);
+
+/**
+ * @brief Copia os contadores do transporte UDP
+ * @param destino Estrutura que recebe a cópia dos contadores
+ */
+void udp_client_obter_estatisticas(EstatisticasUdp_t *destino);
+
+/** @} */ // Fim do grupo UDP_CLIENT_MODULE
+
+#endif // CLIENTE_UDP_H
@@ -0,0 +1,157 @@
+/**
+ * @file udp_client.c
+ * @brief Implementação do transporte UDP de telemetria
+ *
+ * Um único PCB UDP é criado na inicialização e reutilizado em todos os
+ * envios; o endereço do receptor vem do cache de resolvedor_dns.h, que o
+ * renova em segundo plano. Cada datagrama é codificado direto no payload
+ * de um pbuf, sem buffer intermediário, e liberado logo após udp_sendto():
+ * o dispositivo não guarda nenhum estado por datagrama além do número de
+ * sequência.
+ */
+
+#include "cliente_udp.h"
+
+/** @brief PCB UDP usado em todos os envios */
+static struct udp_pcb *pcb_udp = NULL;
+
+/** @brief Número de sequência do próximo datagrama */
+static uint32_t proxima_sequencia = 0;
+
+/** @brief Contadores do transporte */
+static EstatisticasUdp_t estatisticas;
+
+/** @brief Limite de taxa dos datagramas */
+static LimitadorEnvio_t limitador_datagramas;
+
+/**
+ * @brief Callback chamado quando a resolução DNS do receptor é concluída.
+ *
+ * O endereço fica no cache do resolvedor; o próximo envio o utiliza.
+ */
+static void callback_dns_udp(const char *hostname, const ip_addr_t *ipaddr, void *arg) {
+    if (ipaddr) {
+        printf("Receptor UDP resolvido: %s\n", ipaddr_ntoa(ipaddr));
+    } else {
+        printf("Falha ao resolver o receptor UDP %s\n", hostname);
+    }
+}
+
+/**
+ * @brief Verifica se as amostras do buffer já devem ser enviadas.
+ * @param buffer Buffer de amostras
+ * @return true se o datagrama está cheio ou o prazo da amostra mais antiga venceu
+ */
+static bool datagrama_pronto(const BufferAmostras_t *buffer) {
+    Amostra_t mais_antiga;
+    if (!buffer_amostras_espiar(buffer, &mais_antiga)) {
+        return false;
+    }
+    if (buffer_amostras_tamanho(buffer) >= UDP_AMOSTRAS_POR_DATAGRAMA) {
+        return true;
+    }
+    uint32_t tempo_atual_ms = to_ms_since_boot(get_absolute_time());
+    return tempo_atual_ms - mais_antiga.timestamp_ms >= UDP_PRAZO_DATAGRAMA_MS;
+}
+
+/**
+ * @brief Inicializa o transporte UDP.
+ */
+bool udp_client_init(void) {
+    cyw43_arch_lwip_begin();
+    if (!pcb_udp) {
+        pcb_udp = udp_new();
+        limitador_envio_init(&limitador_datagramas, UDP_DATAGRAMAS_POR_MINUTO, UDP_RAJADA_DATAGRAMAS);
+    }
+    bool criado = (pcb_udp != NULL);
+    if (criado) {
+        resolvedor_dns_preparar(UDP_DESTINO_HOST);
+    } else {
+        printf("Erro ao criar PCB UDP\n");
+    }
+    cyw43_arch_lwip_end();
+    return criado;
+}
+
+/**
+ * @brief Informa se o limite de taxa está segurando o próximo datagrama.
+ */
+bool udp_client_envio_limitado(void) {
+    cyw43_arch_lwip_begin();
+    bool limitado = pcb_udp && !limitador_envio_disponivel(&limitador_datagramas);
+    cyw43_arch_lwip_end();
+    return limitado;
+}
+
+/**
+ * @brief Envia um datagrama com as amostras acumuladas no buffer.
+ *
+ * A sequência é consumida mesmo quando o lwIP recusa o datagrama, de modo
+ * que o receptor enxerga a perda local da mesma forma que a perda na rede.
+ */
+uint16_t enviar_lote_udp(BufferAmostras_t *buffer) {
+    uint16_t enviadas = 0;
+
+    cyw43_arch_lwip_begin();
+    if (!pcb_udp) {
+        cyw43_arch_lwip_end();
+        return 0;
+    }
+    // Consulta ao cache do resolvedor; sem endereço ainda, as amostras esperam no buffer
+    ip_addr_t endereco_destino;
+    if (!datagrama_pronto(buffer) || !limitador_envio_disponivel(&limitador_datagramas) ||
+        resolvedor_dns_obter(UDP_DESTINO_HOST, &endereco_destino, callback_dns_udp, NULL) != ERR_OK) {
+        cyw43_arch_lwip_end();
+        return 0;
+    }
+
+    // PBUF_RAM garante payload contíguo; o tamanho é ajustado depois da codificação
+    struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, UDP_TAMANHO_MAX_DATAGRAMA, PBUF_RAM);
+    if (!p) {
+        estatisticas.sem_memoria++;
+        cyw43_arch_lwip_end();
+        return 0;
+    }
+
+    uint8_t *datagrama = (uint8_t *)p->payload;
+    uint32_t sequencia = proxima_sequencia++;
+    datagrama[0] = UDP_VERSAO_PROTOCOLO;
+    datagrama[1] = (uint8_t)(sequencia & 0xFF);
+    datagrama[2] = (uint8_t)((sequencia >> 8) & 0xFF);
+    datagrama[3] = (uint8_t)((sequencia >> 16) & 0xFF);
+    datagrama[4] = (uint8_t)(sequencia >> 24);
+
+    CodificadorLote_t lote;
+    codec_telemetria_iniciar_lote(&lote, datagrama + UDP_TAMANHO_CABECALHO,
+                                  UDP_TAMANHO_MAX_DATAGRAMA - UDP_TAMANHO_CABECALHO);
+    Amostra_t amostra;
+    while (enviadas < UDP_AMOSTRAS_POR_DATAGRAMA && buffer_amostras_espiar(buffer, &amostra)) {
+        if (!codec_telemetria_adicionar(&lote, &amostra)) {
+            break; // Não cabe: a amostra fica para o próximo datagrama
+        }
+        buffer_amostras_remover(buffer, NULL);
+        enviadas++;
+    }
+    uint16_t tamanho = (uint16_t)(UDP_TAMANHO_CABECALHO + codec_telemetria_finalizar_lote(&lote));
+    pbuf_realloc(p, tamanho);
+    limitador_envio_consumir(&limitador_datagramas);
+
+    if (udp_sendto(pcb_udp, p, &endereco_destino, UDP_DESTINO_PORTA) == ERR_OK) {
+        estatisticas.datagramas_enviados++;
+        estatisticas.amostras_enviadas += enviadas;
+    } else {
+        estatisticas.falhas_envio++;
+    }
+    pbuf_free(p);
+    cyw43_arch_lwip_end();
+    return enviadas;
+}
+
+/**
+ * @brief Copia os contadores do transporte UDP.
+ */
+void udp_client_obter_estatisticas(EstatisticasUdp_t *destino) {
+    cyw43_arch_lwip_begin();
+    *destino = estatisticas;
+    cyw43_arch_lwip_end();
+}
@@ -4,6 +4,8 @@
  *
  * Este arquivo contém a implementação principal do sistema Rosa dos Ventos,
  * que monitora um joystick, determina sua direção e envia os dados para a nuvem.
+ * A aquisição e a rede rodam em tasks do FreeRTOS fixadas em núcleos
+ * diferentes, para que uma rede lenta não atrase a amostragem.
  *
  * @author João Paulo Lopes
  * @date Maio 2025
@@ -15,43 +17,124 @@
 #include "pico/cyw43_arch.h"
 #include "lwip/netif.h"
 #include "lwip/ip_addr.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
 #include "joystick.h"
+#include "direcao_joystick.h"
+#include "servico_adc.h"
+#include "detector_mudanca.h"
 #include "cliente_http.h"
+#include "cliente_udp.h"
 #include "wifi.h"
+#include "buffer_amostras.h"
+#include "log_flash.h"
+#include "anel_spsc.h"
+
+/**
+ * @brief Prioridades, tamanhos de stack e núcleos das tasks do FreeRTOS
+ *
+ * A task de amostragem fica sozinha no núcleo 1 e acorda sempre no mesmo
+ * ponto do tick. A de rede fica no núcleo 0, o mesmo que inicializa o
+ * CYW43 e por isso recebe as interrupções do Wi-Fi e do lwIP.
+ * @{
+ */
+#define AMOSTRAGEM_TASK_PRIORITY   (tskIDLE_PRIORITY + 3) /**< Prioridade da task de amostragem */
+#define REDE_TASK_PRIORITY         (tskIDLE_PRIORITY + 2) /**< Prioridade da task de rede */
+#define AMOSTRAGEM_TASK_STACK_SIZE (configMINIMAL_STACK_SIZE + 256) /**< Tamanho da stack da task de amostragem */
+#define REDE_TASK_STACK_SIZE       configMINIMAL_STACK_SIZE * 2     /**< Tamanho da stack da task de rede */
+#define NUCLEO_AMOSTRAGEM          1 /**< Núcleo da task de amostragem */
+#define NUCLEO_REDE                0 /**< Núcleo da task de rede */
+/** @} */
+
+/**
+ * @def INTERVALO_AMOSTRAGEM_MS
+ * @brief Período, em ms, da leitura do joystick pela task de amostragem
+ */
+#ifndef INTERVALO_AMOSTRAGEM_MS
+#define INTERVALO_AMOSTRAGEM_MS 50
+#endif
+
+/**
+ * @def INTERVALO_REDE_MS
+ * @brief Maior intervalo, em ms, que a task de rede dorme sem aviso de mudança antes de conferir os prazos de envio
+ */
+#define INTERVALO_REDE_MS 50
+
+/**
+ * @def CAPACIDADE_ANEL_MUDANCAS
+ * @brief Mudanças que o anel entre as tasks comporta (potência de 2)
+ *
+ * Cobre alguns segundos de joystick em movimento, o tempo de uma
+ * reconexão ao Wi-Fi, durante a qual a task de rede não lê o anel.
+ */
+#define CAPACIDADE_ANEL_MUDANCAS 64
+
+/**
+ * @def INTERVALO_RELATORIOS_MS
+ * @brief Intervalo, em ms, entre os relatórios de latência do cliente HTTP e de jitter da amostragem
+ */
+#define INTERVALO_RELATORIOS_MS 60000
+
+/**
+ * @def INTERVALO_RECONEXAO_WIFI_MS
+ * @brief Intervalo, em ms, entre as tentativas de reconexão ao Wi-Fi
+ */
+#define INTERVALO_RECONEXAO_WIFI_MS 10000
+
+/**
+ * @def TRANSPORTE_HTTP
+ * @brief Envio das amostras em lotes por HTTP (POST com confirmação)
+ */
+#define TRANSPORTE_HTTP 0
 
 /**
- * @def DEAD_ZONE_MIN
- * @brief Limite inferior da zona morta do joystick (0-100)
+ * @def TRANSPORTE_UDP
+ * @brief Envio das amostras em datagramas UDP numerados, sem confirmação
  */
-#define DEAD_ZONE_MIN 35
+#define TRANSPORTE_UDP 1
 
 /**
- * @def DEAD_ZONE_MAX
- * @brief Limite superior da zona morta do joystick (0-100)
+ * @def TRANSPORTE_TELEMETRIA
+ * @brief Transporte usado para enviar as amostras do joystick
  */
-#define DEAD_ZONE_MAX 65
+#ifndef TRANSPORTE_TELEMETRIA
+#define TRANSPORTE_TELEMETRIA TRANSPORTE_HTTP
+#endif
 
 /**
- * @def INTERVALO_ENVIO_DADOS_MS
- * @brief Intervalo mínimo entre envios sucessivos de dados para a nuvem (ms)
+ * @brief Detector de mudança de cada eixo (0-100)
+ *
+ * Oscilações de até 2 unidades são ruído do ADC com o joystick parado; um
+ * deslocamento maior precisa durar 100 ms (duas leituras) para virar amostra.
  */
-#define INTERVALO_ENVIO_DADOS_MS 1000
+static const ConfigDetector_t CONFIG_DETECTOR_EIXO = {
+    .banda = 2,
+    .debounce_ms = 100,
+    .permanencia_minima_ms = 0
+};
 
 /**
- * @brief Direções possíveis do joystick.
+ * @brief Detector de mudança da direção: qualquer troca conta, desde que dure 100 ms
+ *
+ * Evita que o joystick parado na fronteira entre dois setores alterne de
+ * direção a cada leitura.
  */
-typedef enum {
-    CENTRO,     /**< Posição central/neutra do joystick */
-    LESTE,      /**< Joystick movido para a direita */
-    OESTE,      /**< Joystick movido para a esquerda */
-    NORTE,      /**< Joystick movido para cima */
-    SUL,        /**< Joystick movido para baixo */
-    NORDESTE,   /**< Joystick movido na diagonal superior direita */
-    NOROESTE,   /**< Joystick movido na diagonal superior esquerda */
-    SUDESTE,    /**< Joystick movido na diagonal inferior direita */
-    SUDOESTE,   /**< Joystick movido na diagonal inferior esquerda */
-    DIRECAO_DESCONHECIDA /**< Estado não reconhecido do joystick */
-} JoystickDirection;
+static const ConfigDetector_t CONFIG_DETECTOR_DIRECAO = {
+    .banda = 0,
+    .debounce_ms = 100,
+    .permanencia_minima_ms = 0
+};
+
+/**
+ * @brief Detector de mudança do botão: toda mudança conta, sem atraso
+ */
+static const ConfigDetector_t CONFIG_DETECTOR_BOTAO = {
+    .banda = 0,
+    .debounce_ms = 0,
+    .permanencia_minima_ms = 0
+};
 
 /**
  * @brief Estado do joystick em um determinado momento.
@@ -60,20 +143,74 @@ typedef struct {
     JoystickDirection direcao;   /**< Direção calculada do joystick */
     int x_position;              /**< Posição no eixo X (0-100) */
     int y_position;              /**< Posição no eixo Y (0-100) */
+    uint8_t magnitude;           /**< Deflexão a partir do centro calibrado, em % */
     uint8_t button_pressed;      /**< Estado do botão (0=solto, 1=pressionado) */
+    uint32_t lido_em_ms;         /**< Instante da leitura, em ms desde o boot */
 } EstadoJoystick;
 
-/** @brief Estado atual do joystick lido pelos sensores */
+/**
+ * @brief Mudança aceita pelos detectores, passada da task de amostragem à de rede
+ */
+typedef struct {
+    Amostra_t amostra;           /**< Amostra a enviar, já numerada e com timestamp */
+    JoystickDirection direcao;   /**< Direção, só para o log */
+    uint8_t magnitude;           /**< Deflexão em %, só para o log */
+} MudancaJoystick_t;
+
+/** @brief Estado atual do joystick lido pelos sensores (só da task de amostragem) */
 static EstadoJoystick estado_atual_joystick;
 
-/** @brief Estado anterior do joystick para detecção de mudanças */
-static EstadoJoystick estado_anterior_joystick;
+/** @brief Detectores de mudança dos campos do estado do joystick (só da task de amostragem) */
+static DetectorMudanca_t detector_x, detector_y, detector_direcao, detector_botao;
+
+/** @brief Número de sequência da próxima amostra registrada */
+static uint32_t proxima_sequencia_joystick = 0;
+
+/**
+ * @brief Anel de mudanças da task de amostragem (única produtora) para a de rede (única consumidora)
+ *
+ * Sem trava do kernel entre os núcleos; a task de rede só é notificada
+ * quando o anel deixa de estar vazio.
+ */
+static AnelSpsc_t anel_mudancas;
+
+/** @brief Armazenamento do anel de mudanças */
+static MudancaJoystick_t armazenamento_anel_mudancas[CAPACIDADE_ANEL_MUDANCAS];
 
-/** @brief Status da conexão WiFi */
+/** @brief Handle da task de rede, acordada pelo anel de mudanças */
+static TaskHandle_t rede_handle = NULL;
+
+/**
+ * @brief Estatísticas da amostragem, escritas pela task de amostragem e lidas pela de rede
+ * @{
+ */
+static volatile uint32_t desvio_max_periodo_us = 0; /**< Maior desvio do período entre duas leituras na janela */
+static volatile bool zerar_desvio_max = false;       /**< Pedido da task de rede para começar uma nova janela */
+/** @} */
+
+/** @brief Status da conexão WiFi (só da task de rede) */
 static bool wifi_conectado_status = false;
 
-/** @brief Timestamp do último envio de dados para a nuvem */
-static uint32_t ultimo_envio_dados_ms = 0;
+/** @brief Amostras do joystick aguardando envio em lote para a nuvem (só da task de rede) */
+static BufferAmostras_t buffer_amostras_joystick;
+
+/** @brief Log em flash das amostras registradas enquanto o Wi-Fi está fora (só da task de rede) */
+static LogFlash_t log_amostras_joystick;
+
+/**
+ * @brief Task que lê o joystick em período fixo e passa as mudanças à task de rede
+ *
+ * Não faz E/S nem espera nada além do próprio período: o anel é escrito
+ * sem bloquear.
+ * @param pvParameters Parâmetros passados para a task (não utilizado)
+ */
+static void amostragem_task(void *pvParameters);
+
+/**
+ * @brief Task que mantém o Wi-Fi, guarda as mudanças e as envia para a nuvem
+ * @param pvParameters Parâmetros passados para a task (não utilizado)
+ */
+static void rede_task(void *pvParameters);
 
 /**
  * @brief Inicializa todos os componentes do sistema
@@ -81,18 +218,15 @@ static uint32_t ultimo_envio_dados_ms = 0;
 static void inicializar_sistema(void);
 
 /**
- * @brief Tenta estabelecer uma conexão WiFi inicial
+ * @brief Tenta estabelecer (ou restabelecer) a conexão WiFi
  * @return true se a conexão foi estabelecida com sucesso, false caso contrário
  */
 static bool tentar_conectar_wifi_inicialmente(void);
 
 /**
- * @brief Calcula a direção do joystick com base nas coordenadas X e Y
- * @param x Posição X normalizada (0-100)
- * @param y Posição Y normalizada (0-100)
- * @return A direção calculada do joystick
+ * @brief Carrega a calibração do joystick da flash, ou a captura se o botão estiver pressionado
  */
-static JoystickDirection calcular_direcao_joystick(int x, int y);
+static void configurar_calibracao_joystick(void);
 
 /**
  * @brief Converte uma direção do joystick para sua representação em texto
@@ -102,7 +236,7 @@ static JoystickDirection calcular_direcao_joystick(int x, int y);
 static const char* converter_direcao_para_string(JoystickDirection dir);
 
 /**
- * @brief Verifica se houve mudança no estado do joystick desde a última leitura
+ * @brief Verifica se algum campo do joystick mudou além do ruído desde a última amostra
  * @return true se houve mudança, false caso contrário
  */
 static bool houve_mudanca_estado_joystick(void);
@@ -113,51 +247,100 @@ static bool houve_mudanca_estado_joystick(void);
 static void ler_e_processar_joystick(void);
 
 /**
- * @brief Tenta enviar dados do joystick para a nuvem se houver mudança e o intervalo permitir
+ * @brief Passa o estado atual à task de rede se houve mudança
+ */
+static void registrar_amostra_joystick(void);
+
+/**
+ * @brief Acorda a task de rede quando o anel de mudanças deixa de estar vazio
+ */
+static void avisar_rede_task(void);
+
+/**
+ * @brief Guarda uma mudança recebida do anel no buffer de amostras
+ * @param mudanca Mudança recebida da task de amostragem
+ */
+static void guardar_mudanca_joystick(const MudancaJoystick_t *mudanca);
+
+/**
+ * @brief Informa se o transporte selecionado está segurando envios (limite de taxa ou contrapressão)
+ * @return true se o próximo lote ou datagrama ainda não pode sair
+ */
+static bool envio_limitado(void);
+
+/**
+ * @brief Tenta enviar o lote de amostras acumuladas para a nuvem
  */
 static void tentar_enviar_dados_joystick(void);
 
+/**
+ * @brief Imprime o relatório periódico de latência e de jitter da amostragem
+ */
+static void imprimir_relatorios(void);
+
 /**
  * @brief Função principal do programa.
  */
 int main(void) {
     inicializar_sistema();
-    memset(&estado_anterior_joystick, 0, sizeof(EstadoJoystick));
-    estado_anterior_joystick.direcao = DIRECAO_DESCONHECIDA;
-    estado_anterior_joystick.button_pressed = 2;
+    detector_mudanca_init(&detector_x, &CONFIG_DETECTOR_EIXO);
+    detector_mudanca_init(&detector_y, &CONFIG_DETECTOR_EIXO);
+    detector_mudanca_init(&detector_direcao, &CONFIG_DETECTOR_DIRECAO);
+    detector_mudanca_init(&detector_botao, &CONFIG_DETECTOR_BOTAO);
 
-    printf("Iniciando loop principal...\n");
-    while (true) {
-        cyw43_arch_poll();
-        ler_e_processar_joystick();
-        if (wifi_conectado_status) {
-            tentar_enviar_dados_joystick();
-        } else {
-            static uint32_t ultimo_log_wifi_falhou = 0;
-            if (to_ms_since_boot(get_absolute_time()) - ultimo_log_wifi_falhou > 10000) {
-                printf("WiFi não conectado. Não tentando enviar dados.\n");
-                ultimo_log_wifi_falhou = to_ms_since_boot(get_absolute_time());
-            }
-        }
-        sleep_ms(50);
+    if (!anel_spsc_init(&anel_mudancas, armazenamento_anel_mudancas, sizeof(MudancaJoystick_t),
+                        CAPACIDADE_ANEL_MUDANCAS, avisar_rede_task)) {
+        printf("Falha ao criar o anel de mudanças do joystick!\n");
+        while (1);
     }
+
+    TaskHandle_t amostragem_handle;
+    xTaskCreate(amostragem_task, "AmostragemTask", AMOSTRAGEM_TASK_STACK_SIZE, NULL,
+                AMOSTRAGEM_TASK_PRIORITY, &amostragem_handle);
+    xTaskCreate(rede_task, "RedeTask", REDE_TASK_STACK_SIZE, NULL, REDE_TASK_PRIORITY, &rede_handle);
+#if configUSE_CORE_AFFINITY
+    vTaskCoreAffinitySet(amostragem_handle, 1 << NUCLEO_AMOSTRAGEM);
+    vTaskCoreAffinitySet(rede_handle, 1 << NUCLEO_REDE);
+#endif
+
+    printf("Iniciando o escalonador do FreeRTOS...\n");
+    vTaskStartScheduler();
+
+    // Nunca deve chegar aqui
+    while (1) {};
     return 0;
 }
 
+/**
+ * @brief Inicializa os sensores e a calibração antes do escalonador.
+ *
+ * A calibração pode gravar na flash e usa sleep_ms(); por isso roda aqui,
+ * com um único núcleo ativo. A conexão ao Wi-Fi fica com a task de rede.
+ */
 static void inicializar_sistema(void) {
     stdio_init_all();
     sleep_ms(1000);
-    joystick_init();
+    if (!joystick_init()) {
+        printf("Falha ao registrar o joystick no serviço de ADC!\n");
+    }
+    // Todos os sensores analógicos já registraram seus canais
+    if (!servico_adc_iniciar()) {
+        printf("Falha ao iniciar o serviço de ADC!\n");
+    }
     printf("Joystick inicializado.\n");
-    
-    // Inicializar conexão WiFi
-    wifi_conectado_status = tentar_conectar_wifi_inicialmente();
+    configurar_calibracao_joystick();
+    http_client_init();
 }
 
 static bool tentar_conectar_wifi_inicialmente(void) {
     if (conexao_wifi() == 0) {
         printf("WiFi conectado com sucesso!\n");
         printf("IP do dispositivo: %s\n", ipaddr_ntoa(netif_ip4_addr(netif_default)));
+#if TRANSPORTE_TELEMETRIA == TRANSPORTE_UDP
+        if (!udp_client_init()) {
+            printf("Falha ao inicializar o transporte UDP.\n");
+        }
+#endif
         return true;
     } else {
         printf("Falha ao conectar ao WiFi inicialmente.\n");
@@ -166,19 +349,34 @@ static bool tentar_conectar_wifi_inicialmente(void) {
 }
 
 /**
- * @brief Calcula a direção do joystick com base nos valores de X e Y.
+ * @brief Carrega a calibração do joystick da flash, ou a captura se o botão estiver pressionado.
+ *
+ * Ligar a placa com o botão do joystick pressionado inicia uma nova
+ * calibração, que substitui a da flash. Sem calibração válida, a
+ * decodificação usa a faixa nominal do ADC.
  */
-static JoystickDirection calcular_direcao_joystick(int x, int y) {
-    bool x_dead = (x >= DEAD_ZONE_MIN && x <= DEAD_ZONE_MAX);
-    bool y_dead = (y >= DEAD_ZONE_MIN && y <= DEAD_ZONE_MAX);
-    bool x_pos = (x > DEAD_ZONE_MAX); bool x_neg = (x < DEAD_ZONE_MIN);
-    bool y_pos = (y > DEAD_ZONE_MAX); bool y_neg = (y < DEAD_ZONE_MIN);
+static void configurar_calibracao_joystick(void) {
+    CalibracaoJoystick_t calibracao;
+    Joystick leitura;
+    read_joystick(&leitura);
+
+    if (leitura.button_pressed) {
+        if (calibracao_joystick_capturar(&calibracao)) {
+            printf(calibracao_joystick_salvar(&calibracao) ? "Calibração gravada na flash.\n"
+                                                           : "Falha ao gravar a calibração na flash.\n");
+            direcao_joystick_aplicar_calibracao(&calibracao);
+            return;
+        }
+        printf("Calibração inválida: faixa dos eixos pequena demais.\n");
+    }
 
-    if (x_dead && y_dead) return CENTRO;
-    if (y_pos) { if (x_neg) return NOROESTE; if (x_pos) return NORDESTE; return NORTE; }
-    if (y_neg) { if (x_neg) return SUDOESTE; if (x_pos) return SUDESTE; return SUL; }
-    if (x_pos) return LESTE; if (x_neg) return OESTE;
-    return DIRECAO_DESCONHECIDA;
+    if (calibracao_joystick_carregar(&calibracao)) {
+        printf("Calibração do joystick carregada da flash.\n");
+    } else {
+        printf("Joystick sem calibração; usando a faixa nominal do ADC.\n");
+        calibracao_joystick_padrao(&calibracao);
+    }
+    direcao_joystick_aplicar_calibracao(&calibracao);
 }
 
 static const char* converter_direcao_para_string(JoystickDirection dir) {
@@ -186,18 +384,72 @@ static const char* converter_direcao_para_string(JoystickDirection dir) {
         case CENTRO: return "Centro"; case LESTE: return "Leste"; case OESTE: return "Oeste";
         case NORTE: return "Norte"; case SUL: return "Sul"; case NORDESTE: return "Nordeste";
         case NOROESTE: return "Noroeste"; case SUDESTE: return "Sudeste"; case SUDOESTE: return "Sudoeste";
+        case LES_NORDESTE: return "Lés-nordeste"; case NOR_NORDESTE: return "Nor-nordeste";
+        case NOR_NOROESTE: return "Nor-noroeste"; case OES_NOROESTE: return "Oés-noroeste";
+        case OES_SUDOESTE: return "Oés-sudoeste"; case SUL_SUDOESTE: return "Su-sudoeste";
+        case SUL_SUDESTE: return "Su-sudeste"; case LES_SUDESTE: return "Lés-sudeste";
         default: return "Desconhecido";
     }
 }
 
 /**
- * @brief Verifica se houve mudança no estado do joystick.
+ * @brief Lê o joystick a cada INTERVALO_AMOSTRAGEM_MS e mede o desvio do período.
+ *
+ * vTaskDelayUntil() acorda a task sempre no mesmo tick; como nada mais
+ * roda neste núcleo, o que sobra de variação entre duas leituras é a
+ * latência de interrupção, e não o estado da rede. O maior desvio de cada
+ * janela vai para o relatório da task de rede.
+ */
+static void amostragem_task(void *pvParameters) {
+    printf("Amostragem Task iniciada no Core %d\n", get_core_num());
+    TickType_t ultimo_despertar = xTaskGetTickCount();
+    uint64_t leitura_anterior_us = 0;
+
+    while (true) {
+        vTaskDelayUntil(&ultimo_despertar, pdMS_TO_TICKS(INTERVALO_AMOSTRAGEM_MS));
+
+        uint64_t agora_us = time_us_64();
+        if (zerar_desvio_max) {
+            desvio_max_periodo_us = 0;
+            zerar_desvio_max = false;
+        }
+        if (leitura_anterior_us != 0) {
+            int64_t desvio_us = (int64_t)(agora_us - leitura_anterior_us) - INTERVALO_AMOSTRAGEM_MS * 1000;
+            uint32_t desvio_abs_us = (uint32_t)(desvio_us < 0 ? -desvio_us : desvio_us);
+            if (desvio_abs_us > desvio_max_periodo_us) {
+                desvio_max_periodo_us = desvio_abs_us;
+            }
+        }
+        leitura_anterior_us = agora_us;
+
+        ler_e_processar_joystick();
+        registrar_amostra_joystick();
+    }
+}
+
+/**
+ * @brief Verifica se algum campo do joystick mudou além do ruído.
+ *
+ * Todos os detectores recebem a leitura, mesmo quando um deles já acusou
+ * mudança, para que o debounce de cada campo siga correndo. Havendo
+ * mudança, o estado atual passa a ter os valores aceitos pelos detectores:
+ * um eixo que só oscilou dentro da banda mantém o valor anterior.
  */
 static bool houve_mudanca_estado_joystick(void) {
-    return (estado_atual_joystick.direcao != estado_anterior_joystick.direcao ||
-            estado_atual_joystick.button_pressed != estado_anterior_joystick.button_pressed ||
-            estado_atual_joystick.x_position != estado_anterior_joystick.x_position ||
-            estado_atual_joystick.y_position != estado_anterior_joystick.y_position);
+    uint32_t agora_ms = estado_atual_joystick.lido_em_ms;
+    bool mudou = detector_mudanca_atualizar(&detector_x, estado_atual_joystick.x_position, agora_ms);
+    mudou |= detector_mudanca_atualizar(&detector_y, estado_atual_joystick.y_position, agora_ms);
+    mudou |= detector_mudanca_atualizar(&detector_direcao, estado_atual_joystick.direcao, agora_ms);
+    mudou |= detector_mudanca_atualizar(&detector_botao, estado_atual_joystick.button_pressed, agora_ms);
+    if (!mudou) {
+        return false;
+    }
+
+    estado_atual_joystick.x_position = detector_mudanca_valor(&detector_x);
+    estado_atual_joystick.y_position = detector_mudanca_valor(&detector_y);
+    estado_atual_joystick.direcao = (JoystickDirection)detector_mudanca_valor(&detector_direcao);
+    estado_atual_joystick.button_pressed = (uint8_t)detector_mudanca_valor(&detector_botao);
+    return true;
 }
 
 /**
@@ -206,34 +458,181 @@ static bool houve_mudanca_estado_joystick(void) {
 static void ler_e_processar_joystick(void) {
     Joystick dados_brutos_joystick;
     read_joystick(&dados_brutos_joystick);
+    estado_atual_joystick.lido_em_ms = to_ms_since_boot(get_absolute_time());
     estado_atual_joystick.x_position = dados_brutos_joystick.x_position;
     estado_atual_joystick.y_position = dados_brutos_joystick.y_position;
     estado_atual_joystick.button_pressed = dados_brutos_joystick.button_pressed;
-    estado_atual_joystick.direcao = calcular_direcao_joystick(
-        estado_atual_joystick.x_position, estado_atual_joystick.y_position);
+    estado_atual_joystick.direcao = direcao_joystick_decodificar(
+        dados_brutos_joystick.x_bruto, dados_brutos_joystick.y_bruto, &estado_atual_joystick.magnitude);
 }
 
 /**
- * @brief Tenta enviar os dados do joystick para a nuvem se houver mudança.
+ * @brief Passa o estado atual do joystick à task de rede se houver mudança.
+ *
+ * Toda mudança aceita pelos detectores vira uma amostra com timestamp,
+ * mesmo com o Wi-Fi fora, para que nenhuma posição intermediária se perca
+ * entre dois envios. O anel é escrito sem esperar: com ele cheio a
+ * mudança é descartada e contada, em vez de atrasar a próxima leitura.
  */
-static void tentar_enviar_dados_joystick(void) {
-    uint32_t tempo_atual_ms = to_ms_since_boot(get_absolute_time());
-
-    if (houve_mudanca_estado_joystick()) {
-        printf("Mudança Joystick: X=%d, Y=%d, Btn=%d, Dir=%s\n",
-               estado_atual_joystick.x_position, estado_atual_joystick.y_position,
-               estado_atual_joystick.button_pressed,
-               converter_direcao_para_string(estado_atual_joystick.direcao));
-
-        if (tempo_atual_ms - ultimo_envio_dados_ms >= INTERVALO_ENVIO_DADOS_MS) {
-            printf("Enviando dados para a nuvem...\n");
-            Joystick dados_para_envio;
-            dados_para_envio.x_position = estado_atual_joystick.x_position;
-            dados_para_envio.y_position = estado_atual_joystick.y_position;
-            dados_para_envio.button_pressed = estado_atual_joystick.button_pressed;
-            enviar_dados_para_nuvem(&dados_para_envio);
-            ultimo_envio_dados_ms = tempo_atual_ms;
+static void registrar_amostra_joystick(void) {
+    if (!houve_mudanca_estado_joystick()) {
+        return;
+    }
+
+    MudancaJoystick_t mudanca;
+    mudanca.amostra.sequencia = proxima_sequencia_joystick++;
+    mudanca.amostra.timestamp_ms = estado_atual_joystick.lido_em_ms;
+    mudanca.amostra.estado.x_position = estado_atual_joystick.x_position;
+    mudanca.amostra.estado.y_position = estado_atual_joystick.y_position;
+    mudanca.amostra.estado.button_pressed = estado_atual_joystick.button_pressed;
+    mudanca.direcao = estado_atual_joystick.direcao;
+    mudanca.magnitude = estado_atual_joystick.magnitude;
+    anel_spsc_inserir(&anel_mudancas, &mudanca);
+}
+
+/**
+ * @brief Mantém o Wi-Fi e envia as mudanças recebidas da task de amostragem.
+ *
+ * Dorme até o aviso do anel ou por até INTERVALO_REDE_MS e depois confere
+ * os prazos de envio; a reconexão ao Wi-Fi e o envio podem bloquear esta
+ * task por segundos sem atrasar a amostragem, que segue enchendo o anel.
+ */
+static void rede_task(void *pvParameters) {
+    printf("Rede Task iniciada no Core %d\n", get_core_num());
+    MudancaJoystick_t mudanca;
+    uint32_t ultimo_relatorio_ms = to_ms_since_boot(get_absolute_time());
+    uint32_t ultima_tentativa_ms;
+
+    buffer_amostras_init(&buffer_amostras_joystick);
+    log_flash_init(&log_amostras_joystick, memoria_flash_pico());
+    wifi_conectado_status = tentar_conectar_wifi_inicialmente();
+    ultima_tentativa_ms = to_ms_since_boot(get_absolute_time());
+
+    while (true) {
+        // Na arquitetura threadsafe_background o lwIP roda em interrupção, sem cyw43_arch_poll()
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(INTERVALO_REDE_MS));
+        while (anel_spsc_remover(&anel_mudancas, &mudanca)) {
+            guardar_mudanca_joystick(&mudanca);
+        }
+#if TRANSPORTE_TELEMETRIA == TRANSPORTE_HTTP
+        // Amostras de lotes que falharam voltam ao log e são repostas como as gravadas sem Wi-Fi
+        Amostra_t devolvida;
+        while (http_client_retirar_devolvida(&devolvida)) {
+            log_flash_gravar(&log_amostras_joystick, &devolvida);
+        }
+#endif
+
+        if (wifi_conectado_status && !wifi_esta_conectado()) {
+            printf("Conexão WiFi perdida, gravando amostras na flash.\n");
+            wifi_conectado_status = false;
+        }
+        if (wifi_conectado_status) {
+            // Amostras gravadas durante a queda voltam aos poucos, sem tomar o lugar das novas
+            uint16_t repostas = log_flash_repor(&log_amostras_joystick, &buffer_amostras_joystick,
+                                                to_ms_since_boot(get_absolute_time()));
+            if (repostas > 0) {
+                printf("Repondo %u amostras gravadas na flash...\n", repostas);
+            }
+            tentar_enviar_dados_joystick();
+        } else {
+            // Sem Wi-Fi as amostras vão para a flash em vez de se perderem no buffer
+            Amostra_t amostra;
+            while (buffer_amostras_remover(&buffer_amostras_joystick, &amostra)) {
+                log_flash_gravar(&log_amostras_joystick, &amostra);
+            }
+
+            if (to_ms_since_boot(get_absolute_time()) - ultima_tentativa_ms >= INTERVALO_RECONEXAO_WIFI_MS) {
+                printf("WiFi não conectado. Tentando reconectar...\n");
+                wifi_conectado_status = tentar_conectar_wifi_inicialmente();
+                ultima_tentativa_ms = to_ms_since_boot(get_absolute_time());
+            }
+        }
+
+        if (to_ms_since_boot(get_absolute_time()) - ultimo_relatorio_ms >= INTERVALO_RELATORIOS_MS) {
+            imprimir_relatorios();
+            ultimo_relatorio_ms = to_ms_since_boot(get_absolute_time());
         }
-        estado_anterior_joystick = estado_atual_joystick;
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Acorda a task de rede quando o anel de mudanças deixa de estar vazio.
+ *
+ * Chamada de dentro da task de amostragem, no outro núcleo.
+ */
+static void avisar_rede_task(void) {
+    xTaskNotifyGive(rede_handle);
+}
+
+/**
+ * @brief Guarda uma mudança recebida do anel no buffer de amostras.
+ *
+ * Se o transporte está segurando os envios (limite de taxa ou
+ * contrapressão) e já há um lote inteiro esperando, a nova amostra
+ * substitui a mais recente ao vivo, de modo que o próximo lote liberado
+ * leva a posição final. Amostras repostas do log nunca são substituídas.
+ */
+static void guardar_mudanca_joystick(const MudancaJoystick_t *mudanca) {
+    printf("Mudança Joystick: X=%d, Y=%d, Btn=%d, Dir=%s (%u%%)\n",
+           mudanca->amostra.estado.x_position, mudanca->amostra.estado.y_position,
+           mudanca->amostra.estado.button_pressed,
+           converter_direcao_para_string(mudanca->direcao),
+           mudanca->magnitude);
+
+    if (wifi_conectado_status && envio_limitado()) {
+#if TRANSPORTE_TELEMETRIA == TRANSPORTE_UDP
+        buffer_amostras_coalescer(&buffer_amostras_joystick, &mudanca->amostra, UDP_AMOSTRAS_POR_DATAGRAMA);
+#else
+        buffer_amostras_coalescer(&buffer_amostras_joystick, &mudanca->amostra, HTTP_TAMANHO_LOTE);
+#endif
+    } else {
+        buffer_amostras_inserir(&buffer_amostras_joystick, &mudanca->amostra);
+    }
+}
+
+/**
+ * @brief Informa se o transporte selecionado está segurando envios (limite de taxa ou contrapressão).
+ */
+static bool envio_limitado(void) {
+#if TRANSPORTE_TELEMETRIA == TRANSPORTE_UDP
+    return udp_client_envio_limitado();
+#else
+    return http_client_envio_limitado() || http_client_sob_pressao();
+#endif
+}
+
+/**
+ * @brief Tenta enviar as amostras acumuladas do joystick para a nuvem.
+ *
+ * O transporte selecionado decide se o lote já está completo ou se o prazo
+ * da amostra mais antiga venceu. No UDP os datagramas saem a cada poucas
+ * amostras, por isso não há log por envio.
+ */
+static void tentar_enviar_dados_joystick(void) {
+#if TRANSPORTE_TELEMETRIA == TRANSPORTE_UDP
+    enviar_lote_udp(&buffer_amostras_joystick);
+#else
+    uint16_t enviadas = enviar_lote_para_nuvem(&buffer_amostras_joystick);
+    if (enviadas > 0) {
+        printf("Enviando lote de %u amostras para a nuvem...\n", enviadas);
+    }
+#endif
+}
+
+/**
+ * @brief Imprime o relatório periódico de latência e de jitter da amostragem.
+ *
+ * O desvio máximo é o da janela desde o relatório anterior; a task de
+ * amostragem zera a janela na próxima leitura.
+ */
+static void imprimir_relatorios(void) {
+#if TRANSPORTE_TELEMETRIA == TRANSPORTE_HTTP
+    if (wifi_conectado_status) {
+        http_client_imprimir_latencias();
+    }
+#endif
+    printf("Amostragem (Core %d): desvio máximo do período de %u ms: %lu us, mudanças perdidas: %lu\n",
+           NUCLEO_AMOSTRAGEM, INTERVALO_AMOSTRAGEM_MS,
+           (unsigned long)desvio_max_periodo_us, (unsigned long)anel_mudancas.descartados);
+    zerar_desvio_max = true;
+}